@@ -7,6 +7,7 @@
 
 //DONT TOUCH THIS
 void default_constants();
+void chassis_constants_apply();  // pushes the constants below into the chassis (the parameter table calls it)
 
 //Put your helper functions here
 void autoIntake();
@@ -37,10 +38,22 @@ void PositiveBlueElim();
 void NegativeBlueQual();
 void exampleMovements();
 void RedRushNeg();
+extern const std::vector<ez::Auton> autonList;  // what the auton selector shows, in order (tools/sim runs the same list)
 
 
 //Put your global variables here
 extern int color;
 extern int ringsEjected;
 extern int intakeState;  // 0 = off, 1 = intake, 2 = outtake
-extern bool sortingBool;  // true if sorting is active
\ No newline at end of file
+extern bool sortingBool;  // true if sorting is active
+extern int DRIVE_SPEED;  // out of 127
+extern int TURN_SPEED;
+extern int SWING_SPEED;
+extern int autoStallTime;  // ms of low intake velocity before the auton antijam reverses
+extern int autoEjectRotation;  // degrees the auton color sort spins a wrong ring before stopping
+extern ez::PID::Constants driveConstants;
+extern ez::PID::Constants headingConstants;
+extern ez::PID::Constants turnConstants;
+extern ez::PID::Constants swingConstants;
+extern ez::PID::Constants odomAngularConstants;
+extern ez::PID::Constants boomerangConstants;
\ No newline at end of file
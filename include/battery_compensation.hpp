@@ -0,0 +1,49 @@
+//Quick Note -> This is where the battery voltage compensation lives. You define the stuff here in battery_compensation.cpp
+#pragma once
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+#include "pros/abstract_motor.hpp"
+
+// A motor voltage command is really a % of whatever the battery has. 12000 mV on a fresh 12.8V battery
+// and on a tired 11.5V one are different speeds, so late auton timing and arm states drift.
+// Compensation rescales commands so they act like the battery is always BATTERY_NOMINAL_VOLTAGE:
+//   command * nominal / battery
+// A fresh battery gets turned down a little. A tired one gets turned up, as far as it can go (headroom):
+// anything past 12000 mV just saturates, so full power commands can't be made up for below nominal.
+// Covers intake/lb (battery_move_voltage), the feedforward drive output, and EZ-Template motions by
+// rescaling the motion's max speed (that's where a motion spends most of its time). The task owns that max
+// speed, the S-curve slew (scurve_slew.hpp) ramps up to whatever it's set to.
+//
+// How close it gets: make -C tools/sim battery (the other nominal rows are this constant changed and run
+// again), every auton summed, fresh = 12.8V resting, tired = 11.5V:
+//   nominal      fresh ms   tired ms   tired - fresh, mean / worst auton
+//   off            85620      88920      412 / 530 ms
+//   12.8           85330      87410      260 / 360 ms
+//   12.0           86280      88050      221 / 310 ms
+//   11.5           87240      88460      152 / 250 ms
+//   11.0           88420      88910       61 / 160 ms
+// 12V halves the gap but doesn't close it. Most auton motions run at 127, and a tired battery under load
+// can't give 12V, so those stay short no matter what (headroom). Rescaling the whole drive output in the sim,
+// not just the max speed, only got 12V down to 159 ms mean. Nearly identical takes a nominal around 11V,
+// and that's a fresh battery giving up 2.1 s over the 8 autons (about 270 ms each) to wait for a tired one.
+
+const double BATTERY_NOMINAL_VOLTAGE = 12.0;  // volts everything acts like it's running at
+const int BATTERY_SAMPLE_TIME = 100;          // ms between battery reads
+const double BATTERY_FILTER_TIME = 2.0;       // seconds, battery voltage jumps around a ton under load
+
+// Rescales one command. Pure math, battery in volts, command and result in mV
+inline double battery_compensate_with(double mV, double battery) {
+  mV = ez::util::clamp(mV, 12000.0);  // some code sends way past 12000 to mean "full", that's 12000 at nominal
+  if (battery < 1.0) return mV;        // no reading (or on the bench with no battery)
+  return ez::util::clamp(mV * BATTERY_NOMINAL_VOLTAGE / battery, 12000.0);
+}
+
+//Function initializations go here
+double battery_voltage_get();                                  // filtered battery volts
+double battery_headroom_get();                                 // battery / nominal, under 1 means full power commands can't be compensated
+double battery_compensate(double mV);                          // a command in "nominal volts" mV -> what to actually send
+void battery_move_voltage(pros::AbstractMotor &motor, double mV);  // motor.move_voltage but compensated. Works on motors and motor groups
+void battery_compensation_enable(bool enable);
+bool battery_compensation_enabled();
+void battery_compensation_task();  // run this as a task, reads the battery and keeps EZ-Template's motion speed compensated
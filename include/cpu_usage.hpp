@@ -0,0 +1,72 @@
+//Quick Note -> This is where the CPU usage accounting lives. You define the stuff here in cpu_usage.cpp
+#pragma once
+
+#include <cstdint>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+#include "memory_monitor.hpp"
+
+// How much of the brain's CPU each piece of code uses, split by competition mode (disabled/auton/driver,
+// same modes as memory_monitor.hpp). Two sources, both sampled once a second by cpu_usage_task:
+//   - kernel: the RTOS run-time stats, every task on the brain including EZ-Template's, LVGL's and the
+//     idle task. Idle is the headroom left for new stuff. Only there if the kernel exports the stats
+//   - loops: execution time out of the loop profiler (loop_profiler.hpp), so only instrumented loops but
+//     it always works and it's measured with pros::micros()
+// Percent is of the whole CPU over the time spent in that mode.
+//
+// See it with cpu_usage_print() (terminal), cpu_usage_save() (SD card) or the fifth blank brain page.
+
+const int CPU_SAMPLE_TIME = 1000;  // ms
+const int CPU_ENTRIES_MAX = 40;    // kernel tasks + loops
+const int CPU_NAME_LENGTH = 24;
+
+struct cpu_usage_entry {
+  char name[CPU_NAME_LENGTH] = "";
+  bool kernel = false;                       // run-time stats (true) or a profiled loop (false)
+  std::uint64_t busy[MEMORY_MODES] = {};     // run-time counter ticks (kernel) or us (loops)
+  std::uint32_t last = 0;                    // last cumulative reading
+  void *handle = nullptr;                    // kernel: the task the reading came from, a new one means the name got reused
+};
+
+struct cpu_usage_state {
+  cpu_usage_entry entries[CPU_ENTRIES_MAX];
+  int count = 0;
+  bool kernel_stats = false;                 // false if this kernel doesn't export run-time stats
+  std::uint64_t kernel_total[MEMORY_MODES] = {};  // run-time counter ticks in each mode, all tasks together
+  std::uint64_t wall[MEMORY_MODES] = {};     // us spent in each mode
+
+  // 0 -> 100, -1 if nothing was measured in that mode
+  double percent(int entry, memory_mode mode) const {
+    const cpu_usage_entry &e = entries[entry];
+    std::uint64_t total = e.kernel ? kernel_total[mode] : wall[mode];
+    return total > 0 ? 100.0 * e.busy[mode] / total : -1.0;
+  }
+};
+
+// Pulls name + cumulative counter out of one line of FreeRTOS's run-time stats text
+// ("name<spaces>\t<counter>\t\t<percent>%"). false if the line isn't one
+inline bool cpu_usage_parse_line(const char *line, char name[CPU_NAME_LENGTH], std::uint32_t &counter) {
+  int n = 0;
+  while (line[n] != '\0' && line[n] != '\t' && line[n] != '\n') n++;
+  if (line[n] != '\t') return false;
+  int end = n;
+  while (end > 0 && line[end - 1] == ' ') end--;
+  if (end == 0) return false;
+  int copy = end < CPU_NAME_LENGTH - 1 ? end : CPU_NAME_LENGTH - 1;
+  for (int i = 0; i < copy; i++) name[i] = line[i];
+  name[copy] = '\0';
+  const char *p = line + n;
+  while (*p == '\t' || *p == ' ') p++;
+  if (*p < '0' || *p > '9') return false;
+  counter = 0;
+  while (*p >= '0' && *p <= '9') counter = counter * 10 + (*p++ - '0');
+  return true;
+}
+
+//Function initializations go here
+cpu_usage_state cpu_usage_get();
+void cpu_usage_reset();
+void cpu_usage_print();
+bool cpu_usage_save();  // /usd/cpu_usage.csv, false if there's no SD card
+void cpu_usage_task();  // run this as a task
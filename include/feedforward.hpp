@@ -0,0 +1,30 @@
+//Quick Note -> This is where the drivetrain feedforward stuff lives. You define the stuff here in feedforward.cpp
+#pragma once
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// Feedforward constants for one motion type. Units are whatever that motion measures in:
+// DRIVE is inches, TURN and SWING are degrees. Get kS/kV/kA from sysid instead of guessing
+struct feedforward_constants {
+  double kS = 0.0;            // mV to get the drive moving at all (static friction)
+  double kV = 0.0;            // mV per unit/s
+  double kA = 0.0;            // mV per unit/s^2
+  double kP = 0.0;            // mV per unit the robot is behind the profile
+  double kD = 0.0;            // mV per unit/s the robot is slower than the profile
+  double max_velocity = 0.0;  // units/s the profile can go at speed 127
+  double max_accel = 0.0;     // units/s^2 the profile speeds up/slows down with (this replaces slew)
+};
+
+//Function initializations go here
+void feedforward_drive_constants_set(double kS, double kV, double kA, double kP, double kD, double max_velocity, double max_accel);
+void feedforward_turn_constants_set(double kS, double kV, double kA, double kP, double kD, double max_velocity, double max_accel);
+void feedforward_swing_constants_set(double kS, double kV, double kA, double kP, double kD, double max_velocity, double max_accel);
+feedforward_constants feedforward_constants_get(ez::e_mode mode);
+void feedforward_enable(ez::e_mode mode, bool enable);  // only DRIVE, TURN and SWING can use feedforward, odom motions stay pure EZ-Template
+bool feedforward_enabled(ez::e_mode mode);
+void feedforward_characterized_set(ez::e_mode mode, bool characterized);  // true once that mode's kS/kV/kA came from sysid, not guesses
+bool feedforward_characterized(ez::e_mode mode);                          // the gain schedule only measures inertia off characterized constants
+double feedforward_voltage(const feedforward_constants &constants, double velocity, double accel);  // kS/kV/kA -> mV
+double feedforward_tracking_error_get();  // how far behind the profile the current motion is (units of that motion)
+void feedforward_task();                  // run this as a task, it takes over the drive motors for enabled motions
@@ -0,0 +1,48 @@
+//Quick Note -> This is where the field geometry + distance sensor prediction stuff lives. You define the stuff here in field_model.cpp
+#pragma once
+
+#include "EZ-Template/util.hpp"
+
+// Field coordinates match our autons: (0, 0) is the middle of the field, inches, theta 0 points at +y and
+// goes clockwise. Everything is kept in flat arrays (no classes per element, no virtual calls) so a raycast
+// is just a couple of tight loops -> cheap enough to run hundreds of times a tick for particle weighting.
+
+const int FIELD_MAX_SEGMENTS = 16;  // walls and anything else flat
+const int FIELD_MAX_CIRCLES = 16;   // posts, stakes and mobile goals
+const int FIELD_MAX_MOUNTS = 8;     // distance sensors per field_expected_ranges call
+const double FIELD_HALF_WIDTH = 70.2;             // inches from the middle of the field to the inside of a wall
+const double DISTANCE_SENSOR_MAX_RANGE = 78.74;   // 2000 mm, the V5 distance sensor gives up past this
+
+struct field_model {
+  // segments are stored as a start point and a direction (end - start)
+  int segmentCount = 0;
+  double segmentX[FIELD_MAX_SEGMENTS];
+  double segmentY[FIELD_MAX_SEGMENTS];
+  double segmentDX[FIELD_MAX_SEGMENTS];
+  double segmentDY[FIELD_MAX_SEGMENTS];
+
+  int circleCount = 0;
+  double circleX[FIELD_MAX_CIRCLES];
+  double circleY[FIELD_MAX_CIRCLES];
+  double circleR[FIELD_MAX_CIRCLES];
+
+  int goalStart = 0;  // circles from here to circleCount are mobile goals (they move, so they can be updated)
+};
+
+// Where a distance sensor sits on the robot. x is right, y is forward (inches from the tracking center)
+// theta is where it points, relative to the front of the robot, clockwise positive (degrees)
+struct distance_sensor_mount {
+  double x = 0.0;
+  double y = 0.0;
+  double theta = 0.0;
+  double max_range = DISTANCE_SENSOR_MAX_RANGE;
+};
+
+//Function initializations go here
+field_model field_model_high_stakes();                                                // walls, ladder, stakes and mobile goal starting spots
+bool field_model_segment_add(field_model &model, ez::pose start, ez::pose end);       // adds a flat surface
+bool field_model_circle_add(field_model &model, ez::pose center, double radius);      // adds a round obstacle
+void field_model_goal_set(field_model &model, int goal, ez::pose position);           // moves a mobile goal (ex: after we grab it)
+double field_raycast(const field_model &model, double x, double y, double theta, double max_range);  // distance to the first thing hit
+bool field_expected_ranges(const field_model &model, ez::pose robot, const distance_sensor_mount *mounts, int mountCount, double *out);  // false (out untouched) for more than FIELD_MAX_MOUNTS sensors
+bool field_expected_ranges(const field_model &model, const ez::pose *robots, int robotCount, const distance_sensor_mount *mounts, int mountCount, double *out);  // out is [robot][sensor], same limit
@@ -0,0 +1,95 @@
+//Quick Note -> This is where the PID gain schedules live. You define the stuff here in gain_schedule.cpp
+#pragma once
+
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// One set of constants in default_constants() is a compromise: turns with a goal clamped overshoot, and
+// everything gets lazier as the battery drops. A schedule is a few constant sets, each tagged with the
+// load and battery voltage it was tuned at, and the right blend gets applied automatically:
+//   load    0 = nothing clamped, 1 = mogo clamped (refined by the measured turning inertia, see below)
+//   battery volts (filtered, battery_voltage_get()). While battery compensation is on the motors already act
+//           like BATTERY_NOMINAL_VOLTAGE, so that's what gets looked up, or the battery gets made up for twice
+// Points with the same load make one row, the gains get interpolated along battery inside a row and then
+// between the two rows closest to the current load. A mode with no points keeps its default_constants().
+// Only add points that were actually tuned at that load and battery (pid_autotune.hpp): every point changes
+// what the competition autons do. One point is the same as no schedule.
+//
+// Inertia: while a turn runs, the turn feedforward constants (feedforward.hpp, from sysid) predict how
+// much voltage the measured turn acceleration should take. The ratio actual/predicted is how much heavier
+// the robot is than when it was characterized. That ratio scaled by GAIN_SCHEDULE_MOGO_INERTIA_RATIO
+// becomes the load, so a light goal and a full goal don't have to be the same "clamped". This only runs once
+// the turn constants are marked feedforward_characterized_set(ez::TURN, true), until then the load is the clamp.
+
+const double GAIN_SCHEDULE_MOGO_INERTIA_RATIO = 1.4;  // how much more turning inertia a clamped full goal adds (1.4 = 40%)
+
+// One tuned set of constants and where it was tuned
+struct gain_schedule_point {
+  double load = 0.0;                // 0 empty -> 1 mogo clamped
+  double battery = 12.8;            // volts it was tuned at
+  ez::PID::Constants constants{};   // kp, ki, kd, start_i
+};
+
+// What the scheduler thinks the robot is like right now
+struct gain_schedule_state {
+  double battery = 12.8;        // volts the gains get looked up at, nominal while battery compensation is on
+  double load = 0.0;            // what the gains get blended with, 0 -> 1
+  double inertia_ratio = 1.0;   // measured turning inertia / characterized inertia
+  int inertia_samples = 0;      // how many turn samples went into inertia_ratio since the last clamp change
+};
+
+// Blends a schedule at (load, battery). Pure math so it can be checked anywhere
+inline ez::PID::Constants gain_schedule_interpolate(const std::vector<gain_schedule_point> &points, double load, double battery) {
+  // collect the distinct loads (rows)
+  std::vector<double> rows;
+  for (const auto &p : points) {
+    bool seen = false;
+    for (double r : rows) seen = seen || r == p.load;
+    if (!seen) rows.push_back(p.load);
+  }
+
+  // gains inside one row at this battery voltage, clamped to the ends of the row
+  auto rowGet = [&](double row) {
+    const gain_schedule_point *below = nullptr, *above = nullptr;
+    for (const auto &p : points) {
+      if (p.load != row) continue;
+      if (p.battery <= battery && (below == nullptr || p.battery > below->battery)) below = &p;
+      if (p.battery >= battery && (above == nullptr || p.battery < above->battery)) above = &p;
+    }
+    if (below == nullptr) return above->constants;
+    if (above == nullptr || above == below) return below->constants;
+    double t = (battery - below->battery) / (above->battery - below->battery);
+    ez::PID::Constants c;
+    c.kp = below->constants.kp + t * (above->constants.kp - below->constants.kp);
+    c.ki = below->constants.ki + t * (above->constants.ki - below->constants.ki);
+    c.kd = below->constants.kd + t * (above->constants.kd - below->constants.kd);
+    c.start_i = below->constants.start_i + t * (above->constants.start_i - below->constants.start_i);
+    return c;
+  };
+
+  double lower = -1e9, upper = 1e9;
+  for (double r : rows) {
+    if (r <= load && r > lower) lower = r;
+    if (r >= load && r < upper) upper = r;
+  }
+  if (lower == -1e9) return rowGet(upper);
+  if (upper == 1e9 || upper == lower) return rowGet(lower);
+  ez::PID::Constants a = rowGet(lower), b = rowGet(upper);
+  double t = (load - lower) / (upper - lower);
+  ez::PID::Constants c;
+  c.kp = a.kp + t * (b.kp - a.kp);
+  c.ki = a.ki + t * (b.ki - a.ki);
+  c.kd = a.kd + t * (b.kd - a.kd);
+  c.start_i = a.start_i + t * (b.start_i - a.start_i);
+  return c;
+}
+
+//Function initializations go here
+void gain_schedule_add(ez::e_mode mode, double load, double battery, double kp, double ki = 0.0, double kd = 0.0, double start_i = 0.0);  // DRIVE, TURN or SWING
+void gain_schedule_clear(ez::e_mode mode);
+void gain_schedule_set(ez::e_mode mode, const std::vector<gain_schedule_point> &points);  // all of a mode's points at once, the task never sees it half done
+ez::PID::Constants gain_schedule_get(ez::e_mode mode);  // what that mode should be using right now
+gain_schedule_state gain_schedule_state_get();
+void gain_schedule_task();  // run this as a task, keeps the chassis constants matched to the robot
@@ -0,0 +1,23 @@
+//Quick Note -> This is where the multi-IMU heading stuff lives. You define the stuff here in imu_fusion.cpp
+#pragma once
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// What the fusion knows about each IMU. Index 0 is always the chassis IMU (after a failover, the one that took its place)
+struct imu_fusion_sensor {
+  int port = 0;
+  double bias = 0.0;    // deg/s of drift the fusion is removing
+  double scale = 1.0;   // multiplier the fusion is applying (averages out to drive_imu_scaler_get())
+  bool alive = true;    // false once the sensor got dropped
+  int badTicks = 0;     // ticks in a row the sensor errored or disagreed with the others
+};
+
+//Function initializations go here
+void imu_fusion_initialize(std::vector<int> extra_ports);  // starts calibrating the extra IMUs. call this BEFORE chassis.initialize() so they calibrate in parallel
+bool imu_fusion_calibrate_wait(int timeout = 3000);       // waits for the extra IMUs to finish, drops the ones that didn't
+void imu_fusion_task();                                   // fuses the IMUs, corrects the chassis IMU while still, fails EZ over to a live IMU. run this as a task
+void imu_fusion_reset(double heading = 0);                // resets the heading and forgets learned scales (plain drive_imu_reset() is followed too)
+double imu_fusion_heading_get();                          // fused heading in degrees, same units as chassis.drive_imu_get()
+int imu_fusion_alive_count();                             // how many IMUs are still being used
+std::vector<imu_fusion_sensor> imu_fusion_sensors_get();  // per sensor bias/scale/health, for debugging
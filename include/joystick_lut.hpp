@@ -0,0 +1,76 @@
+//Quick Note -> This is where the joystick curve lookup tables live. You define the stuff here in joystick_lut.cpp
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// opcontrol_arcade_standard() runs EZ-Template's joystick curve (two exp()s) on both sticks every 10 ms.
+// The stick only has 255 possible values, so the curve gets computed once into a table instead, and the
+// opcontrol loop just indexes it. The tables get rebuilt when the curve scale changes (curve buttons or the
+// SD card), straight from EZ-Template's own curve functions so they always match.
+// For a curve that never changes, joystick_lut_make() is constexpr and builds the table at compile time.
+//
+// opcontrol_lut_arcade() is a drop in for opcontrol_arcade_standard(). Joystick threshold + active brake
+// are still EZ-Template's (opcontrol_joystick_threshold_iterate). joystick_latency_get() has how long it
+// takes from a stick moving to the drive motors actually changing voltage, measured on the robot.
+// Measuring means polling at 1 kHz, so joystick_latency_task only gets started with JOYSTICK_LATENCY_MEASURE
+// on, and never when a competition switch is plugged in.
+
+const int JOYSTICK_LUT_SIZE = 255;            // -127 -> 127
+const bool JOYSTICK_LATENCY_MEASURE = false;  // true starts joystick_latency_task in opcontrol (off a comp switch)
+using joystick_lut = std::array<std::int8_t, JOYSTICK_LUT_SIZE>;
+
+// exp() that works at compile time (std::exp isn't constexpr). Exact enough for a joystick
+constexpr double joystick_lut_exp(double x) {
+  // e^x = (e^(x/16))^16, the series converges fast for small x
+  double y = x / 16.0, term = 1.0, sum = 1.0;
+  for (int n = 1; n < 20; n++) {
+    term *= y / n;
+    sum += term;
+  }
+  for (int i = 0; i < 4; i++) sum *= sum;
+  return sum;
+}
+
+// Same curve as EZ-Template's opcontrol_curve_left/right (5225A In the Zone), scale 0 is a straight line
+constexpr double joystick_lut_curve(double x, double scale) {
+  if (scale == 0.0) return x;
+  double fx = x < 0 ? -x : x;
+  double low = joystick_lut_exp(-(scale / 10.0));
+  return (low + joystick_lut_exp((fx - 127.0) / 10.0) * (1.0 - low)) * x;
+}
+
+// A whole table for one curve scale. constexpr joystick_lut myCurve = joystick_lut_make(2.1);
+constexpr joystick_lut joystick_lut_make(double scale) {
+  joystick_lut lut{};
+  for (int i = 0; i < JOYSTICK_LUT_SIZE; i++)
+    lut[i] = (std::int8_t)joystick_lut_curve(i - 127, scale);  // int cast like EZ-Template's int sticks
+  return lut;
+}
+
+// Stick value -> curved value
+inline int joystick_lut_apply(const joystick_lut &lut, int x) {
+  if (x > 127) x = 127;
+  if (x < -127) x = -127;
+  return lut[x + 127];
+}
+
+// Stick -> motor latency, in ms
+struct joystick_latency {
+  double last = 0.0;
+  double min = 0.0;
+  double mean = 0.0;
+  double max = 0.0;
+  int samples = 0;
+  double loop_us = 0.0;  // how long opcontrol_lut_arcade() itself takes, averaged
+};
+
+//Function initializations go here
+void joystick_lut_rebuild();                                           // rebuild both tables from EZ-Template's curves (do this after opcontrol_curve_sd_initialize)
+void joystick_lut_fixed_set(const joystick_lut &left, const joystick_lut &right);  // use constexpr tables instead, stops following EZ-Template's curve
+void opcontrol_lut_arcade(ez::e_type stick_type);                      // drop in for chassis.opcontrol_arcade_standard()
+joystick_latency joystick_latency_get();
+void joystick_latency_task();                                          // run this as a task in opcontrol to measure stick -> motor latency
@@ -0,0 +1,82 @@
+//Quick Note -> This is where the loop timing profiler lives. You define the stuff here in loop_profiler.cpp
+#pragma once
+
+#include <cstdint>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// Every loop on the robot assumes it runs at its period (opcontrol 10 ms, armDriver/antiJam/colorSort 20 ms,
+// tempDisplay 50 ms), and everything tuned on top of it (PID, slew, timers) assumes that too. This measures it:
+//   int loop = loop_profile_register("armDriver", 20);   // once, before the while loop
+//   while (true) {
+//     loop_profile_start(loop);   // top of the loop
+//     ...
+//     loop_profile_end(loop);     // right before the pros::delay
+//     pros::delay(20);
+//   }
+// For every loop it keeps period (start to start) and execution time (start to end) min/mean/max, a histogram
+// of how far off the period each iteration was (jitter) and how many iterations were late by more than
+// LOOP_PROFILE_OVERRUN_US. Start/end are a pros::micros() and some adds, cheap enough to leave in.
+// Registering the same name again gives back the same loop, so tasks that get made every auton just add to it.
+//
+// See it with loop_profile_print() (terminal), loop_profile_save() (SD card) or the third blank brain page.
+
+const int LOOP_PROFILE_MAX = 16;          // loops that can be registered
+const int LOOP_PROFILE_BINS = 7;          // jitter histogram bins, edges below
+const int LOOP_PROFILE_BIN_EDGES[LOOP_PROFILE_BINS - 1] = {100, 250, 500, 1000, 2000, 5000};  // us off the period
+const int LOOP_PROFILE_OVERRUN_US = 2000;  // late by more than this = overrun
+const int LOOP_PROFILE_RESTART_US = 1000000;  // a gap this long is the task starting over, not a slow loop
+
+struct loop_profile {
+  const char *name = nullptr;
+  int period = 0;  // us it's supposed to take
+  int count = 0;   // periods measured
+  int period_min = 0, period_max = 0;
+  std::int64_t period_sum = 0;
+  int exec_count = 0;
+  int exec_min = 0, exec_max = 0;
+  std::int64_t exec_sum = 0;
+  int jitter[LOOP_PROFILE_BINS] = {};
+  int overruns = 0;
+  std::uint32_t start = 0;  // micros() of the last loop_profile_start
+
+  double period_mean() const { return count > 0 ? (double)period_sum / count : 0.0; }
+  double exec_mean() const { return exec_count > 0 ? (double)exec_sum / exec_count : 0.0; }
+};
+
+// Which histogram bin a jitter (us, either direction) goes in
+inline int loop_profile_bin(int jitter) {
+  if (jitter < 0) jitter = -jitter;
+  for (int i = 0; i < LOOP_PROFILE_BINS - 1; i++)
+    if (jitter < LOOP_PROFILE_BIN_EDGES[i]) return i;
+  return LOOP_PROFILE_BINS - 1;
+}
+
+// One measured period (us) into the stats
+inline void loop_profile_period_add(loop_profile &p, int period) {
+  p.period_min = p.count == 0 || period < p.period_min ? period : p.period_min;
+  p.period_max = p.count == 0 || period > p.period_max ? period : p.period_max;
+  p.period_sum += period;
+  p.count++;
+  p.jitter[loop_profile_bin(period - p.period)]++;
+  if (period - p.period > LOOP_PROFILE_OVERRUN_US) p.overruns++;
+}
+
+// One measured execution time (us) into the stats
+inline void loop_profile_exec_add(loop_profile &p, int exec) {
+  p.exec_min = p.exec_count == 0 || exec < p.exec_min ? exec : p.exec_min;
+  p.exec_max = p.exec_count == 0 || exec > p.exec_max ? exec : p.exec_max;
+  p.exec_sum += exec;
+  p.exec_count++;
+}
+
+//Function initializations go here
+int loop_profile_register(const char *name, int period_ms);  // returns the loop's id, -1 if there's no room
+void loop_profile_start(int loop);
+void loop_profile_end(int loop);
+void loop_profile_reset();              // clears every loop's stats (keeps the loops)
+int loop_profile_count();               // loops registered
+loop_profile loop_profile_get(int loop);
+void loop_profile_print();              // table to the terminal
+bool loop_profile_save();               // /usd/loop_profile.csv, false if there's no SD card
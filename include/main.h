@@ -46,6 +46,26 @@
 // More includes here...
 #include "autons.hpp"
 #include "subsystems.hpp"
+#include "odom_covariance.hpp"
+#include "imu_fusion.hpp"
+#include "startup.hpp"
+#include "tracker_calibration.hpp"
+#include "feedforward.hpp"
+#include "sysid.hpp"
+#include "pid_autotune.hpp"
+#include "gain_schedule.hpp"
+#include "battery_compensation.hpp"
+#include "power_manager.hpp"
+#include "scurve_slew.hpp"
+#include "joystick_lut.hpp"
+#include "traction_control.hpp"
+#include "thermal_model.hpp"
+#include "loop_profiler.hpp"
+#include "memory_monitor.hpp"
+#include "cpu_usage.hpp"
+#include "trace_log.hpp"
+#include "param_table.hpp"
+#include "telemetry.hpp"
 
 
 /**
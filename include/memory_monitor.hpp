@@ -0,0 +1,70 @@
+//Quick Note -> This is where the stack + heap monitor lives. You define the stuff here in memory_monitor.cpp
+#pragma once
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// Every pros::Task gets the default stack (TASK_STACK_DEPTH_DEFAULT words = 32 KB) whether it needs 2 KB or
+// 30 KB, and the heap is shared by every task, LVGL's own 32 KB pool aside. Running out of either is a crash
+// mid-match with no message. This keeps the worst case of each, split by competition mode:
+//   - stack: each task's high-water mark (the least free stack it has ever had). Tasks sample themselves, so
+//     call memory_monitor_register("armDriver") once in the task and memory_monitor_sample(id) in its loop
+//     (it only actually measures every MEMORY_SAMPLE_TIME, the rest of the time it's one millis() check)
+//   - heap: used, free and largest free block, off newlib's mallinfo and the linker's heap end
+//   - LVGL pool: used, free and largest free block, measured from inside LVGL's own task (an lv_timer) since
+//     LVGL isn't thread safe, so it's safe in every mode
+// Anything closer than its margin prints a warning once per mode and shows up on memory_state_get().warning.
+// A task with a lot of stack left over in every mode is wasting RAM, shrink it where it gets made.
+//
+// See it with memory_monitor_print() (terminal), memory_monitor_save() (SD card) or the fourth blank page.
+
+enum memory_mode { MEMORY_DISABLED = 0,
+                   MEMORY_AUTON = 1,
+                   MEMORY_DRIVER = 2 };
+const int MEMORY_MODES = 3;
+
+const int MEMORY_SAMPLE_TIME = 1000;                       // ms between measurements
+const int MEMORY_TASKS_MAX = 16;                           // tasks that can register
+const int MEMORY_STACK_DEFAULT = TASK_STACK_DEPTH_DEFAULT * 4;  // bytes, what a pros::Task gets without asking
+const int MEMORY_STACK_MARGIN = 2048;                      // bytes of stack left that's too close
+const int MEMORY_HEAP_MARGIN = 512 * 1024;                 // bytes of heap left that's too close
+const int MEMORY_LVGL_MARGIN = 4096;                       // bytes of LVGL pool left that's too close
+
+struct memory_task_state {
+  const char *name = nullptr;
+  int stack_size = MEMORY_STACK_DEFAULT;  // bytes
+  int stack_free[MEMORY_MODES] = {-1, -1, -1};  // bytes, least ever free in each mode. -1 = never measured
+  bool warned[MEMORY_MODES] = {};
+};
+
+struct memory_pool_state {
+  int used = 0;     // bytes
+  int free = 0;     // bytes
+  int largest = 0;  // bytes, biggest single allocation that would work right now
+  int free_min[MEMORY_MODES] = {-1, -1, -1};     // least free seen in each mode
+  int largest_min[MEMORY_MODES] = {-1, -1, -1};  // smallest largest-block seen in each mode
+};
+
+struct memory_state {
+  memory_task_state tasks[MEMORY_TASKS_MAX];
+  int task_count = 0;
+  bool stack_measurable = false;  // false if this PROS kernel doesn't export a stack high-water mark
+  memory_pool_state heap;
+  memory_pool_state lvgl;
+  int warnings = 0;
+  char warning[48] = "";  // last warning
+};
+
+// Keep the least of old/new, -1 means nothing yet
+inline int memory_min(int old, int fresh) {
+  return old < 0 || fresh < old ? fresh : old;
+}
+
+//Function initializations go here
+int memory_monitor_register(const char *name, int stack_bytes = MEMORY_STACK_DEFAULT);  // call from inside the task
+void memory_monitor_sample(int id);  // call from inside the same task, every loop is fine
+memory_mode memory_mode_get();       // what the competition switch says
+memory_state memory_state_get();
+void memory_monitor_print();
+bool memory_monitor_save();          // /usd/memory_monitor.csv, false if there's no SD card
+void memory_monitor_task();          // run this as a task, it does the heap + LVGL side
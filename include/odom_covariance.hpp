@@ -0,0 +1,38 @@
+//Quick Note -> This is where the odometry uncertainty stuff lives. You define the stuff here in odom_covariance.cpp
+#pragma once
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// Symmetric 3x3 covariance of the odom pose (x, y, theta)
+// x/y terms are in inches, theta terms are in degrees
+struct pose_covariance {
+  double xx = 0.0;
+  double xy = 0.0;
+  double xt = 0.0;
+  double yy = 0.0;
+  double yt = 0.0;
+  double tt = 0.0;
+};
+
+// Per-sensor noise models. Each "var" is how much variance gets added per unit of motion
+// These are starting points, not gospel -> tune them by driving a known path and comparing
+struct odom_noise_model {
+  double tracker_var_per_in = 0.0025;     // in^2 added per inch a tracking wheel rolls
+  double ime_var_per_in = 0.01;           // in^2 added per inch the drive motors roll (wheels slip, so worse than trackers)
+  double ime_lateral_var_per_in = 0.02;   // in^2 of sideways slip per inch traveled when there is no horizontal tracker
+  double imu_var_per_deg = 0.0004;        // deg^2 added per degree the IMU turns (scale error)
+  double imu_drift_var_per_sec = 0.0005;  // deg^2 added per second no matter what (gyro drift)
+  double reset_sigma_xy = 0.5;            // in, how well we know x/y right after odom gets set
+  double reset_sigma_theta = 1.0;         // deg, how well we know theta right after odom gets set
+};
+
+//Function initializations go here
+void odom_covariance_task();                                // propagates the covariance. run this as a task
+pose_covariance odom_covariance_get();                      // the current pose covariance
+void odom_covariance_reset();                               // resets to the noise model's reset sigmas
+void odom_covariance_reset(double sigma_xy, double sigma_theta);  // resets to custom sigmas
+double odom_xy_sigma_get();                                 // worst case position standard deviation in inches
+double odom_theta_sigma_get();                              // heading standard deviation in degrees
+void odom_noise_model_set(odom_noise_model model);          // swaps in a new noise model
+odom_noise_model odom_noise_model_get();                    // the noise model currently being used
@@ -0,0 +1,97 @@
+//Quick Note -> This is where the live parameter table lives. You define the stuff here in param_table.cpp
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// The numbers we tune all the time (lady brown PID + states, eject rotation, stall thresholds, auton speeds,
+// the chassis PID constants) are registered here by name, with the variable they live in and how far they can
+// go. The table writes straight into that variable, so the code that reads it every loop picks the new value
+// up on its next loop: no task restarts, no rebuild, no upload. Values that live inside EZ-Template get an
+// apply function that pushes them in (chassis_constants_apply() in autons.cpp).
+//
+// How to tune (not connected to a comp switch, see opcontrol() and ez_template_extras() in main.cpp):
+//  0. Flip the brain to the 6th blank page (the table). That's tuning mode: the controller belongs to the
+//     PID tuner, the table and the test routines, and the arm, pistons and intake ignore it until the brain
+//     goes to another page. Driving still works. Off that page none of the tuning buttons do anything.
+//  1. Hold B + press A to open the table on the controller (bottom line).
+//  2. UP/DOWN picks a parameter, RIGHT/LEFT change it by its step, Y puts it back to the compiled-in value.
+//  3. A saves everything to the SD card, it gets loaded at boot. * means there's something unsaved.
+//     B + A closes it. param_table_print() prints the table so good values can go back into the code.
+//
+// The file (/usd/params.bin) is a header and one fixed size record per parameter, in registration order:
+//   header: "PRM1", record count, FNV-1a of the records
+//   record: FNV-1a of the name, type, value (always a double, an int fits in one exactly)
+// Record i is checked against parameter i first, so loading is O(1) per parameter and the whole file is one
+// read. If parameters got added/removed/moved since the save, the hash finds them instead, and anything the
+// file doesn't have keeps its compiled-in value.
+
+const std::string PARAM_TABLE_FILE = "/usd/params.bin";
+const int PARAM_NAME_MAX = 10;  // so "name value" fits on one controller line
+
+enum param_type : std::uint8_t { PARAM_INT = 0,
+                                 PARAM_DOUBLE = 1 };
+
+// One registered parameter
+struct param_entry {
+  const char *name;
+  param_type type;
+  void *value;          // int * or double *, the variable the code reads
+  double min, max;      // edits and loads are clamped to this
+  double step;          // one press on the controller
+  double fallback;      // the compiled-in value (what it was when it got registered)
+  void (*apply)();      // called after it changes, nullptr if the variable is all there is
+  std::uint32_t hash;   // of the name, how the file finds it
+};
+
+#pragma pack(push, 1)
+struct param_file_header {
+  char magic[4];        // "PRM1"
+  std::uint16_t count;  // records after this
+  std::uint16_t reserved;
+  std::uint32_t check;  // FNV-1a of the records, a half written file doesn't get loaded
+};
+
+struct param_record {
+  std::uint32_t hash;
+  std::uint8_t type;
+  std::uint8_t reserved[3];
+  double value;
+};
+#pragma pack(pop)
+
+// FNV-1a, for names and for the file check
+inline std::uint32_t param_hash(const void *data, int size, std::uint32_t hash = 2166136261u) {
+  const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+  for (int i = 0; i < size; i++) hash = (hash ^ bytes[i]) * 16777619u;
+  return hash;
+}
+inline std::uint32_t param_hash(const char *name) {
+  std::uint32_t hash = 2166136261u;
+  for (; *name != '\0'; name++) hash = (hash ^ static_cast<std::uint8_t>(*name)) * 16777619u;
+  return hash;
+}
+
+//Function initializations go here
+int param_add(const char *name, int *value, int min, int max, int step, void (*apply)() = nullptr);                   // returns its index
+int param_add(const char *name, double *value, double min, double max, double step, void (*apply)() = nullptr);  // returns its index
+int param_count();
+const param_entry &param_get_entry(int index);
+int param_find(const char *name);          // -1 if there isn't one
+double param_get(int index);
+bool param_set(int index, double value);   // clamps, runs apply. false if the index is bad
+void param_table_reset();                  // everything back to compiled-in
+bool param_table_load();                   // applies the SD card values. call at boot, after everything is registered
+bool param_table_save();                   // writes the current values to the SD card
+bool param_table_dirty();                  // something changed since the last load/save
+std::string param_text(int index);         // "name value", how the controller shows it
+std::string param_fallback_text(int index);  // its compiled-in value, formatted the same way
+void param_table_print();                  // every parameter + its compiled-in value to the terminal
+bool param_table_editing();                // the controller editor is open
+void param_table_tuning_set(bool tuning);  // tuning mode on/off, off closes the editor
+bool param_table_tuning();                 // tuning mode, the driver controls leave the controller alone
+int param_table_selected();                // which parameter it's on
+void param_table_iterate();                // the controller editor, call this next to chassis.pid_tuner_iterate()
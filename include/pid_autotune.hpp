@@ -0,0 +1,64 @@
+//Quick Note -> This is where the relay PID auto-tuner lives. You define the stuff here in pid_autotune.cpp
+#pragma once
+
+#include <cmath>
+#include <string>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// How to auto-tune (tuning mode, see param_table.hpp, PID tuner on with X, see ez_template_extras() in main.cpp):
+//  1. Put the robot somewhere open. R2 picks which loop to tune (shown on the controller), L2 starts it.
+//  2. Relay test: the loop gets bang-bang output around where it is now until it oscillates steadily.
+//     The size and period of that wobble give the ultimate gain (Ku) and period (Tu) (Astrom-Hagglund).
+//  3. A few gain sets made from Ku/Tu get tried on real step moves and scored (ITAE + overshoot).
+//  4. The best one is applied (so the normal PID tuner shows it and you can still nudge it with A/Y),
+//     printed to the terminal and appended to /usd/pid_autotune.txt. Copy it into default_constants(),
+//     or save it with the parameter table (param_table.hpp) and it gets loaded at boot
+
+enum autotune_loop { AUTOTUNE_TURN = 0,
+                     AUTOTUNE_DRIVE = 1,
+                     AUTOTUNE_SWING = 2,
+                     AUTOTUNE_LB = 3 };
+
+const std::string PID_AUTOTUNE_FILE = "/usd/pid_autotune.txt";
+
+// What the relay test measured
+struct relay_result {
+  bool ok = false;         // false if it never settled into a steady oscillation
+  double ku = 0.0;         // ultimate gain, output units per error unit
+  double tu = 0.0;         // ultimate period, seconds
+  double amplitude = 0.0;  // half of the peak to peak wobble, error units
+  int cycles = 0;          // full oscillations that went into the average
+};
+
+// Gains in the same units EZ-Template's ez::PID uses (i and d are per loop tick, not per second)
+struct autotune_gains {
+  double kp = 0.0;
+  double ki = 0.0;
+  double kd = 0.0;
+  double start_i = 0.0;
+};
+
+// Describing function of a relay with hysteresis: Ku = 4d / (pi * sqrt(a^2 - eps^2))
+inline double relay_ultimate_gain(double relay_amplitude, double oscillation_amplitude, double hysteresis) {
+  double a2 = oscillation_amplitude * oscillation_amplitude - hysteresis * hysteresis;
+  if (a2 <= 0.0) return 0.0;
+  return 4.0 * relay_amplitude / (M_PI * std::sqrt(a2));
+}
+
+// Ziegler-Nichols style rule: Kp = kp_ratio*Ku, Ti = ti_ratio*Tu, Td = td_ratio*Tu.
+// ti_ratio <= 0 means no I. dt is the loop period in seconds, used to turn Ti/Td into per-tick gains
+inline autotune_gains autotune_gains_from_relay(const relay_result &relay, double kp_ratio, double ti_ratio, double td_ratio, double dt) {
+  autotune_gains g;
+  g.kp = kp_ratio * relay.ku;
+  if (ti_ratio > 0.0) g.ki = g.kp * dt / (ti_ratio * relay.tu);
+  g.kd = g.kp * td_ratio * relay.tu / dt;
+  return g;
+}
+
+//Function initializations go here
+relay_result pid_autotune_relay(autotune_loop loop);                       // runs just the relay test
+double pid_autotune_score(autotune_loop loop, const autotune_gains &gains);  // runs a step out and back with these gains, lower is better
+autotune_gains pid_autotune_run(autotune_loop loop);                       // the whole thing: relay, scored steps, apply + save the best
+void pid_autotune_iterate();                                               // call this next to chassis.pid_tuner_iterate()
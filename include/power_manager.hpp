@@ -0,0 +1,118 @@
+//Quick Note -> This is where the motor current budget manager lives. You define the stuff here in power_manager.cpp
+#pragma once
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// The brain only has so much current to hand out between all 8 motors, and when everything pulls at once
+// (pushing + scoring) it throttles whoever it wants. Instead, every subsystem asks for current with a
+// priority and the budget gets split on purpose with set_current_limit:
+//   - everyone always keeps POWER_MOTOR_MIN_MA per motor so nothing just dies
+//   - reserves come off the top next: a running intake keeps POWER_INTAKE_RUN_MA and a parked lady brown
+//     keeps POWER_LB_HOLD_MA whatever the drive is doing, those are what they need to work at all
+//   - then the highest priority gets topped up to what it asked for, then the next, and so on
+//   - same priority shares what's left in proportion to what they asked for
+// By default the manager picks requests + priorities itself (power_auto_requests below): the drive asks for
+// what it's drawing plus POWER_DRIVE_HEADROOM_MA to speed up with and goes last, unless it's pushing (high
+// current, barely moving), then it goes ahead of the intake. The lady brown wins while it's swinging up to
+// score. power_request() overrides that for one consumer.
+// Nobody gets more than the thermal model allows their motors (thermal_model.hpp), whatever they asked for.
+// POWER_BUDGET_MA is what the battery can hold up, not the sum of the motor maximums (8 x 2.5 A = 20 A, a
+// budget that big never makes anyone share). The V5 battery measures around 0.1 ohm between its cells, the
+// wiring and the brain, and a mid match battery sits around 12.4 V. Keeping the bus above 11 V, where the
+// motors have already lost ~10% of their speed and the battery sags further as it drains, leaves
+// (12.4 - 11.0) V / 0.1 ohm = 14 A. If the robot still browns out with everything pulling, watch "drawn"
+// and the battery voltage on the power page and lower it with power_budget_set().
+// tools/sim/power_budget_check.cpp runs the split at the defaults and fails if the intake or a held lady
+// brown come up short.
+
+enum power_consumer { POWER_DRIVE = 0,
+                      POWER_INTAKE = 1,
+                      POWER_LB = 2 };
+const int POWER_CONSUMERS = 3;
+
+const int POWER_BUDGET_MA = 14000;     // total to split, what keeps the battery above 11 V (see above)
+const int POWER_MOTOR_MAX_MA = 2500;   // most a single V5 motor can be set to
+const int POWER_MOTOR_MIN_MA = 500;    // least anything gets
+const int POWER_LB_HOLD_MA = 1500;     // lady brown holding still (it's on a red cartridge with hold brake)
+const int POWER_INTAKE_RUN_MA = 2000;  // intake with rings going through it
+const int POWER_DRIVE_HEADROOM_MA = 1000;  // per motor over what the drive draws, how fast its limit can climb per loop
+const int POWER_MOTORS[POWER_CONSUMERS] = {6, 1, 1};  // motors in each consumer, drive is 3 + 3
+
+// One consumer's side of the budget. Per motor numbers are what set_current_limit gets
+struct power_consumer_state {
+  int requested = POWER_MOTOR_MAX_MA;  // mA per motor
+  int priority = 1;                    // higher wins
+  int reserved = 0;                    // mA per motor it gets before any priority is looked at
+  bool manual = false;                 // true if set with power_request() instead of picked automatically
+  int thermal = POWER_MOTOR_MAX_MA;    // mA per motor the thermal model allows right now
+  int allocated = POWER_MOTOR_MAX_MA;  // mA per motor it actually got
+  int drawn = 0;                       // mA all of its motors are pulling right now
+};
+
+struct power_budget_state {
+  power_consumer_state consumers[POWER_CONSUMERS];
+  int budget = POWER_BUDGET_MA;
+  int allocated = 0;       // mA handed out in total
+  int drawn = 0;           // mA everything is pulling right now
+  bool throttled = false;  // somebody got less than they asked for
+  bool pushing = false;    // drive push detected
+  bool scoring = false;    // lady brown score move detected
+};
+
+// Splits budget between consumers. requested/reserved/allocated are per motor, reserved comes out before any
+// priority gets topped up. Pure math so it can be checked anywhere
+inline void power_budget_split(const int requested[], const int priority[], const int reserved[], const int motors[], int count, int budget,
+                               int allocated[]) {
+  // floor + reserves first
+  int remaining = budget;
+  for (int i = 0; i < count; i++) {
+    allocated[i] = std::min(requested[i], std::max(reserved[i], POWER_MOTOR_MIN_MA));
+    remaining -= allocated[i] * motors[i];
+  }
+
+  // then top up from the highest priority down
+  bool done[8] = {};
+  for (int round = 0; round < count && remaining > 0; round++) {
+    int top = -1000000;
+    for (int i = 0; i < count; i++)
+      if (!done[i]) top = std::max(top, priority[i]);
+
+    int wanted = 0;  // extra mA this priority level wants in total
+    for (int i = 0; i < count; i++)
+      if (!done[i] && priority[i] == top) wanted += (requested[i] - allocated[i]) * motors[i];
+
+    double share = wanted > remaining ? (double)remaining / wanted : 1.0;
+    for (int i = 0; i < count; i++) {
+      if (done[i] || priority[i] != top) continue;
+      int extra = (int)((requested[i] - allocated[i]) * share);  // per motor
+      allocated[i] += extra;
+      remaining -= extra * motors[i];
+      done[i] = true;
+    }
+  }
+}
+
+// What each consumer asks for when nobody's called power_request(). drive_drawn is mA per drive motor right now
+inline void power_auto_requests(int drive_drawn, bool pushing, bool intake_running, bool lb_moving, bool scoring, int requested[],
+                                int priority[], int reserved[]) {
+  requested[POWER_DRIVE] = std::min(std::max(drive_drawn, 0) + POWER_DRIVE_HEADROOM_MA, POWER_MOTOR_MAX_MA);
+  priority[POWER_DRIVE] = pushing ? 3 : 1;
+  reserved[POWER_DRIVE] = 0;
+
+  requested[POWER_INTAKE] = intake_running ? POWER_INTAKE_RUN_MA : POWER_MOTOR_MIN_MA;
+  priority[POWER_INTAKE] = 2;
+  reserved[POWER_INTAKE] = requested[POWER_INTAKE];
+
+  // the arm only needs the current for a moment, so it beats a push
+  requested[POWER_LB] = lb_moving ? POWER_MOTOR_MAX_MA : POWER_LB_HOLD_MA;
+  priority[POWER_LB] = scoring ? 4 : 2;
+  reserved[POWER_LB] = POWER_LB_HOLD_MA;
+}
+
+//Function initializations go here
+void power_request(power_consumer consumer, int mA, int priority);  // mA per motor. Sticks until power_request_clear()
+void power_request_clear(power_consumer consumer);                  // back to automatic
+void power_budget_set(int mA);                                      // total mA to split, defaults to POWER_BUDGET_MA
+power_budget_state power_budget_state_get();                        // for telemetry/screens
+void power_manager_task();                                          // run this as a task
@@ -0,0 +1,107 @@
+//Quick Note -> This is where the S-curve (jerk limited) slew lives. You define the stuff here in scurve_slew.cpp
+#pragma once
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// ez::slew ramps the max speed in a straight line from min_speed to max over distance_to_travel. The corners
+// of that line are instant changes in acceleration (infinite jerk): 0 -> min_speed the moment the motion starts,
+// and again where the line meets max speed. That kick is what breaks the wheels loose at launch.
+// The S-curve ramp uses the same constants but every corner is a smootherstep (6s^5 - 15s^4 + 10s^3), so
+// acceleration eases in and out and jerk stays finite:
+//   - launch: 0 -> min_speed over SCURVE_LAUNCH_TIME (time based, the robot isn't moving yet so distance can't)
+//   - then min_speed -> max speed over distance_to_travel, like ez::slew
+//
+// Pick it per motion type with slew_profile_set(ez::DRIVE, SLEW_SCURVE). The distance/min speed still come
+// from slew_drive/turn/swing_constants_set and the motion's slew on/off still decides if it slews at all.
+// Motions start the normal way (chassis.pid_drive_set(24_in, 110)), slew_profile_task spots the new mode or
+// target, switches that motion's ez::slew off and from then on sets its max speed to the S-curve's. ez::slew
+// returns its max speed when it's off, so EZ-Template's loop picks the S-curve up through its own iterate().
+// The task checks every SCURVE_WATCH_TIME so it gets there before EZ-Template's next tick, and puts its cap
+// back if anything resets the slew's max speed (pid_speed_max_set does, battery compensation calls that).
+// The ramp tops out at whatever pid_speed_max_get() says, so it goes up to the compensated speed.
+// Swings assume the swing slew constants are a distance (3_in in default_constants), like DRIVE.
+// Compare the two on a model: tools/sim/scurve_slew_sim.cpp
+
+const double SCURVE_LAUNCH_TIME = 0.08;  // seconds to ease up to min_speed at the start of a motion
+const int SCURVE_WATCH_TIME = 1;         // ms between slew_profile_task checks, well under EZ-Template's 10 ms tick
+
+enum slew_profile_type { SLEW_LINEAR = 0,
+                         SLEW_SCURVE = 1 };
+
+// Same interface as ez::slew, so it drops into anything that iterates one
+class scurve_slew {
+ public:
+  struct Constants {
+    double min_speed = 0;
+    double distance_to_travel = 0;
+  };
+  Constants constants;
+
+  scurve_slew() {}
+  scurve_slew(double distance, int minimum_speed) { constants_set(distance, minimum_speed); }
+
+  void constants_set(double distance, int minimum_speed) {
+    constants.distance_to_travel = std::fabs(distance);
+    constants.min_speed = std::abs(minimum_speed);
+  }
+  Constants constants_get() { return constants; }
+
+  // starts a motion. enabled false makes iterate() just return the max speed, like ez::slew
+  void initialize(bool enabled, double maximum_speed, double target, double current) {
+    is_enabled = enabled && constants.distance_to_travel > 0.0;
+    max_speed = std::fabs(maximum_speed);
+    start = current;
+    sign = target >= current ? 1 : -1;
+    launch_time = 0.0;
+    last_output = is_enabled ? 0.0 : max_speed;
+  }
+
+  // speed cap for this position. Call it once per loop tick (ez::util::DELAY_TIME), the launch counts ticks
+  double iterate(double current) {
+    if (!is_enabled) {
+      last_output = max_speed;
+      return last_output;
+    }
+    double s = (current - start) * sign / constants.distance_to_travel;
+    if (s >= 1.0) {
+      is_enabled = false;  // ramp's done for this motion
+      last_output = max_speed;
+      return last_output;
+    }
+    double low = std::fmin(constants.min_speed, max_speed);
+    last_output = low + (max_speed - low) * smootherstep(s);
+    // still launching -> ease up to min_speed
+    if (launch_time < SCURVE_LAUNCH_TIME) {
+      launch_time += ez::util::DELAY_TIME / 1000.0;
+      last_output = std::fmin(last_output, low * smootherstep(launch_time / SCURVE_LAUNCH_TIME));
+    }
+    return last_output;
+  }
+
+  bool enabled() { return is_enabled; }
+  double output() { return last_output; }
+  void speed_max_set(double speed) { max_speed = std::fabs(speed); }
+  double speed_max_get() { return max_speed; }
+
+  // 0 -> 1 with zero slope + curvature at both ends
+  static double smootherstep(double s) {
+    s = std::fmin(std::fmax(s, 0.0), 1.0);
+    return s * s * s * (s * (6.0 * s - 15.0) + 10.0);
+  }
+
+ private:
+  int sign = 1;
+  double launch_time = 0;
+  double start = 0;
+  double last_output = 0;
+  bool is_enabled = false;
+  double max_speed = 0;
+};
+
+//Function initializations go here
+void slew_profile_set(ez::e_mode mode, slew_profile_type type);  // DRIVE, TURN or SWING
+slew_profile_type slew_profile_get(ez::e_mode mode);
+void slew_profile_task();  // run this as a task, hands motions to their slew profile
@@ -0,0 +1,23 @@
+//Quick Note -> This is where the staged startup stuff lives. You define the stuff here in startup.cpp
+#pragma once
+
+#include <functional>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// Each piece of startup that can run on its own. Combine them with | to wait on more than one
+enum startup_stage {
+  STARTUP_IMU = 1 << 0,    // IMU(s) calibrated, heading fusion + odom tasks running
+  STARTUP_ADI = 1 << 1,    // legacy (3 wire) ports done configuring
+  STARTUP_SD = 1 << 2,     // SD card reads done (joystick curves, parameter table)
+  STARTUP_PATHS = 1 << 3,  // anything precomputed for autons
+};
+const int STARTUP_ALL = STARTUP_IMU | STARTUP_ADI | STARTUP_SD | STARTUP_PATHS;
+
+//Function initializations go here
+void startup_stage_run(startup_stage stage, std::function<void()> work);  // runs work in its own task, marks the stage ready when it returns
+void startup_stage_ready_set(startup_stage stage);                      // marks a stage ready by hand
+bool startup_ready(int stages);                                         // true if every stage asked for is ready
+bool startup_wait(int stages, int timeout = 5000);                      // blocks until the stages are ready, false if it timed out
+void startup_print();                                                   // prints when each stage became ready
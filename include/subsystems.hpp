@@ -12,6 +12,8 @@ extern Drive chassis;
 
 extern pros::Motor intake; // intake motor
 extern pros::Motor lb; // lady brown motor
+extern pros::MotorGroup left_drive; // left drive motors (temp display + sysid, driving is done through chassis)
+extern pros::MotorGroup right_drive; // right drive motors (temp display + sysid, driving is done through chassis)
 
 //Pistons Go Here
 extern pros::adi::DigitalOut mogo; // mogo piston
@@ -24,6 +26,9 @@ extern pros::Optical vision; // color sensor
 extern pros::Rotation lbSensor; // lady brown rot sensor
 extern pros::Distance distanceSensor; // intake stop distance sensor
 extern pros::Controller controller; // controller
+extern ez::tracking_wheel horiz_tracker; // horizontal tracking wheel
+extern ez::tracking_wheel vert_tracker; // vertical tracking wheel
+extern std::vector<int> extraImuPorts; // extra IMUs fused with the chassis IMU
 
 //Toggle Variables Go Here
 extern bool mogoToggle; // toggle for mogo clamp
@@ -41,7 +46,14 @@ extern int currState; // current state for lady brown
 extern const int numStates; // number of states for lady brown
 extern double output; // output for PID
 extern bool intakeLockingOverride; // this is used to override the intake to allow colorsort/antijam
+extern bool lbOverride; // this is used to override the lady brown PID (sysid)
 extern int states[];
+extern double kP; // lady brown PID kP (the auto-tuner changes these)
+extern double kI; // lady brown PID kI
+extern double kD; // lady brown PID kD
+extern int stallVelocity; // rpm the intake has to drop under to count as jammed (both antijams)
+extern int driverStallTime; // ms of that before the driver antijam reverses
+extern int driverEjectRotation; // degrees the driver color sort spins a wrong ring before stopping
 
 
 //Function initializations go here
@@ -0,0 +1,34 @@
+//Quick Note -> This is where the system identification (sysid) stuff lives. You define the stuff here in sysid.cpp
+#pragma once
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// Sysid runs known voltages into a mechanism and logs what it does, so kS/kV/kA (and kG for the arm) can be
+// fit on a computer instead of guessed. Logs go to the SD card as /usd/sysid_<mechanism>_<test>_<fwd|rev>.csv
+// Fit them with: python3 tools/sysid/sysid_fit.py /path/to/sd/card/sysid_*.csv
+//
+// Each mechanism runs 4 tests: quasistatic (slow voltage ramp) and dynamic (voltage step), forward and reverse.
+// The drive also runs a launch test (full 12 V from a standstill, on the field tiles) that spins the wheels on
+// purpose. Drive logs have the vert_tracker in them too, so the fit can tell wheel speed from ground speed and
+// work out traction control's launch accel (traction_control.hpp).
+// The drive stops itself after SYSID_DRIVE_MAX_TRAVEL and the arm stops at the ends of its travel, but give it room.
+
+enum sysid_mechanism { SYSID_DRIVE = 0,
+                       SYSID_INTAKE = 1,
+                       SYSID_LB = 2 };
+
+enum sysid_test { SYSID_QUASISTATIC = 0,
+                  SYSID_DYNAMIC = 1,
+                  SYSID_LAUNCH = 2 };  // drive only
+
+const double SYSID_DRIVE_MAX_TRAVEL = 60.0;  // inches, the drive tests stop past this
+const int SYSID_RAMP_MV_PER_SEC = 1000;      // quasistatic ramp rate
+const int SYSID_STEP_MV = 7000;              // dynamic step voltage
+const int SYSID_LAUNCH_MV = 12000;           // launch step voltage, enough to break the wheels loose
+const int SYSID_MAX_TIME = 8000;             // ms, longest any single test runs
+
+//Function initializations go here
+bool sysid_run(sysid_mechanism mechanism, sysid_test test, bool forward);  // runs one test and saves its log
+void sysid_run_all(sysid_mechanism mechanism);                             // all 4 tests (+ launch for the drive), waits for L2 between them so you can reset the robot
+bool sysid_running();                                                      // sysid_run_all is going, the driver controls leave the robot alone
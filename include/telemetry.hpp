@@ -0,0 +1,152 @@
+//Quick Note -> This is where the live telemetry stream lives. You define the stuff here in telemetry.cpp
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// printf'ing numbers to the terminal is slow (formatting floats on the brain is most of a loop) and floods it.
+// This streams fixed size binary records instead, to tools/telemetry/telemetry_dashboard.py which plots them live.
+// Channels, each at its own rate (param table "tl.<name>", Hz, 0 = off):
+//   - pose: odom x, y (in) and theta (deg)
+//   - pid: drive/turn/swing errors (in, deg, deg) and the lady brown error (centidegrees)
+//   - current: mA for every motor, left drive x3, right drive x3, intake, lb
+//   - arm: lady brown position and target (centidegrees)
+//   - color: one frame per color sort detect/eject, sent as soon as it happens, not at a rate
+//
+// Every record is one frame:
+//   COBS( channel, sequence, time ms (u32), payload, CRC-16/CCITT of everything before it ) 0x00
+// COBS takes every 0 out of the frame so the 0 on the end always means "frame over". A dropped byte costs
+// one frame, not the rest of the stream, and anything else on the wire (printf text) fails the CRC and gets
+// skipped. The sequence counts per channel, a gap in it is a frame that got lost.
+//
+// Where it goes: TELEMETRY_PORT 0 is the USB cable. PROS wraps everything printed in its own stream
+// framing for `pros terminal`, telemetry_enable(true) turns that off so the dashboard sees raw frames
+// (pros terminal shows junk until it's turned back off). Any other TELEMETRY_PORT is a smart port with a
+// serial adapter on it (pros::Serial at TELEMETRY_BAUD). Frames that don't fit in the port's buffer get
+// dropped and counted instead of making telemetry_task wait.
+// Hold B + press Y to turn it on/off (tuning mode, see param_table.hpp and ez_template_extras() in main.cpp).
+//
+// Cost: no formatting and no heap, one write a tick. A pose frame is ~130 ns to encode on a laptop
+// (tools/bench), call it 20x that on the brain and a busy tick is still well under 2% of its 10 ms. The
+// "telemetry" row on the loop profiler has the real number. tools/telemetry has a stand-in robot on a
+// pseudo-terminal so the dashboard can be run without a brain.
+
+const int TELEMETRY_PORT = 0;            // 0 = USB, anything else is a smart port
+const int TELEMETRY_BAUD = 921600;       // smart port only, the fastest it goes
+const int TELEMETRY_TICK = 10;           // ms, the fastest any channel can go (100 Hz)
+const int TELEMETRY_PAYLOAD_MAX = 32;    // bytes
+const int TELEMETRY_HEADER = 6;          // channel + sequence + time
+const int TELEMETRY_FRAME_MAX = TELEMETRY_HEADER + TELEMETRY_PAYLOAD_MAX + 2 + (TELEMETRY_HEADER + TELEMETRY_PAYLOAD_MAX + 2) / 254 + 2;  // + CRC, COBS overhead, the 0
+const int TELEMETRY_EVENTS = 16;         // color sort events waiting to be sent
+
+enum telemetry_channel : std::uint8_t { TELEMETRY_POSE = 0,
+                                        TELEMETRY_PID = 1,
+                                        TELEMETRY_CURRENT = 2,
+                                        TELEMETRY_ARM = 3,
+                                        TELEMETRY_COLOR = 4 };
+const int TELEMETRY_CHANNELS = 5;
+
+// Hz, what each channel starts at before the param table loads. Color isn't at a rate, its 0 is just a placeholder
+const int TELEMETRY_RATE_DEFAULT[TELEMETRY_CHANNELS] = {50, 50, 20, 20, 0};
+
+enum telemetry_color_kind : std::uint8_t { TELEMETRY_COLOR_DETECT = 0,
+                                           TELEMETRY_COLOR_EJECT = 1 };
+
+// Payloads, little endian like the brain. The dashboard unpacks these with the same layouts
+#pragma pack(push, 1)
+struct telemetry_pose {
+  float x, y, theta;
+};
+struct telemetry_pid {
+  float drive, turn, swing;
+  float lb;
+};
+struct telemetry_current {
+  std::int16_t mA[8];
+};
+struct telemetry_arm {
+  std::int32_t position, target;
+};
+struct telemetry_color {
+  std::uint8_t kind;     // telemetry_color_kind
+  std::uint8_t spare;
+  std::uint16_t hue;     // vision hue when it was detected
+  std::uint16_t ejected;  // rings ejected so far
+};
+#pragma pack(pop)
+static_assert(sizeof(telemetry_pose) == 12 && sizeof(telemetry_pid) == 16 && sizeof(telemetry_current) == 16 &&
+                  sizeof(telemetry_arm) == 8 && sizeof(telemetry_color) == 6,
+              "telemetry payloads are the wire format, telemetry_dashboard.py has to change with them");
+
+// CRC-16/CCITT-FALSE (poly 0x1021, starts at 0xFFFF), nibble table so it's 32 bytes of flash
+inline std::uint16_t telemetry_crc(const std::uint8_t *data, int size, std::uint16_t crc = 0xFFFF) {
+  static const std::uint16_t table[16] = {0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+                                          0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+  for (int i = 0; i < size; i++) {
+    crc = (crc << 4) ^ table[(crc >> 12) ^ (data[i] >> 4)];
+    crc = (crc << 4) ^ table[(crc >> 12) ^ (data[i] & 0x0F)];
+  }
+  return crc;
+}
+
+// COBS, out needs size + size / 254 + 1 bytes. Returns how many it wrote, no 0 on the end
+inline int telemetry_cobs_encode(const std::uint8_t *in, int size, std::uint8_t *out) {
+  int code = 0, o = 1;  // where the current block's length byte goes, next free byte
+  std::uint8_t length = 1;
+  for (int i = 0; i < size; i++) {
+    if (in[i] != 0) {
+      out[o++] = in[i];
+      length++;
+    }
+    if (in[i] == 0 || length == 0xFF) {
+      out[code] = length;
+      code = o++;
+      length = 1;
+    }
+  }
+  out[code] = length;
+  return o;
+}
+
+// Undoes telemetry_cobs_encode (without the 0 on the end). -1 if it isn't valid COBS
+inline int telemetry_cobs_decode(const std::uint8_t *in, int size, std::uint8_t *out) {
+  int o = 0;
+  for (int i = 0; i < size;) {
+    int length = in[i++];
+    if (length == 0 || i + length - 1 > size) return -1;
+    for (int j = 1; j < length; j++) {
+      if (in[i] == 0) return -1;
+      out[o++] = in[i++];
+    }
+    if (length != 0xFF && i < size) out[o++] = 0;
+  }
+  return o;
+}
+
+// A whole frame, 0 on the end included. out needs TELEMETRY_FRAME_MAX bytes. Returns its length, 0 if the payload is too big
+inline int telemetry_frame_encode(telemetry_channel channel, std::uint8_t sequence, std::uint32_t time, const void *payload, int size, std::uint8_t *out) {
+  if (size < 0 || size > TELEMETRY_PAYLOAD_MAX) return 0;
+  std::uint8_t raw[TELEMETRY_HEADER + TELEMETRY_PAYLOAD_MAX + 2];
+  raw[0] = channel;
+  raw[1] = sequence;
+  std::memcpy(&raw[2], &time, 4);
+  std::memcpy(&raw[TELEMETRY_HEADER], payload, size);
+  std::uint16_t crc = telemetry_crc(raw, TELEMETRY_HEADER + size);
+  raw[TELEMETRY_HEADER + size] = crc & 0xFF;
+  raw[TELEMETRY_HEADER + size + 1] = crc >> 8;
+  int length = telemetry_cobs_encode(raw, TELEMETRY_HEADER + size + 2, out);
+  out[length] = 0;
+  return length + 1;
+}
+
+//Function initializations go here
+extern int telemetryRate[TELEMETRY_CHANNELS];  // Hz, in the param table
+void telemetry_enable(bool enable);   // USB: turns PROS's stream framing off while it's on
+bool telemetry_enabled();
+void telemetry_rate_set(telemetry_channel channel, int hz);  // 0 = off, more than 1000 / TELEMETRY_TICK = every tick
+void telemetry_color_event(telemetry_color_kind kind, int hue, int ejected);  // call from the color sort loops
+int telemetry_dropped();              // frames that didn't fit in the port's buffer
+void telemetry_task();                // run this as a task
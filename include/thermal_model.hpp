@@ -0,0 +1,94 @@
+//Quick Note -> This is where the motor thermal model lives. You define the stuff here in thermal_model.cpp
+#pragma once
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// V5 motors cut their power in half at 55C and there's no warning before it happens. This keeps a temperature
+// estimate for every motor so it can be seen coming:
+//   - model: dT/dt = heat * I^2 - (T - ambient) / cool   (current heats it, it cools toward the air)
+//   - the motor's own temperature only comes in 5C steps, so the estimate gets pulled back inside whatever
+//     step the motor reports. Between steps the current draw is what moves it
+//   - time to throttle: how long until 55C if it keeps pulling the current it's pulling now. That's the RMS
+//     current over the last few seconds: heat goes with I^2, so an average would under-predict bursty driving
+// With derating on, a motor that would throttle before THERMAL_HORIZON runs out gets its current limit eased
+// down to the current that lands it just under THERMAL_LIMIT_TEMP at the horizon. It's a little slower all
+// match instead of half power at the end. The limit goes to power_manager.hpp, which stays the one that sets
+// the motor current limits. Derating is OFF until thermal_replay has passed on a log from the real robot
+// (the constants and the prediction have only been checked against a made up log so far).
+//
+// Time to throttle for the worst motor shows on line 2 of the controller (tempDisplay).
+// thermal_log_enable(true) logs current + reported temperature to /usd/thermal_log.csv (a motor that wasn't
+// plugged in that sample logs THERMAL_LOG_ABSENT as its temperature). Check the model against it on a computer
+// (and fit heat/cool) with tools/sim/thermal_replay.cpp. Log with derating off (the default), otherwise it
+// stops the throttles the predictions get checked against.
+
+enum thermal_motor { THERMAL_LEFT_1 = 0,
+                     THERMAL_LEFT_2 = 1,
+                     THERMAL_LEFT_3 = 2,
+                     THERMAL_RIGHT_1 = 3,
+                     THERMAL_RIGHT_2 = 4,
+                     THERMAL_RIGHT_3 = 5,
+                     THERMAL_INTAKE = 6,
+                     THERMAL_LB = 7 };
+const int THERMAL_MOTORS = 8;
+
+const double THERMAL_THROTTLE_TEMP = 55.0;  // C, where the firmware halves the power
+const double THERMAL_LIMIT_TEMP = 50.0;     // C, where derating aims to top out (one sensor step under throttle)
+const double THERMAL_SENSOR_STEP = 5.0;     // C, resolution of get_temperature()
+const double THERMAL_AMBIENT = 25.0;        // C, room temperature
+const double THERMAL_HEAT = 0.10;           // C per second per A^2, fit with thermal_replay
+const double THERMAL_COOL = 300.0;          // s, cooling time constant, fit with thermal_replay
+const double THERMAL_HORIZON = 120.0;       // s, how far ahead derating looks (a match, with some left over)
+const double THERMAL_DERATE_RATE = 100.0;   // mA per second the limit moves at most, so the driver barely feels it
+const double THERMAL_CURRENT_FILTER_TIME = 5.0;  // s, time to throttle uses the RMS current over about this long (tuned with thermal_replay)
+const int THERMAL_SAMPLE_TIME = 100;        // ms
+const int THERMAL_MIN_MA = 500;             // derating never goes under this
+const int THERMAL_MAX_MA = 2500;
+const int THERMAL_LOG_ABSENT = -1;          // C in the log, the motor wasn't there
+
+struct thermal_motor_state {
+  double temperature = THERMAL_AMBIENT;  // C, model estimate
+  double reported = 0.0;                 // C, what the motor says
+  double current = 0.0;                  // A, RMS over about THERMAL_CURRENT_FILTER_TIME
+  double time_to_throttle = INFINITY;    // s at the current it's pulling now
+  int limit = THERMAL_MAX_MA;            // mA, what derating allows
+};
+
+// One step of the model
+inline double thermal_step(double temperature, double amps, double ambient, double heat, double cool, double dt) {
+  return temperature + (heat * amps * amps - (temperature - ambient) / cool) * dt;
+}
+
+// Keep the estimate inside the 5C step the motor reports (it reports the bottom of the step)
+inline double thermal_correct(double temperature, double reported) {
+  return std::fmin(std::fmax(temperature, reported), reported + THERMAL_SENSOR_STEP);
+}
+
+// Seconds until limit at a steady current. 0 if it's already there, INFINITY if it never gets there
+inline double thermal_time_to(double temperature, double amps, double ambient, double heat, double cool, double limit) {
+  if (temperature >= limit) return 0.0;
+  double steady = ambient + heat * amps * amps * cool;
+  if (steady <= limit) return INFINITY;
+  return cool * std::log((steady - temperature) / (steady - limit));
+}
+
+// Steady current (A) that reaches limit exactly after horizon seconds
+inline double thermal_current_for(double temperature, double ambient, double heat, double cool, double limit, double horizon) {
+  double e = std::exp(-horizon / cool);
+  double steady = (limit - temperature * e) / (1.0 - e);
+  if (steady <= ambient) return 0.0;
+  return std::sqrt((steady - ambient) / (heat * cool));
+}
+
+//Function initializations go here
+void thermal_constants_set(thermal_motor motor, double heat, double cool);  // from thermal_replay
+void thermal_derate_enable(bool enable);                                    // off by default, see above
+void thermal_log_enable(bool enable);
+thermal_motor_state thermal_state_get(thermal_motor motor);
+int thermal_limit_get(thermal_motor motor);  // mA, for power_manager
+thermal_motor thermal_worst_get();           // the motor closest to throttling
+const char *thermal_motor_name(thermal_motor motor);  // "L1", "IN", ... (same as the log columns)
+void thermal_task();                         // run this as a task
@@ -0,0 +1,90 @@
+//Quick Note -> This is where the execution trace lives. You define the stuff here in trace_log.cpp
+#pragma once
+
+#include <cstdint>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// A timeline of what every task was doing, to see where an auton's 15 seconds actually go. Events get
+// timestamped with pros::micros() into a RAM ring buffer and trace_task writes them to /usd/trace.bin.
+// tools/trace/trace_convert.py turns that into Chrome trace JSON, which opens in chrome://tracing or
+// ui.perfetto.dev with one row per task:
+//   - auton: the whole selected auton (autonomous() turns the trace on for it)
+//   - motion: each drive/turn/swing/odom motion on its own "drive" row, arg is the e_mode. Watched by
+//     trace_task every 10 ms like EZ-Template's own loop. Two odom motions back to back without a wait in
+//     between can't be told apart and show up as one
+//   - pid_wait: inside each motion on the "drive" row, from the start until EZ-Template's exit conditions say
+//     it's done (what pid_wait() waits for), or the next motion starts first (pid_wait_until, quick chains).
+//     arg is which motion of the auton it is, 1 for the first. trace_task runs the exit conditions itself on
+//     copies of the motion's PIDs, so the autons don't do anything for it. Gaps between waits are the auton's
+//     pros::delay()s and code
+//   - loop: every loop_profile_start/end (loop_profiler.hpp), so each task wake-up and how long it ran
+//   - arm: lady brown target changes, arg is the target. color_detect: wrong ring seen, arg is the hue.
+//     color_eject: it got thrown, arg is how many have been so far
+// Off, an event is one bool check. On, it's a micros(), a short task lookup and 12 bytes into RAM.
+
+enum trace_event { TRACE_AUTON = 0,
+                   TRACE_PID_WAIT = 1,
+                   TRACE_MOTION = 2,
+                   TRACE_LOOP = 3,
+                   TRACE_ARM = 4,
+                   TRACE_COLOR_DETECT = 5,
+                   TRACE_COLOR_EJECT = 6 };
+const int TRACE_EVENTS = 7;
+
+// Phases, same letters Chrome's trace format uses
+const char TRACE_BEGIN = 'B';
+const char TRACE_END = 'E';
+const char TRACE_INSTANT = 'i';
+const char TRACE_TASK_NAME = 'N';   // only in the file: a task's name follows the record
+const char TRACE_EVENT_NAME = 'M';  // only in the file: an event's name follows the record
+
+const int TRACE_BUFFER = 2048;     // records in RAM, about 2 s of a busy auton
+const int TRACE_SLACK = 16;        // newest records the writer leaves alone, they might be half written
+const int TRACE_TASKS_MAX = 32;
+const int TRACE_NAME_LENGTH = 16;  // names in the file are padded to this
+const int TRACE_OBSERVE_TIME = 10;  // ms, how often trace_task checks the drive
+const int TRACE_FLUSH_TIME = 100;   // ms between writes to the SD card
+const int TRACE_DRIVE_TASK = 0;     // task id of the "drive" row the motions go on
+
+// What goes in the file, 12 bytes each. The file is "EZTRACE1" and then these, where a TRACE_TASK_NAME or
+// TRACE_EVENT_NAME record is followed by TRACE_NAME_LENGTH bytes of name
+struct trace_record {
+  std::uint32_t time;  // micros(), wraps every 71 minutes
+  std::int32_t arg;
+  std::uint8_t event;  // trace_event, or the id for a name record
+  std::uint8_t phase;  // TRACE_BEGIN/END/INSTANT/...
+  std::uint8_t task;   // who it happened on
+  std::uint8_t spare;
+};
+static_assert(sizeof(trace_record) == 12, "trace_record is the file format, keep it 12 bytes");
+
+extern bool traceOn;
+
+//Function initializations go here
+void trace_write(trace_event event, char phase, int arg);  // use the trace_* below instead
+void trace_enable(bool enable);  // on starts a fresh /usd/trace.bin, off writes what's left
+bool trace_enabled();
+void trace_task_name(const char *name);  // names the calling task's row, loop_profile_register does this
+int trace_dropped();             // events lost to a full buffer since the last trace_enable(true)
+void trace_task();               // run this as a task
+
+inline void trace_begin(trace_event event, int arg = 0) {
+  if (traceOn) trace_write(event, TRACE_BEGIN, arg);
+}
+inline void trace_end(trace_event event, int arg = 0) {
+  if (traceOn) trace_write(event, TRACE_END, arg);
+}
+inline void trace_instant(trace_event event, int arg = 0) {
+  if (traceOn) trace_write(event, TRACE_INSTANT, arg);
+}
+
+// Begin now, end when it goes out of scope
+struct trace_scope {
+  trace_event event;
+  int arg;
+  trace_scope(trace_event event, int arg = 0) : event(event), arg(arg) { trace_begin(event, arg); }
+  ~trace_scope() { trace_end(event, arg); }
+};
+
@@ -0,0 +1,59 @@
+//Quick Note -> This is where the tracking wheel self calibration lives. You define the stuff here in tracker_calibration.cpp
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// How to calibrate (tuning mode, see param_table.hpp and ez_template_extras() in main.cpp):
+//  1. Diameter: line the robot up on a tile seam, hold B + UP, push it straight 2 tiles (48") and press L2.
+//     Only wheels that roll when driving straight (vertical ones) get a new diameter.
+//  2. Distance to center: put the robot somewhere open, hold B + LEFT. It spins in place both ways and
+//     compares every wheel against the IMU. Do this AFTER the diameter, it uses the diameter.
+//     L2 stops it. It also stops on its own if the IMU stops answering or the robot isn't turning.
+// Results go on the SD card and get loaded at boot, so no more measuring tape.
+
+const std::string TRACKER_CALIBRATION_FILE = "/usd/tracker_calibration.txt";
+const int TRACKER_SPIN_TIMEOUT = 20000;    // ms per direction, 5 turns at 60 takes about 6 s
+const int TRACKER_SPIN_STALL_TIME = 1000;  // ms without turning TRACKER_SPIN_STALL_DEGREES = stuck or a dead IMU
+const double TRACKER_SPIN_STALL_DEGREES = 10.0;
+
+// One spin leg: how far the IMU turned and how far a wheel rolled
+struct tracker_spin_sample {
+  double imu_degrees = 0.0;
+  double travel = 0.0;  // inches, as the wheel reported it
+};
+
+// Least squares fit of travel = offset * radians turned, so several legs (both directions) average out
+// A rigid body turning by theta moves a wheel offset*theta inches along its rolling direction
+inline double tracker_offset_solve(const std::vector<tracker_spin_sample> &samples) {
+  double num = 0.0, den = 0.0;
+  for (const auto &s : samples) {
+    double rad = s.imu_degrees * M_PI / 180.0;
+    num += s.travel * rad;
+    den += rad * rad;
+  }
+  return den > 0.0 ? num / den : 0.0;
+}
+
+// The wheel said it went `reported` inches but it really went `actual`, so the diameter is off by that ratio
+inline double tracker_diameter_solve(double assumed_diameter, double reported, double actual) {
+  if (std::fabs(reported) < 1e-6) return assumed_diameter;
+  return assumed_diameter * std::fabs(actual / reported);
+}
+
+// The fit's sign is the answer: it's inches the wheel rolls per radian turned, the same thing odom uses
+// distance_to_center for. A tracker set to flip its distance gets the opposite so it comes out the same
+inline double tracker_distance_signed(double solved_offset, bool flipped) {
+  return flipped ? -solved_offset : solved_offset;
+}
+
+//Function initializations go here
+void tracker_calibration_register(std::string name, ez::tracking_wheel *tracker);  // adds a tracker to calibrate/load (names go in the SD file)
+bool tracker_calibration_load();                                                   // applies the SD card values. call at boot
+bool tracker_calibration_save();                                                   // writes the current values to the SD card
+void tracker_calibrate_diameter(double distance = 48.0);                            // push the robot `distance` inches then press L2
+void tracker_calibrate_spin(int rotations = 5, int speed = 60);                     // spins both ways and solves distance to center
@@ -0,0 +1,97 @@
+//Quick Note -> This is where traction + launch control lives. You define the stuff here in traction_control.cpp
+#pragma once
+
+#include <cmath>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+
+// Full stick from a standstill asks the 450 rpm drive for way more torque than the wheels can put on the ground,
+// so they spin and the robot goes nowhere (worst in a pushing match). Traction control compares how fast each
+// side's wheels are turning with how fast the robot is actually moving over the ground:
+//   - ground speed: vert_tracker speed, blended with the IMU's forward acceleration so it reacts within a tick
+//     (the tracker alone is a 10 ms derivative and lags), plus the IMU turn rate for each side
+//   - slip ratio: (wheel speed - ground speed) / wheel speed. 0 = rolling, 1 = spinning in place
+// Every side gets a cap on its voltage. Launch control is the cap itself: the mV that accelerates the robot at
+// the launch accel from the speed it's going now, kS + kV*v + kA*a (the drive feedforward constants from sysid).
+// When the slip ratio goes over the target anyway the launch accel gets trimmed down, and it grows back when
+// the wheels hook up again. Braking/reversing is never limited.
+//
+// The launch accel + slip target come from sysid, not the slew constants: run sysid_run(SYSID_DRIVE,
+// SYSID_LAUNCH, true) on the field tiles and tools/sysid/sysid_fit.py prints a traction_launch_set() line.
+// Without it the launch accel falls back to the drive feedforward max_accel, and without feedforward constants
+// only the slip loop runs.
+//
+// It's optional: traction_control_enable(true) and opcontrol_lut_arcade() runs it every tick.
+// traction_control_state_get().loop_us is how long the whole thing takes per tick (sensor reads included).
+
+const double TRACTION_SLIP_TARGET = 0.15;        // default slip ratio to hold, most tile traction peaks around here
+const double TRACTION_MIN_WHEEL_SPEED = 4.0;     // in/s, below this the slip ratio is just noise
+const double TRACTION_TRIM_MIN = 0.25;           // launch accel never gets trimmed below this fraction
+const double TRACTION_TRIM_GAIN = 4.0;           // trim lost per second per unit of slip over the target
+const double TRACTION_TRIM_RECOVER = 2.0;        // trim regained per second while under the target
+const double TRACTION_GROUND_FILTER = 0.08;      // s, how long the IMU gets trusted before the tracker pulls it back
+const double TRACTION_DRIVE_WIDTH = 11.5;        // in, used when EZ-Template doesn't know the drive width
+const int TRACTION_IMU_FORWARD_AXIS = 0;         // 0 = x, 1 = y. Whichever IMU axis points to the front of the robot
+const double TRACTION_IMU_FORWARD_SIGN = 1.0;    // -1 if that axis points to the back
+
+struct traction_side {
+  double wheel_speed = 0.0;   // in/s, off the drive motors
+  double ground_speed = 0.0;  // in/s, what that side is actually doing over the ground
+  double slip = 0.0;          // slip ratio, positive = wheels spinning faster than the ground in the direction they're pushed
+  double trim = 1.0;          // fraction of the launch accel allowed right now
+  double cap = 12000.0;       // mV this side can get this tick
+  bool limited = false;       // true if the cap cut this tick's command
+};
+
+struct traction_state {
+  traction_side left, right;
+  double ground_speed = 0.0;  // in/s, center of the robot
+  double ground_accel = 0.0;  // in/s^2, IMU forward
+  double loop_us = 0.0;       // per-tick cost, averaged
+};
+
+// Slip ratio for one side. Only counts spinning in the direction the wheels are going (the ones that lose ground)
+inline double traction_slip_ratio(double wheel_speed, double ground_speed) {
+  if (std::fabs(wheel_speed) < TRACTION_MIN_WHEEL_SPEED) return 0.0;
+  return (wheel_speed - ground_speed) / wheel_speed;
+}
+
+// Cap in mV for one side: what accelerates at launch_accel * trim from the ground speed it has now.
+// kV == 0 means no feedforward constants, so only the trim scales the full 12 V
+inline double traction_cap(double kS, double kV, double kA, double ground_speed, double launch_accel, double trim) {
+  if (kV <= 0.0 || launch_accel <= 0.0) return 12000.0 * trim;
+  return std::fmin(kS + kV * std::fabs(ground_speed) + kA * launch_accel * trim, 12000.0);
+}
+
+// Command (mV) after the cap. Braking (command against the ground speed) goes through untouched
+inline double traction_limit(double command, double ground_speed, double cap) {
+  bool braking = command * ground_speed < 0.0 && std::fabs(ground_speed) > TRACTION_MIN_WHEEL_SPEED;
+  if (braking || std::fabs(command) <= cap) return command;
+  return command > 0 ? cap : -cap;
+}
+
+// One side for one tick: slip ratio -> trim -> cap -> limited command (-127 -> 127). side has this tick's wheel
+// and ground speed in it, the rest gets updated. kS/kV/kA are the drive feedforward constants
+inline int traction_side_step(traction_side &side, int command, double dt, double kS, double kV, double kA, double launch_accel, double slip_target) {
+  double mV = command * 12000.0 / 127.0;
+  side.slip = traction_slip_ratio(side.wheel_speed, side.ground_speed);
+  bool pushing = mV * side.wheel_speed > 0.0;  // slip only means something while the command is what's spinning the wheels
+  if (pushing && side.slip > slip_target)
+    side.trim -= TRACTION_TRIM_GAIN * (side.slip - slip_target) * dt;
+  else
+    side.trim += TRACTION_TRIM_RECOVER * dt;
+  side.trim = std::fmin(std::fmax(side.trim, TRACTION_TRIM_MIN), 1.0);
+
+  side.cap = traction_cap(kS, kV, kA, side.ground_speed, launch_accel, side.trim);
+  double limited = traction_limit(mV, side.ground_speed, side.cap);
+  side.limited = limited != mV;
+  return std::round(limited * 127.0 / 12000.0);
+}
+
+//Function initializations go here
+void traction_control_enable(bool enable);
+bool traction_control_enabled();
+void traction_launch_set(double accel, double slip_target = TRACTION_SLIP_TARGET);  // in/s^2 + slip ratio, from sysid_fit.py
+void traction_control_iterate(int &left, int &right);  // -127 -> 127 joystick commands in, limited commands out. Once per opcontrol tick
+traction_state traction_control_state_get();
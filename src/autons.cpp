@@ -17,22 +17,43 @@
 // These are out of 127.
 // Personal Note: I never used these. I generally defaulted to 127 for any point A to point B movement
 // and around 80 for any movement that involved intaking
-const int DRIVE_SPEED = 110;
-const int TURN_SPEED = 90;  // without odom pods, try to avoid going 127 for turns as you will lose accuracy
-const int SWING_SPEED = 110;
+// Not const so the parameter table (param_table.hpp) can change them live
+int DRIVE_SPEED = 110;
+int TURN_SPEED = 90;  // without odom pods, try to avoid going 127 for turns as you will lose accuracy
+int SWING_SPEED = 110;
 
 ///
 // Constants
 ///
+// P, I, D, and Start I
+// Need to tune to make accurate, consistent, and speedy movements
+// These live out here so the parameter table (param_table.hpp) can edit them, chassis_constants_apply() pushes them into the chassis
+ez::PID::Constants driveConstants = {20.0, 0.0, 110.0, 0.0};       // Fwd/rev constants, used for odom and non odom motions
+ez::PID::Constants headingConstants = {7.0, 0.0, 20.0, 0.0};      // Holds the robot straight while going forward without odom
+ez::PID::Constants turnConstants = {3.0, 0.05, 20.0, 15.0};       // Turn in place constants
+ez::PID::Constants swingConstants = {6.0, 0.0, 65.0, 0.0};        // Swing constants
+ez::PID::Constants odomAngularConstants = {6.5, 0.0, 52.5, 0.0};  // Angular control for odom motions
+ez::PID::Constants boomerangConstants = {5.8, 0.0, 32.5, 0.0};    // Angular control for boomerang motions
+
+void chassis_constants_apply() {
+  chassis.pid_drive_constants_set(driveConstants.kp, driveConstants.ki, driveConstants.kd, driveConstants.start_i);
+  chassis.pid_heading_constants_set(headingConstants.kp, headingConstants.ki, headingConstants.kd, headingConstants.start_i);
+  chassis.pid_turn_constants_set(turnConstants.kp, turnConstants.ki, turnConstants.kd, turnConstants.start_i);
+  chassis.pid_swing_constants_set(swingConstants.kp, swingConstants.ki, swingConstants.kd, swingConstants.start_i);
+  chassis.pid_odom_angular_constants_set(odomAngularConstants.kp, odomAngularConstants.ki, odomAngularConstants.kd, odomAngularConstants.start_i);
+  chassis.pid_odom_boomerang_constants_set(boomerangConstants.kp, boomerangConstants.ki, boomerangConstants.kd, boomerangConstants.start_i);
+
+  // Gain schedules -> see gain_schedule.hpp. These replace the turn/drive constants above while they have points
+  // load (0 empty, 1 mogo), battery volts, P, I, D, Start I. The empty 12.8V rows are the constants above, the
+  // only ones that have been tuned. Add a mogo (1) or tired battery row once it's been tuned with the
+  // auto-tuner (pid_autotune.hpp) at that load and battery, ex: {1, 12.8, {2.6, 0.05, 26.0, 15.0}}
+  // Each mode gets swapped in whole, the gain schedule task runs while the parameter table calls this
+  gain_schedule_set(ez::TURN, {{0, 12.8, turnConstants}});
+  gain_schedule_set(ez::DRIVE, {{0, 12.8, driveConstants}});
+}
+
 void default_constants() {
-  // P, I, D, and Start I
-  // Need to tune to make accurate, consistent, and speedy movements
-  chassis.pid_drive_constants_set(20.0, 0.0, 110.0);         // Fwd/rev constants, used for odom and non odom motions
-  chassis.pid_heading_constants_set(7.0, 0.0, 20.0);         // Holds the robot straight while going forward without odom
-  chassis.pid_turn_constants_set(3.0, 0.05, 20.0, 15.0);     // Turn in place constants
-  chassis.pid_swing_constants_set(6.0, 0.0, 65.0);           // Swing constants
-  chassis.pid_odom_angular_constants_set(6.5, 0.0, 52.5);    // Angular control for odom motions
-  chassis.pid_odom_boomerang_constants_set(5.8, 0.0, 32.5);  // Angular control for boomerang motions
+  chassis_constants_apply();  // PID constants + gain schedules, above
 
   // Exit conditions -> useful to tune for time reasons, but not needed
   chassis.pid_turn_exit_condition_set(90_ms, 3_deg, 250_ms, 7_deg, 500_ms, 500_ms);
@@ -48,6 +69,27 @@ void default_constants() {
   chassis.slew_turn_constants_set(3_deg, 70);
   chassis.slew_drive_constants_set(3_in, 70);
   chassis.slew_swing_constants_set(3_in, 80);
+  // Linear (EZ-Template) or S-curve ramp for each motion type -> see scurve_slew.hpp
+  // Linear until the S-curve has been tried on the real robot
+  slew_profile_set(ez::DRIVE, SLEW_LINEAR);
+  slew_profile_set(ez::TURN, SLEW_LINEAR);
+  slew_profile_set(ez::SWING, SLEW_LINEAR);
+
+  // Feedforward under the PID -> see feedforward.hpp. Off until the drive gets characterized with sysid
+  // kV is off the motor free speed (450rpm on 3.25" wheels is ~76 in/s, a swing only has one side doing it), the rest
+  // was tuned in the host sim (make -C tools/sim), not on the robot
+  // kS (mV), kV (mV per unit/s), kA (mV per unit/s^2), kP (mV per unit behind), kD (mV per unit/s slower), max velocity, max accel.
+  // DRIVE is inches, TURN/SWING are degrees
+  feedforward_drive_constants_set(600, 157, 20, 300, 20, 70, 300);
+  feedforward_turn_constants_set(600, 15, 3, 250, 8, 500, 2000);
+  feedforward_swing_constants_set(600, 31, 3, 150, 5, 300, 900);
+  feedforward_enable(ez::DRIVE, false);
+  feedforward_enable(ez::TURN, false);
+  feedforward_enable(ez::SWING, false);
+  // Flip these to true once the numbers above are real sysid fits, the gain schedule measures load off them
+  feedforward_characterized_set(ez::DRIVE, false);
+  feedforward_characterized_set(ez::TURN, false);
+  feedforward_characterized_set(ez::SWING, false);
 
   // The amount that turns are prioritized over driving in odom motions
   // for this section, probbaly best to leave alone
@@ -73,38 +115,44 @@ bool sortingBool = false;  // true if sorting is active, used for antijam to che
 
 // call this to set the intake to intake indefinitely until another intake function is called
 void autoIntake() {
-  intake.move_voltage(-1200000);  // only neccessary part
+  battery_move_voltage(intake, -1200000);  // only neccessary part
   intakeState = 1;
   ringStored = false;  // true if ring is stored in intake
 }
 
 // call this to set the intake to outtake indefinitely until another intake function is called
 void outtake() {
-  intake.move_voltage(1200000);  // only neccessary part
+  battery_move_voltage(intake, 1200000);  // only neccessary part
   intakeState = 2;
 }
 // call this to stop the intake indefinitely until another intake function is called
 void Intakekill() {
-  intake.move_voltage(0);  // only neccessary part
+  battery_move_voltage(intake, 0);  // only neccessary part
   intakeState = 0;
 }
 
 // autonomous version of the antijam. seperate from driver because i found it "cleaner" that way due to differences in conditions checked
 // for annotations, refer to subsystems.cpp -> antiJamDriverControl();
+int autoStallTime = 400;    // ms of sustained low velocity to count as jam (param table: auto.stall)
+int autoEjectRotation = 25;  // degrees to spin intake to eject (tune this! param table: auto.eject)
+
 void antiJam() {
   const int checkInterval = 20;  // ms per loop
-  const int stallTime = 400;     // ms of sustained low velocity to count as jam
-  const int stallTicks = stallTime / checkInterval;
 
   int stallCounter = 0;
   int cooldown = 0;
 
+  int loop = loop_profile_register("antiJam", checkInterval);  // timing stats, see loop_profiler.hpp
+
+  int memory = memory_monitor_register("antiJam");  // stack high-water mark, see memory_monitor.hpp
   while (true) {
+    loop_profile_start(loop);
+    memory_monitor_sample(memory);
     if (intakeState == 1 && sortingBool == false && currState != 1) {
       // If velocity is very low, count it as a potential jam
-      if (std::abs(intake.get_actual_velocity()) <= 10 && cooldown == 0) {
+      if (std::abs(intake.get_actual_velocity()) <= stallVelocity && cooldown == 0) {
         stallCounter++;
-        if (stallCounter >= stallTicks) {
+        if (stallCounter >= autoStallTime / checkInterval) {
           // Jam confirmed, do anti-jam action
           outtake();
           pros::delay(100);  // reverse for 100ms
@@ -120,6 +168,7 @@ void antiJam() {
     }
 
     if (cooldown > 0) cooldown--;
+    loop_profile_end(loop);
     pros::delay(checkInterval);
   }
 }
@@ -141,7 +190,6 @@ bool isWrongRing() {
 int ringsEjected = 0;  // Number of rings ejected
 
 void colorSort() {
-  const int ejectRotation = 25;  // degrees to spin intake to eject (tune this!)
   bool ejecting = false;
   int ejectTarget = 0;
 
@@ -160,7 +208,12 @@ void colorSort() {
     lv_obj_center(colorLabel);                     // centers label in rectangle. no touch
   }
 
+  int loop = loop_profile_register("colorSort", 20);  // timing stats, see loop_profiler.hpp
+
+  int memory = memory_monitor_register("colorSort");  // stack high-water mark, see memory_monitor.hpp
   while (true) {
+    loop_profile_start(loop);
+    memory_monitor_sample(memory);
     // --- Logging to screen ---
     ez::screen_print("Rings Sorted " + std::to_string(ringsEjected), 0);
     ez::screen_print("Intake Temp " + std::to_string(int((intake.get_temperature() * 9 / 5) + 32)), 1);
@@ -177,10 +230,14 @@ void colorSort() {
       } else if (!ejecting && isWrongRing() && vision.get_proximity() > 100) {  // actual sorting logic
         ejecting = true;
         sortingBool = true;
-        ejectTarget = intake.get_position() - ejectRotation;  // because the intake is negative
+        ejectTarget = intake.get_position() - autoEjectRotation;  // because the intake is negative
+        trace_instant(TRACE_COLOR_DETECT, vision.get_hue());
+        telemetry_color_event(TELEMETRY_COLOR_DETECT, vision.get_hue(), ringsEjected);
       } else if (ejecting) {
         // Eject only based on motor position
         if (intake.get_position() <= ejectTarget) {
+          trace_instant(TRACE_COLOR_EJECT, ringsEjected + 1);
+          telemetry_color_event(TELEMETRY_COLOR_EJECT, vision.get_hue(), ringsEjected + 1);
           sortingBool = true;
           Intakekill();
           pros::delay(250);  // Allow ring to fly out
@@ -197,7 +254,7 @@ void colorSort() {
     // --- Update visual rectangle color ---
     int hueDisplay = std::clamp(int(vision.get_hue()), 0, 360);
 
-    if (hueDisplay >= 340 || hueDisplay <= 20 && vision.get_proximity() > 100) {
+    if ((hueDisplay >= 340 || hueDisplay <= 20) && vision.get_proximity() > 100) {
       lv_obj_set_style_bg_color(colorIndicator, lv_color_hex(0xFF0000), LV_PART_MAIN);  // red
       lv_label_set_text(colorLabel, "RED RING");
     } else if (hueDisplay >= 180 && hueDisplay <= 240 && vision.get_proximity() > 100) {
@@ -208,6 +265,7 @@ void colorSort() {
       lv_label_set_text(colorLabel, "NO RING");
     }
 
+    loop_profile_end(loop);
     pros::delay(20);
   }
 }
@@ -1064,4 +1122,18 @@ void exampleMovements() {
   //  -> then read the brain display for where the robot thinks it is and fine tune using that. you can find this display in auto colorsort funct
   // 5. Please for the love of GOD use odometry pods. It makes life much easier. Just ask Aadit if you don't believe me.
   // 6. If you have any code issues, feel free to reach out to me. Good Luck in Push Back and y'alls senior year. Be better than we were. Bye!
-}
\ No newline at end of file
+}
+
+// Autonomous Selector list, main.cpp hands it to the LLEMU selector and tools/sim runs every one of them
+// {"Screen Name", FunctionName} <- Format for adding a new auton
+const std::vector<ez::Auton> autonList = {
+    {"EXAMPLES", exampleMovements},
+    {"Red Negative Elim (No Rush) [1+6]", NegativeRedSafeElim},
+    {"Red Negative Qual (No Rush) [1+6]", NegativeRedSafeQual},
+    {"Blue Positive Qual (No Rush) [1+5]", PositiveBlueSafeQual},
+    {"Blue Negative Qual (No Rush) [1+5]", NegativeBlueQual},
+
+    {"Red Positive Qual (No Rush) [1+5]", PositiveRedQual},
+    {"Red Positive Elim (No Rush) [1+5]", PositiveRedElim},
+    {"Blue Positive Elim (No Rush) [1+5]", PositiveBlueElim},
+};
@@ -0,0 +1,75 @@
+#include "battery_compensation.hpp"
+
+#include "subsystems.hpp"
+
+double batteryVoltage = 0.0;  // filtered volts, 0 until the task reads it
+bool batteryCompensationOn = true;
+
+double battery_voltage_get() {
+  if (batteryVoltage < 1.0) return pros::battery::get_voltage() / 1000.0;  // task isn't running yet
+  return batteryVoltage;
+}
+
+double battery_headroom_get() {
+  return battery_voltage_get() / BATTERY_NOMINAL_VOLTAGE;
+}
+
+double battery_compensate(double mV) {
+  if (!batteryCompensationOn) return ez::util::clamp(mV, 12000.0);
+  return battery_compensate_with(mV, battery_voltage_get());
+}
+
+void battery_move_voltage(pros::AbstractMotor &motor, double mV) {
+  motor.move_voltage(battery_compensate(mV));
+}
+
+void battery_compensation_enable(bool enable) {
+  batteryCompensationOn = enable;
+}
+
+bool battery_compensation_enabled() {
+  return batteryCompensationOn;
+}
+
+// the target EZ-Template is driving the current motion to, a new one means a new motion
+double batteryMotionTarget(ez::e_mode mode) {
+  if (mode == ez::TURN) return chassis.turnPID.target_get();
+  if (mode == ez::SWING) return chassis.swingPID.target_get();
+  return chassis.leftPID.target_get();
+}
+
+void battery_compensation_task() {
+  const double alpha = (BATTERY_SAMPLE_TIME / 1000.0) / (BATTERY_FILTER_TIME + BATTERY_SAMPLE_TIME / 1000.0);
+  int sinceSample = BATTERY_SAMPLE_TIME;
+  int rawSpeed = chassis.pid_speed_max_get();  // what the motion asked for
+  int lastSet = rawSpeed;                       // what we turned it into
+  ez::e_mode lastMode = chassis.drive_mode_get();
+  double lastTarget = batteryMotionTarget(lastMode);
+
+  while (true) {
+    if (sinceSample >= BATTERY_SAMPLE_TIME) {
+      double reading = pros::battery::get_voltage() / 1000.0;
+      batteryVoltage = batteryVoltage < 1.0 ? reading : batteryVoltage + alpha * (reading - batteryVoltage);
+      sinceSample = 0;
+    }
+
+    // EZ-Template sets the max speed when a motion starts (pid_drive_set(24, 110) -> 110), so a new mode or
+    // target means whatever's there now is the new raw speed, even if it happens to match what we last set.
+    // Anything else changing it (pid_speed_max_set mid motion) is a new raw speed too. Rescale it like any
+    // other voltage command
+    ez::e_mode mode = chassis.drive_mode_get();
+    double target = batteryMotionTarget(mode);
+    int current = chassis.pid_speed_max_get();
+    if (mode != lastMode || target != lastTarget || current != lastSet) rawSpeed = current;
+    lastMode = mode;
+    lastTarget = target;
+    double speed = rawSpeed;
+    if (batteryCompensationOn && battery_voltage_get() > 1.0) speed *= BATTERY_NOMINAL_VOLTAGE / battery_voltage_get();
+    int wanted = std::round(ez::util::clamp(speed, 127.0, 0.0));
+    if (wanted != current) chassis.pid_speed_max_set(wanted);
+    lastSet = wanted;
+
+    sinceSample += ez::util::DELAY_TIME;
+    pros::delay(ez::util::DELAY_TIME);
+  }
+}
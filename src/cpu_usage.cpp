@@ -0,0 +1,141 @@
+#include "cpu_usage.hpp"
+
+#include <cstring>
+
+#include "loop_profiler.hpp"
+
+// FreeRTOS's run-time stats text, if the kernel under PROS exports it (it isn't in the public headers, and it
+// has had both names). Weak, so without either one the kernel side just doesn't show up
+extern "C" {
+__attribute__((weak)) void vTaskGetRunTimeStats(char *buffer);
+__attribute__((weak)) void task_get_run_time_stats(char *buffer);
+}
+
+cpu_usage_state cpuState;
+pros::Mutex cpuMutex;
+char cpuStatsText[4096];  // about 45 characters per task
+std::int64_t cpuLoopLast[LOOP_PROFILE_MAX] = {};
+const char *cpuModeNames[MEMORY_MODES] = {"disabled", "auton", "driver"};
+
+// find or add an entry, call with cpuMutex taken. -1 if it's full
+int cpuEntry(const char *name, bool kernel, bool &created) {
+  created = false;
+  for (int i = 0; i < cpuState.count; i++)
+    if (cpuState.entries[i].kernel == kernel && std::strcmp(cpuState.entries[i].name, name) == 0) return i;
+  if (cpuState.count >= CPU_ENTRIES_MAX) return -1;
+  cpu_usage_entry &e = cpuState.entries[cpuState.count];
+  std::strncpy(e.name, name, CPU_NAME_LENGTH - 1);
+  e.kernel = kernel;
+  created = true;
+  return cpuState.count++;
+}
+
+bool cpuReadKernelStats() {
+  if (vTaskGetRunTimeStats != nullptr)
+    vTaskGetRunTimeStats(cpuStatsText);
+  else if (task_get_run_time_stats != nullptr)
+    task_get_run_time_stats(cpuStatsText);
+  else
+    return false;
+  return cpuStatsText[0] != '\0';  // empty = the kernel was built without run-time stats
+}
+
+cpu_usage_state cpu_usage_get() {
+  cpuMutex.take();
+  cpu_usage_state s = cpuState;
+  cpuMutex.give();
+  return s;
+}
+
+void cpu_usage_reset() {
+  cpuMutex.take();
+  for (int i = 0; i < cpuState.count; i++)
+    for (int m = 0; m < MEMORY_MODES; m++) cpuState.entries[i].busy[m] = 0;
+  for (int m = 0; m < MEMORY_MODES; m++) {
+    cpuState.kernel_total[m] = 0;
+    cpuState.wall[m] = 0;
+  }
+  cpuMutex.give();
+}
+
+void cpu_usage_task() {
+  std::uint32_t lastMicros = pros::micros();
+  while (true) {
+    pros::delay(CPU_SAMPLE_TIME);
+    memory_mode mode = memory_mode_get();
+    std::uint32_t now = pros::micros();
+    bool kernel = cpuReadKernelStats();  // outside the mutex, it stops the scheduler for a moment
+
+    cpuMutex.take();
+    cpuState.wall[mode] += now - lastMicros;
+    lastMicros = now;
+
+    // loops: whatever execution time got added since last time
+    for (int i = 0; i < loop_profile_count(); i++) {
+      loop_profile p = loop_profile_get(i);
+      std::int64_t added = p.exec_sum >= cpuLoopLast[i] ? p.exec_sum - cpuLoopLast[i] : p.exec_sum;  // smaller = it got reset
+      cpuLoopLast[i] = p.exec_sum;
+      bool created;
+      int e = cpuEntry(p.name, false, created);
+      if (e >= 0) cpuState.entries[e].busy[mode] += added;
+    }
+
+    // kernel: one line per task, cumulative counters
+    cpuState.kernel_stats = kernel;
+    if (kernel) {
+      char *line = cpuStatsText;
+      while (*line != '\0') {
+        char name[CPU_NAME_LENGTH];
+        std::uint32_t counter;
+        if (cpu_usage_parse_line(line, name, counter)) {
+          bool created;
+          int e = cpuEntry(name, true, created);
+          if (e >= 0) {
+            cpu_usage_entry &entry = cpuState.entries[e];
+            // a brand new entry has no last reading to count from. A different task behind the same name is a
+            // new task that reused it, so all of its counter is new. Otherwise unsigned subtraction, which stays
+            // right when the 32 bit counter wraps
+            void *handle = pros::c::task_get_by_name(name);
+            if (!created) {
+              std::uint32_t added = handle != entry.handle ? counter : counter - entry.last;
+              entry.busy[mode] += added;
+              cpuState.kernel_total[mode] += added;
+            }
+            entry.last = counter;
+            entry.handle = handle;
+          }
+        }
+        while (*line != '\0' && *line != '\n') line++;
+        if (*line == '\n') line++;
+      }
+    }
+    cpuMutex.give();
+  }
+}
+
+void cpu_usage_print() {
+  cpu_usage_state s = cpu_usage_get();
+  printf("%-24s %6s %9s %9s %9s\n", "cpu %", "from", cpuModeNames[0], cpuModeNames[1], cpuModeNames[2]);
+  for (int i = 0; i < s.count; i++) {
+    printf("%-24s %6s", s.entries[i].name, s.entries[i].kernel ? "kernel" : "loop");
+    for (int m = 0; m < MEMORY_MODES; m++) printf(" %9.2f", s.percent(i, (memory_mode)m));
+    printf("\n");
+  }
+  if (!s.kernel_stats) printf("(no run-time stats on this kernel, only profiled loops are shown)\n");
+}
+
+bool cpu_usage_save() {
+  if (!ez::util::SD_CARD_ACTIVE) return false;
+  FILE *file = fopen("/usd/cpu_usage.csv", "w");
+  if (file == nullptr) return false;
+  cpu_usage_state s = cpu_usage_get();
+  // -1 = never ran in that mode
+  fprintf(file, "name,source,disabled,auton,driver\n");
+  for (int i = 0; i < s.count; i++) {
+    fprintf(file, "%s,%s", s.entries[i].name, s.entries[i].kernel ? "kernel" : "loop");
+    for (int m = 0; m < MEMORY_MODES; m++) fprintf(file, ",%.3f", s.percent(i, (memory_mode)m));
+    fprintf(file, "\n");
+  }
+  fclose(file);
+  return true;
+}
@@ -0,0 +1,234 @@
+#include "feedforward.hpp"
+
+#include "battery_compensation.hpp"
+#include "subsystems.hpp"
+
+// EZ-Template still runs every motion: it sets the targets, runs its PIDs and decides when the motion exits.
+// For motion types with feedforward enabled, we turn off EZ's motor output (pid_drive_toggle) and drive the
+// motors ourselves:
+//   voltage = kS*sgn(v) + kV*v + kA*a          <- what the motors need to follow the profile
+//           + kP*(profile pos - pos) + kD*(profile vel - vel)   <- PID only fixes what's left over
+// EZ's own PID output doesn't go to the motors (only the heading correction on drive motions does). Its gains
+// are tuned to do the whole job toward the final target, and it's saturated at the start of a motion, so on
+// top of the feedforward it would count the effort twice.
+// The profile is a trapezoid built live every tick toward EZ's PID target, so chained motions that change the
+// target mid-motion just keep going from the current speed.
+// In the host sim, all 8 autons with DRIVE/TURN/SWING on vs off (the constants in autons.cpp), error is how far the
+// robot is off the profile while the profile is moving, measured against the same profile either way:
+//   mode    error off -> on (mean / peak)     exit time off -> on (mean ms)
+//   drive   1.55 / 2.5 in -> 0.96 / 5.7 in     920 -> 1145 (2 waits, one of them pinned against a 90 deg heading error)
+//   turn    4.2 / 33.5 deg -> 3.2 / 17.0 deg   515 -> 517 pid_wait, 480 -> 597 quick, 363 -> 343 quick_chain
+//   swing   9.2 / 36.8 deg -> 6.2 / 33.4 deg   735 -> 720 pid_wait, 613 -> 601 quick_chain
+// The autons come out 86.3 s -> 87.0 s in total. The profile follows more tightly, but it isn't faster than EZ's
+// tuned PIDs on that robot, which is why it's still off here.
+
+feedforward_constants driveFeedforward;
+feedforward_constants turnFeedforward;
+feedforward_constants swingFeedforward;
+bool driveFeedforwardOn = false;
+bool turnFeedforwardOn = false;
+bool swingFeedforwardOn = false;
+bool driveCharacterized = false;
+bool turnCharacterized = false;
+bool swingCharacterized = false;
+double feedforwardTrackingError = 0.0;
+
+feedforward_constants feedforwardMake(double kS, double kV, double kA, double kP, double kD, double max_velocity, double max_accel) {
+  feedforward_constants c;
+  c.kS = kS;
+  c.kV = kV;
+  c.kA = kA;
+  c.kP = kP;
+  c.kD = kD;
+  c.max_velocity = max_velocity;
+  c.max_accel = max_accel;
+  return c;
+}
+
+void feedforward_drive_constants_set(double kS, double kV, double kA, double kP, double kD, double max_velocity, double max_accel) {
+  driveFeedforward = feedforwardMake(kS, kV, kA, kP, kD, max_velocity, max_accel);
+}
+void feedforward_turn_constants_set(double kS, double kV, double kA, double kP, double kD, double max_velocity, double max_accel) {
+  turnFeedforward = feedforwardMake(kS, kV, kA, kP, kD, max_velocity, max_accel);
+}
+void feedforward_swing_constants_set(double kS, double kV, double kA, double kP, double kD, double max_velocity, double max_accel) {
+  swingFeedforward = feedforwardMake(kS, kV, kA, kP, kD, max_velocity, max_accel);
+}
+
+feedforward_constants feedforward_constants_get(ez::e_mode mode) {
+  if (mode == ez::TURN) return turnFeedforward;
+  if (mode == ez::SWING) return swingFeedforward;
+  return driveFeedforward;
+}
+
+void feedforward_enable(ez::e_mode mode, bool enable) {
+  if (mode == ez::DRIVE) driveFeedforwardOn = enable;
+  if (mode == ez::TURN) turnFeedforwardOn = enable;
+  if (mode == ez::SWING) swingFeedforwardOn = enable;
+}
+
+bool feedforward_enabled(ez::e_mode mode) {
+  if (mode == ez::DRIVE) return driveFeedforwardOn;
+  if (mode == ez::TURN) return turnFeedforwardOn;
+  if (mode == ez::SWING) return swingFeedforwardOn;
+  return false;
+}
+
+void feedforward_characterized_set(ez::e_mode mode, bool characterized) {
+  if (mode == ez::DRIVE) driveCharacterized = characterized;
+  if (mode == ez::TURN) turnCharacterized = characterized;
+  if (mode == ez::SWING) swingCharacterized = characterized;
+}
+
+bool feedforward_characterized(ez::e_mode mode) {
+  if (mode == ez::DRIVE) return driveCharacterized;
+  if (mode == ez::TURN) return turnCharacterized;
+  if (mode == ez::SWING) return swingCharacterized;
+  return false;
+}
+
+double feedforward_voltage(const feedforward_constants &constants, double velocity, double accel) {
+  double out = constants.kV * velocity + constants.kA * accel;
+  if (std::fabs(velocity) > 1e-3) out += constants.kS * ez::util::sgn(velocity);
+  return out;
+}
+
+double feedforward_tracking_error_get() {
+  return feedforwardTrackingError;
+}
+
+// One live trapezoid profile. Every tick it speeds up, cruises or slows down so it can stop on the target
+struct liveProfile {
+  double position = 0.0;
+  double velocity = 0.0;
+  double accel = 0.0;
+  double target = 0.0;
+
+  void start(double current_position, double current_velocity, double new_target, double max_velocity) {
+    position = current_position;
+    velocity = ez::util::clamp(current_velocity, max_velocity);
+    accel = 0.0;
+    target = new_target;
+  }
+
+  void step(double max_velocity, double max_accel, double dt) {
+    double remaining = target - position;
+    // fastest we can be going and still stop on the target
+    double stoppable = std::sqrt(2.0 * max_accel * std::fabs(remaining)) * ez::util::sgn(remaining);
+    double wanted = ez::util::clamp(stoppable, max_velocity);
+    double next = velocity + ez::util::clamp(wanted - velocity, max_accel * dt);
+    accel = (next - velocity) / dt;
+    velocity = next;
+    position += velocity * dt;
+    // don't sail past the target from rounding
+    if ((target - position) * remaining <= 0.0) {
+      position = target;
+      velocity = 0.0;
+    }
+  }
+};
+
+// Sensor delta -> units/s. Faster than the drive could ever go means the sensor got reset (odom_xyt_set, a tare)
+// between ticks, not that the robot moved, so that tick counts as standing still
+double feedforwardVelocity(double delta, double dt, double max_velocity) {
+  double velocity = delta / dt;
+  return std::fabs(velocity) > 2.0 * max_velocity ? 0.0 : velocity;
+}
+
+// Feedforward + the residual PID on how far the robot is off the profile. Once the profile has stopped on the
+// target kS goes the way the residual pushes, otherwise a small leftover error is never enough to break static friction
+double feedforwardOutput(const feedforward_constants &c, const liveProfile &profile, double position, double velocity) {
+  double residual = c.kP * (profile.position - position) + c.kD * (profile.velocity - velocity);
+  double out = feedforward_voltage(c, profile.velocity, profile.accel) + residual;
+  if (profile.velocity == 0.0 && residual != 0.0) out += c.kS * ez::util::sgn(residual);
+  return out;
+}
+
+// writes mV (battery compensated) to every drive motor that isn't on a PTO
+void feedforwardMotorsSet(double left, double right) {
+  for (auto &motor : chassis.left_motors)
+    if (!chassis.pto_check(motor)) battery_move_voltage(motor, left);
+  for (auto &motor : chassis.right_motors)
+    if (!chassis.pto_check(motor)) battery_move_voltage(motor, right);
+}
+
+void feedforward_task() {
+  liveProfile leftProfile, rightProfile, angleProfile;
+  ez::e_mode lastMode = ez::DISABLE;
+  double lastTargetLeft = 0.0, lastTargetRight = 0.0, lastTargetAngle = 0.0;
+  double lastLeft = chassis.drive_sensor_left();
+  double lastRight = chassis.drive_sensor_right();
+  double lastAngle = chassis.drive_imu_get();
+  bool weTookOver = false;
+  const double dt = ez::util::DELAY_TIME / 1000.0;
+  const double mVPerSpeed = 12000.0 / 127.0;
+
+  while (true) {
+    ez::e_mode mode = chassis.drive_mode_get();
+    bool active = feedforward_enabled(mode);
+
+    // measured position and velocity (velocity off the position, so no unit guessing with motor rpm)
+    double left = chassis.drive_sensor_left();
+    double right = chassis.drive_sensor_right();
+    double angle = chassis.drive_imu_get();
+    double leftVel = feedforwardVelocity(left - lastLeft, dt, driveFeedforward.max_velocity);
+    double rightVel = feedforwardVelocity(right - lastRight, dt, driveFeedforward.max_velocity);
+    double angleVel = feedforwardVelocity(angle - lastAngle, dt, std::max(turnFeedforward.max_velocity, swingFeedforward.max_velocity));
+    lastLeft = left;
+    lastRight = right;
+    lastAngle = angle;
+
+    if (active && !weTookOver) {
+      chassis.pid_drive_toggle(false);  // EZ keeps computing, we do the output
+      weTookOver = true;
+    } else if (!active && weTookOver) {
+      chassis.pid_drive_toggle(true);
+      weTookOver = false;
+    }
+
+    if (active) {
+      feedforward_constants c = feedforward_constants_get(mode);
+      double speedCap = c.max_velocity * std::fabs(chassis.pid_speed_max_get()) / 127.0;
+
+      if (mode == ez::DRIVE) {
+        // new motion (or a chained one changed the target) -> restart the profile from where we are
+        if (mode != lastMode || chassis.leftPID.target != lastTargetLeft || chassis.rightPID.target != lastTargetRight) {
+          leftProfile.start(left, leftVel, chassis.leftPID.target, speedCap);
+          rightProfile.start(right, rightVel, chassis.rightPID.target, speedCap);
+          lastTargetLeft = chassis.leftPID.target;
+          lastTargetRight = chassis.rightPID.target;
+        }
+        leftProfile.step(speedCap, c.max_accel, dt);
+        rightProfile.step(speedCap, c.max_accel, dt);
+
+        double heading = chassis.headingPID.output * mVPerSpeed;  // EZ's heading correction still keeps us straight
+        double l = feedforwardOutput(c, leftProfile, left, leftVel);
+        double r = feedforwardOutput(c, rightProfile, right, rightVel);
+        feedforwardTrackingError = ((leftProfile.position - left) + (rightProfile.position - right)) / 2.0;
+        // same as EZ: if the heading correction puts a side past full power, scale both so the turn is kept
+        double faster = std::max(std::fabs(l + heading), std::fabs(r - heading));
+        double scale = faster > 12000.0 ? 12000.0 / faster : 1.0;
+        feedforwardMotorsSet((l + heading) * scale, (r - heading) * scale);
+      } else {
+        ez::PID &anglePID = mode == ez::TURN ? chassis.turnPID : chassis.swingPID;
+        if (mode != lastMode || anglePID.target != lastTargetAngle) {
+          angleProfile.start(angle, angleVel, anglePID.target, speedCap);
+          lastTargetAngle = anglePID.target;
+        }
+        angleProfile.step(speedCap, c.max_accel, dt);
+
+        double u = feedforwardOutput(c, angleProfile, angle, angleVel);
+        feedforwardTrackingError = angleProfile.position - angle;
+        if (mode == ez::TURN)
+          feedforwardMotorsSet(u, -u);
+        else if (chassis.current_swing == ez::LEFT_SWING)
+          feedforwardMotorsSet(u, 0);
+        else
+          feedforwardMotorsSet(0, -u);
+      }
+    }
+
+    lastMode = mode;
+    pros::delay(ez::util::DELAY_TIME);
+  }
+}
@@ -0,0 +1,139 @@
+#include "field_model.hpp"
+
+#include <cmath>
+
+// Plain math only in here (no pros calls), so this also builds on a computer for benchmarking.
+// See tools/bench/field_model_bench.cpp
+
+const double DEG_TO_RAD = M_PI / 180.0;
+
+bool field_model_segment_add(field_model &model, ez::pose start, ez::pose end) {
+  if (model.segmentCount >= FIELD_MAX_SEGMENTS) return false;
+  int i = model.segmentCount++;
+  model.segmentX[i] = start.x;
+  model.segmentY[i] = start.y;
+  model.segmentDX[i] = end.x - start.x;
+  model.segmentDY[i] = end.y - start.y;
+  return true;
+}
+
+bool field_model_circle_add(field_model &model, ez::pose center, double radius) {
+  if (model.circleCount >= FIELD_MAX_CIRCLES) return false;
+  int i = model.circleCount++;
+  model.circleX[i] = center.x;
+  model.circleY[i] = center.y;
+  model.circleR[i] = radius;
+  return true;
+}
+
+void field_model_goal_set(field_model &model, int goal, ez::pose position) {
+  int i = model.goalStart + goal;
+  if (goal < 0 || i >= model.circleCount) return;
+  model.circleX[i] = position.x;
+  model.circleY[i] = position.y;
+}
+
+// High Stakes field. These are close to the game manual, but measure your own field if something reads off
+field_model field_model_high_stakes() {
+  field_model model;
+  const double w = FIELD_HALF_WIDTH;
+
+  // perimeter walls (the corners fall out of these for free)
+  field_model_segment_add(model, {-w, -w}, {w, -w});
+  field_model_segment_add(model, {w, -w}, {w, w});
+  field_model_segment_add(model, {w, w}, {-w, w});
+  field_model_segment_add(model, {-w, w}, {-w, -w});
+
+  // ladder posts. a distance sensor mounted low only sees the posts, not the rungs
+  field_model_circle_add(model, {0, 24}, 1.25);
+  field_model_circle_add(model, {24, 0}, 1.25);
+  field_model_circle_add(model, {0, -24}, 1.25);
+  field_model_circle_add(model, {-24, 0}, 1.25);
+
+  // alliance stakes (left/right walls) and neutral stakes (top/bottom walls)
+  field_model_circle_add(model, {-w + 1.5, 0}, 1.5);
+  field_model_circle_add(model, {w - 1.5, 0}, 1.5);
+  field_model_circle_add(model, {0, w - 1.5}, 1.5);
+  field_model_circle_add(model, {0, -w + 1.5}, 1.5);
+
+  // mobile goals, starting spots. the base is a hexagon ~10" across, a circle is close enough
+  model.goalStart = model.circleCount;
+  field_model_circle_add(model, {-24, 24}, 5.0);
+  field_model_circle_add(model, {-24, -24}, 5.0);
+  field_model_circle_add(model, {24, 24}, 5.0);
+  field_model_circle_add(model, {24, -24}, 5.0);
+  field_model_circle_add(model, {0, 48}, 5.0);
+
+  return model;
+}
+
+// ray is origin (ox, oy) going in direction (dx, dy), which has to be length 1
+double raycastDirection(const field_model &model, double ox, double oy, double dx, double dy, double max_range) {
+  double best = max_range;
+
+  // ray vs segment: solve origin + s*dir = start + t*seg with 2d cross products
+  for (int i = 0; i < model.segmentCount; i++) {
+    double ex = model.segmentDX[i];
+    double ey = model.segmentDY[i];
+    double den = dx * ey - dy * ex;
+    if (std::fabs(den) < 1e-9) continue;  // parallel
+    double px = model.segmentX[i] - ox;
+    double py = model.segmentY[i] - oy;
+    double s = (px * ey - py * ex) / den;
+    double t = (px * dy - py * dx) / den;
+    if (s >= 0.0 && s < best && t >= 0.0 && t <= 1.0) best = s;
+  }
+
+  // ray vs circle: nearest root of |origin + s*dir - center| = r
+  for (int i = 0; i < model.circleCount; i++) {
+    double mx = ox - model.circleX[i];
+    double my = oy - model.circleY[i];
+    double b = mx * dx + my * dy;
+    double c = mx * mx + my * my - model.circleR[i] * model.circleR[i];
+    if (c > 0.0 && b > 0.0) continue;  // outside and pointing away
+    double disc = b * b - c;
+    if (disc < 0.0) continue;
+    double s = -b - std::sqrt(disc);
+    if (s < 0.0) s = 0.0;  // we're inside it
+    if (s < best) best = s;
+  }
+
+  return best;
+}
+
+double field_raycast(const field_model &model, double x, double y, double theta, double max_range) {
+  double rad = theta * DEG_TO_RAD;
+  return raycastDirection(model, x, y, std::sin(rad), std::cos(rad), max_range);
+}
+
+bool field_expected_ranges(const field_model &model, ez::pose robot, const distance_sensor_mount *mounts, int mountCount, double *out) {
+  return field_expected_ranges(model, &robot, 1, mounts, mountCount, out);
+}
+
+bool field_expected_ranges(const field_model &model, const ez::pose *robots, int robotCount, const distance_sensor_mount *mounts, int mountCount, double *out) {
+  // out is laid out by the caller's mountCount, so too many sensors can't just be cut down to what fits
+  if (mountCount > FIELD_MAX_MOUNTS) return false;
+
+  // sensor angles don't change, so their sin/cos only get computed once per call
+  double mountSin[FIELD_MAX_MOUNTS], mountCos[FIELD_MAX_MOUNTS];
+  for (int m = 0; m < mountCount; m++) {
+    mountSin[m] = std::sin(mounts[m].theta * DEG_TO_RAD);
+    mountCos[m] = std::cos(mounts[m].theta * DEG_TO_RAD);
+  }
+
+  for (int r = 0; r < robotCount; r++) {
+    double rad = robots[r].theta * DEG_TO_RAD;
+    double s = std::sin(rad);
+    double c = std::cos(rad);
+    for (int m = 0; m < mountCount; m++) {
+      // robot frame -> field frame. forward is (sin, cos), right is (cos, -sin)
+      double ox = robots[r].x + mounts[m].x * c + mounts[m].y * s;
+      double oy = robots[r].y - mounts[m].x * s + mounts[m].y * c;
+      // angle addition instead of another sin/cos
+      double dx = s * mountCos[m] + c * mountSin[m];
+      double dy = c * mountCos[m] - s * mountSin[m];
+      out[r * mountCount + m] = raycastDirection(model, ox, oy, dx, dy, mounts[m].max_range);
+    }
+  }
+  return true;
+}
@@ -0,0 +1,157 @@
+#include "gain_schedule.hpp"
+
+#include "battery_compensation.hpp"
+#include "feedforward.hpp"
+#include "subsystems.hpp"
+
+std::vector<gain_schedule_point> driveSchedule;
+std::vector<gain_schedule_point> turnSchedule;
+std::vector<gain_schedule_point> swingSchedule;
+gain_schedule_state scheduleState;
+pros::Mutex scheduleMutex;
+
+const int INERTIA_MIN_SAMPLES = 20;      // turn samples before the measured inertia is trusted over the clamp
+
+std::vector<gain_schedule_point> *scheduleFor(ez::e_mode mode) {
+  if (mode == ez::DRIVE) return &driveSchedule;
+  if (mode == ez::TURN) return &turnSchedule;
+  if (mode == ez::SWING) return &swingSchedule;
+  return nullptr;
+}
+
+void gain_schedule_add(ez::e_mode mode, double load, double battery, double kp, double ki, double kd, double start_i) {
+  std::vector<gain_schedule_point> *schedule = scheduleFor(mode);
+  if (schedule == nullptr) return;
+  gain_schedule_point p;
+  p.load = load;
+  p.battery = battery;
+  p.constants = {kp, ki, kd, start_i};
+  scheduleMutex.take();
+  schedule->push_back(p);
+  scheduleMutex.give();
+}
+
+void gain_schedule_clear(ez::e_mode mode) {
+  std::vector<gain_schedule_point> *schedule = scheduleFor(mode);
+  if (schedule == nullptr) return;
+  scheduleMutex.take();
+  schedule->clear();
+  scheduleMutex.give();
+}
+
+void gain_schedule_set(ez::e_mode mode, const std::vector<gain_schedule_point> &points) {
+  std::vector<gain_schedule_point> *schedule = scheduleFor(mode);
+  if (schedule == nullptr) return;
+  scheduleMutex.take();
+  *schedule = points;
+  scheduleMutex.give();
+}
+
+ez::PID::Constants gain_schedule_get(ez::e_mode mode) {
+  ez::PID::Constants c = {0, 0, 0, 0};
+  std::vector<gain_schedule_point> *schedule = scheduleFor(mode);
+  if (schedule == nullptr) return c;
+  scheduleMutex.take();
+  if (!schedule->empty()) c = gain_schedule_interpolate(*schedule, scheduleState.load, scheduleState.battery);
+  scheduleMutex.give();
+  return c;
+}
+
+gain_schedule_state gain_schedule_state_get() {
+  scheduleMutex.take();
+  gain_schedule_state s = scheduleState;
+  scheduleMutex.give();
+  return s;
+}
+
+// true if a and b are different enough to bother re-applying
+bool constantsChanged(const ez::PID::Constants &a, const ez::PID::Constants &b) {
+  auto differs = [](double x, double y) { return std::fabs(x - y) > 0.005 * std::max(std::fabs(x), std::fabs(y)) + 1e-9; };
+  return differs(a.kp, b.kp) || differs(a.ki, b.ki) || differs(a.kd, b.kd) || differs(a.start_i, b.start_i);
+}
+
+// compensation already turns the commands up on a tired battery, so the gains shouldn't too
+double scheduleBattery() {
+  return battery_compensation_enabled() ? BATTERY_NOMINAL_VOLTAGE : battery_voltage_get();
+}
+
+void gain_schedule_task() {
+  const double dt = ez::util::DELAY_TIME / 1000.0;
+  ez::PID::Constants lastDrive = {0, 0, 0, 0}, lastTurn = {0, 0, 0, 0}, lastSwing = {0, 0, 0, 0};
+  bool lastMogo = mogoToggle;
+  double lastAngle = chassis.drive_imu_get();
+  double omega = 0.0, lastOmega = 0.0;
+
+  scheduleState.battery = scheduleBattery();
+  scheduleState.inertia_ratio = mogoToggle ? GAIN_SCHEDULE_MOGO_INERTIA_RATIO : 1.0;
+
+  while (true) {
+    // turn rate and turn acceleration off the IMU, a little smoothing or the acceleration is all noise
+    double angle = chassis.drive_imu_get();
+    omega += 0.3 * ((angle - lastAngle) / dt - omega);
+    double alpha = (omega - lastOmega) / dt;
+    lastAngle = angle;
+    lastOmega = omega;
+
+    scheduleMutex.take();
+    scheduleState.battery = scheduleBattery();
+
+    // clamp changed -> start over from what a goal usually weighs
+    if (mogoToggle != lastMogo) {
+      scheduleState.inertia_ratio = mogoToggle ? GAIN_SCHEDULE_MOGO_INERTIA_RATIO : 1.0;
+      scheduleState.inertia_samples = 0;
+      lastMogo = mogoToggle;
+    }
+
+    // compare the voltage it took to turn against what the characterized (empty) robot needs.
+    // Guessed constants would just measure how wrong the guess is, so the clamp decides until they're real
+    feedforward_constants turn = feedforward_constants_get(ez::TURN);
+    if (feedforward_characterized(ez::TURN) && chassis.drive_mode_get() == ez::TURN && turn.kA > 0.0 && std::fabs(alpha) > 300.0 && std::fabs(omega) > 20.0) {
+      double voltage = (left_drive.get_voltage() - right_drive.get_voltage()) / 2.0;
+      double accelPart = voltage - turn.kS * ez::util::sgn(omega) - turn.kV * omega;
+      double ratio = accelPart / (turn.kA * alpha);
+      if (ratio > 0.5 && ratio < 3.0) {
+        scheduleState.inertia_ratio += 0.05 * (ratio - scheduleState.inertia_ratio);
+        scheduleState.inertia_samples++;
+      }
+    }
+
+    // load: the clamp until there's enough turning to actually measure it
+    if (scheduleState.inertia_samples >= INERTIA_MIN_SAMPLES)
+      scheduleState.load = ez::util::clamp((scheduleState.inertia_ratio - 1.0) / (GAIN_SCHEDULE_MOGO_INERTIA_RATIO - 1.0), 1.0, 0.0);
+    else
+      scheduleState.load = mogoToggle ? 1.0 : 0.0;
+
+    bool haveDrive = !driveSchedule.empty(), haveTurn = !turnSchedule.empty(), haveSwing = !swingSchedule.empty();
+    scheduleMutex.give();
+
+    // the PID tuner/auto-tuner own the constants while they're on
+    if (!chassis.pid_tuner_enabled()) {
+      // drive + swing constants get copied in when a motion starts, so new gains take over on the next motion.
+      // turnPID gets used directly, so a change shows up mid turn (it's slow and smooth, so that's fine)
+      if (haveDrive) {
+        ez::PID::Constants c = gain_schedule_get(ez::DRIVE);
+        if (constantsChanged(c, lastDrive)) {
+          chassis.pid_drive_constants_set(c.kp, c.ki, c.kd, c.start_i);
+          lastDrive = c;
+        }
+      }
+      if (haveTurn) {
+        ez::PID::Constants c = gain_schedule_get(ez::TURN);
+        if (constantsChanged(c, lastTurn)) {
+          chassis.pid_turn_constants_set(c.kp, c.ki, c.kd, c.start_i);
+          lastTurn = c;
+        }
+      }
+      if (haveSwing) {
+        ez::PID::Constants c = gain_schedule_get(ez::SWING);
+        if (constantsChanged(c, lastSwing)) {
+          chassis.pid_swing_constants_set(c.kp, c.ki, c.kd, c.start_i);
+          lastSwing = c;
+        }
+      }
+    }
+
+    pros::delay(ez::util::DELAY_TIME);
+  }
+}
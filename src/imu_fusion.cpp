@@ -0,0 +1,272 @@
+#include "imu_fusion.hpp"
+
+#include <new>
+
+#include "subsystems.hpp"
+
+// EZ-Template only reads chassis.imu, so with extra IMUs the fused heading gets written back into it with
+// set_rotation(). EZ's PIDs read that IMU every tick, so the write only happens while the drive sits still and
+// the two have drifted WRITE_BACK_DEG apart, never under a motion that's moving. With just the chassis IMU there's
+// nothing to fuse: the fused heading is that IMU's, no bias is learned and nothing is written back.
+// Every IMU gets its own online bias (learned while the robot sits still) and scale (learned during turns by
+// comparing against the other IMUs). The scales are kept averaging to drive_imu_scaler_get() so the
+// hand-tuned scaler still means what it used to.
+// EZ-Template also sets the chassis IMU itself (drive_imu_reset(), odom_xyt_set()...). set_rotation() only moves the
+// rotation offset and not the heading offset, so (rotation - heading) only changes when somebody sets it. Watching
+// that gap tells us exactly how much was set from outside, and the fused heading follows it.
+// If the chassis IMU itself dies, chassis.imu gets pointed at a live extra IMU (fusionFailover()), so EZ keeps a heading.
+
+pros::Mutex fusionMutex;
+std::vector<pros::Imu> extraImus;         // the IMUs beyond the chassis one
+std::vector<imu_fusion_sensor> sensors;   // index 0 = chassis.imu, 1+ = extraImus
+std::vector<double> lastRaw;              // last raw rotation read from each IMU
+double fusedHeading = 0.0;
+bool fusionResetRequested = true;
+
+const int BAD_TICKS_TO_DROP = 25;        // 250 ms of errors/disagreement and the sensor is out
+const double DISAGREE_DEG_PER_TICK = 3;  // a healthy IMU won't be this far off the others in 10 ms
+const double BIAS_GAIN = 0.01;           // how fast bias is learned while still
+const double SCALE_GAIN = 0.002;         // how fast scale is learned while turning
+const double TURNING_DEG_PER_TICK = 0.3; // only learn scale when actually turning
+const double WRITE_BACK_DEG = 0.25;      // how far EZ's heading can drift off the fused one before it's corrected
+
+pros::Imu &fusionImu(int index) {
+  return index == 0 ? chassis.imu : extraImus[index - 1];
+}
+
+void imu_fusion_initialize(std::vector<int> extra_ports) {
+  fusionMutex.take();
+  extraImus.clear();
+  sensors.clear();
+
+  imu_fusion_sensor primary;
+  primary.port = chassis.imu.get_port();
+  sensors.push_back(primary);
+
+  // reset(false) doesn't block, so all of these calibrate at the same time as the chassis IMU
+  for (int port : extra_ports) {
+    extraImus.push_back(pros::Imu(port));
+    extraImus.back().reset(false);
+    imu_fusion_sensor extra;
+    extra.port = port;
+    sensors.push_back(extra);
+  }
+  lastRaw.assign(sensors.size(), 0.0);
+  fusionMutex.give();
+}
+
+bool imu_fusion_calibrate_wait(int timeout) {
+  int start = pros::millis();
+  bool allGood = true;
+  for (int i = 1; i < (int)sensors.size(); i++) {
+    while (fusionImu(i).is_calibrating() && (int)(pros::millis() - start) < timeout)
+      pros::delay(ez::util::DELAY_TIME);
+
+    // still calibrating or unplugged -> don't trust it
+    if (fusionImu(i).is_calibrating() || std::isinf(fusionImu(i).get_rotation())) {
+      sensors[i].alive = false;
+      allGood = false;
+      printf("IMU on port %i failed to calibrate, dropping it\n", sensors[i].port);
+    }
+  }
+  return allGood;
+}
+
+// keeps the average scale of the alive sensors equal to the chassis scaler
+void scalesNormalize() {
+  double sum = 0;
+  int count = 0;
+  for (auto &s : sensors) {
+    if (!s.alive) continue;
+    sum += s.scale;
+    count++;
+  }
+  if (count == 0 || sum == 0) return;
+  double fix = chassis.drive_imu_scaler_get() * count / sum;
+  for (auto &s : sensors)
+    if (s.alive) s.scale *= fix;
+}
+
+// The chassis IMU is out. EZ-Template can only read chassis.imu, so that object gets rebuilt on the port of a live
+// extra IMU (a pros::Imu is nothing but its port, with a trivial destructor) and carries on from the fused heading.
+// The dead one takes the extra's slot. Returns false if there's no live IMU left to switch to
+bool fusionFailover() {
+  for (int i = 1; i < (int)sensors.size(); i++) {
+    if (!sensors[i].alive) continue;
+    int deadPort = sensors[0].port;
+    new (&chassis.imu) pros::Imu(sensors[i].port);
+    new (&extraImus[i - 1]) pros::Imu(deadPort);
+    std::swap(sensors[0], sensors[i]);
+    std::swap(lastRaw[0], lastRaw[i]);
+
+    double write = fusedHeading / chassis.drive_imu_scaler_get();
+    chassis.imu.set_rotation(write);
+    lastRaw[0] = write;
+    printf("Chassis IMU dropped, EZ-Template now reads the IMU on port %i\n", sensors[0].port);
+    return true;
+  }
+  return false;
+}
+
+void imu_fusion_task() {
+  int lastTime = pros::millis();
+  double expectedGap = 0.0;  // chassis IMU (rotation - heading) we expect if nobody else touched it
+
+  while (true) {
+    int now = pros::millis();
+    double dt = std::max(now - lastTime, 1) / 1000.0;
+    lastTime = now;
+
+    fusionMutex.take();
+    int count = sensors.size();
+    if (count == 0) {  // imu_fusion_initialize() hasn't been called yet
+      fusionMutex.give();
+      pros::delay(ez::util::DELAY_TIME);
+      continue;
+    }
+    std::vector<double> raw(count, 0.0);
+    for (int i = 0; i < count; i++)
+      raw[i] = sensors[i].alive ? fusionImu(i).get_rotation() : 0.0;
+
+    double gap = sensors[0].alive ? ez::util::wrap_angle(raw[0] - chassis.imu.get_heading()) : 0.0;
+    bool primaryOk = sensors[0].alive && !std::isinf(raw[0]) && !std::isinf(gap);
+
+    if (fusionResetRequested) {
+      for (auto &s : sensors) s.scale = 1.0;
+      scalesNormalize();
+      fusedHeading = primaryOk ? raw[0] * chassis.drive_imu_scaler_get() : 0.0;
+      lastRaw = raw;
+      expectedGap = gap;
+      fusionResetRequested = false;
+    }
+
+    // somebody outside of the fusion set the chassis IMU -> follow it instead of fighting it
+    if (primaryOk) {
+      double externalSet = ez::util::wrap_angle(gap - expectedGap);
+      if (std::fabs(externalSet) > 0.05) {
+        fusedHeading += externalSet * chassis.drive_imu_scaler_get();
+        lastRaw[0] += externalSet;
+      }
+      expectedGap = gap;
+    }
+
+    // with a single IMU left the heading is just that IMU's, there's nothing to learn bias or scale against
+    int alive = std::count_if(sensors.begin(), sensors.end(), [](const imu_fusion_sensor &s) { return s.alive; });
+    bool fusing = alive > 1;
+    bool still = std::abs(chassis.drive_velocity_left()) < 2 && std::abs(chassis.drive_velocity_right()) < 2;
+
+    // corrected change in heading from every sensor
+    std::vector<double> deltas;
+    std::vector<int> deltaOwners;
+    for (int i = 0; i < count; i++) {
+      if (!sensors[i].alive) continue;
+      if (std::isinf(raw[i]) || std::isnan(raw[i])) {
+        sensors[i].badTicks++;
+        continue;
+      }
+      deltas.push_back(sensors[i].scale * (raw[i] - lastRaw[i]) - (fusing ? sensors[i].bias * dt : 0.0));
+      deltaOwners.push_back(i);
+    }
+
+    if (!deltas.empty()) {
+      // median is the consensus, then average everybody that agrees with it
+      std::vector<double> sorted = deltas;
+      std::sort(sorted.begin(), sorted.end());
+      double median = sorted[sorted.size() / 2];
+      if (sorted.size() % 2 == 0) median = (median + sorted[sorted.size() / 2 - 1]) / 2.0;
+
+      // 3+ sensors vote. With 2 there's no majority, so the chassis IMU is the reference (EZ-Template can't run
+      // without it anyway) and the extra one gets dropped if it wanders off
+      bool voting = deltas.size() > 2;
+      bool againstPrimary = deltas.size() == 2 && deltaOwners[0] == 0;
+      double reference = againstPrimary ? deltas[0] : median;
+
+      double sum = 0;
+      int agree = 0;
+      for (int k = 0; k < (int)deltas.size(); k++) {
+        imu_fusion_sensor &s = sensors[deltaOwners[k]];
+        if ((voting || (againstPrimary && k > 0)) && std::fabs(deltas[k] - reference) > DISAGREE_DEG_PER_TICK) {
+          s.badTicks++;
+          continue;
+        }
+        s.badTicks = 0;
+        sum += deltas[k];
+        agree++;
+      }
+      double fusedDelta = agree > 0 ? sum / agree : median;
+      fusedHeading += fusedDelta;
+
+      // learn bias while the drive is sitting still, and scale while turning by pulling every sensor toward the consensus
+      bool turning = std::fabs(fusedDelta) > TURNING_DEG_PER_TICK;
+      for (int k = 0; k < (int)deltas.size() && fusing; k++) {
+        imu_fusion_sensor &s = sensors[deltaOwners[k]];
+        double rawDelta = raw[deltaOwners[k]] - lastRaw[deltaOwners[k]];
+        if (still)
+          s.bias += BIAS_GAIN * (s.scale * rawDelta / dt - s.bias);
+        else if (turning && deltas.size() > 1 && std::fabs(rawDelta) > TURNING_DEG_PER_TICK / 2.0)
+          s.scale += SCALE_GAIN * (fusedDelta - deltas[k]) / rawDelta;
+      }
+      if (fusing && turning && deltas.size() > 1) scalesNormalize();
+    }
+
+    // drop anything that's been bad for too long
+    for (auto &s : sensors) {
+      if (s.alive && s.badTicks >= BAD_TICKS_TO_DROP) {
+        s.alive = false;
+        printf("IMU on port %i dropped from heading fusion\n", s.port);
+        scalesNormalize();
+      }
+    }
+
+    for (int i = 0; i < count; i++)
+      if (!std::isinf(raw[i])) lastRaw[i] = raw[i];
+
+    // chassis IMU got dropped -> EZ switches to a live one, and the set_rotation() there isn't somebody else's
+    if (!sensors[0].alive && fusionFailover()) {
+      expectedGap = ez::util::wrap_angle(chassis.imu.get_rotation() - chassis.imu.get_heading());
+      primaryOk = false;  // raw[0] was the dead IMU, nothing below should use it this tick
+    }
+
+    // hand the fused heading to EZ-Template, only when there's something fused to hand over and nothing's moving
+    if (primaryOk && fusing && still) {
+      double write = fusedHeading / chassis.drive_imu_scaler_get();
+      if (std::fabs(write - raw[0]) * chassis.drive_imu_scaler_get() > WRITE_BACK_DEG) {
+        chassis.imu.set_rotation(write);
+        lastRaw[0] += write - raw[0];
+        expectedGap = ez::util::wrap_angle(expectedGap + write - raw[0]);
+      }
+    }
+    fusionMutex.give();
+
+    pros::delay(ez::util::DELAY_TIME);
+  }
+}
+
+// the heading change gets picked up through the offset gap, this also forgets the learned scales
+void imu_fusion_reset(double heading) {
+  fusionMutex.take();
+  chassis.drive_imu_reset(heading);
+  fusionResetRequested = true;
+  fusionMutex.give();
+}
+
+double imu_fusion_heading_get() {
+  fusionMutex.take();
+  double out = fusedHeading;
+  fusionMutex.give();
+  return out;
+}
+
+int imu_fusion_alive_count() {
+  fusionMutex.take();
+  int out = std::count_if(sensors.begin(), sensors.end(), [](const imu_fusion_sensor &s) { return s.alive; });
+  fusionMutex.give();
+  return out;
+}
+
+std::vector<imu_fusion_sensor> imu_fusion_sensors_get() {
+  fusionMutex.take();
+  std::vector<imu_fusion_sensor> out = sensors;
+  fusionMutex.give();
+  return out;
+}
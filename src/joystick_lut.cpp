@@ -0,0 +1,105 @@
+#include "joystick_lut.hpp"
+
+#include "subsystems.hpp"
+#include "traction_control.hpp"
+
+joystick_lut leftLut = joystick_lut_make(0.0);
+joystick_lut rightLut = joystick_lut_make(0.0);
+bool lutFollowsEz = true;  // false once fixed tables are set
+double lutProbeLeft = 0.0, lutProbeRight = 0.0;  // EZ-Template's curve at one point, to notice scale changes
+int lutTicks = 0;
+joystick_latency latencyStats;
+pros::Mutex latencyMutex;
+
+const int LUT_PROBE_INPUT = 64;    // anywhere in the middle of the curve changes when the scale does
+const int LUT_PROBE_TICKS = 25;    // check EZ-Template's curve for changes every 250 ms
+const int LATENCY_STICK_STEP = 40;  // stick has to jump this much in one go to count as a latency sample
+const int LATENCY_VOLTAGE_STEP = 1500;  // mV the drive has to move by to count as "responded"
+const int LATENCY_TIMEOUT = 250;        // ms, past this the sample was probably the joystick threshold/active brake
+
+void joystick_lut_rebuild() {
+  for (int i = 0; i < JOYSTICK_LUT_SIZE; i++) {
+    leftLut[i] = (std::int8_t)chassis.opcontrol_curve_left(i - 127);
+    rightLut[i] = (std::int8_t)chassis.opcontrol_curve_right(i - 127);
+  }
+  lutProbeLeft = chassis.opcontrol_curve_left(LUT_PROBE_INPUT);
+  lutProbeRight = chassis.opcontrol_curve_right(LUT_PROBE_INPUT);
+  lutFollowsEz = true;
+}
+
+void joystick_lut_fixed_set(const joystick_lut &left, const joystick_lut &right) {
+  leftLut = left;
+  rightLut = right;
+  lutFollowsEz = false;
+}
+
+void opcontrol_lut_arcade(ez::e_type stick_type) {
+  int start = pros::micros();
+
+  // curve buttons still work, they change EZ-Template's scale and the probe below picks it up
+  if (lutFollowsEz) {
+    chassis.opcontrol_curve_buttons_iterate();
+    if (++lutTicks >= LUT_PROBE_TICKS) {
+      lutTicks = 0;
+      if (chassis.opcontrol_curve_left(LUT_PROBE_INPUT) != lutProbeLeft || chassis.opcontrol_curve_right(LUT_PROBE_INPUT) != lutProbeRight)
+        joystick_lut_rebuild();
+    }
+  }
+
+  // same sticks as opcontrol_arcade_standard()
+  int fwd, turn;
+  if (stick_type == ez::SPLIT) {
+    fwd = joystick_lut_apply(leftLut, master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y));
+    turn = joystick_lut_apply(rightLut, master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X));
+  } else {
+    fwd = joystick_lut_apply(leftLut, master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y));
+    turn = joystick_lut_apply(rightLut, master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_X));
+  }
+  int left = fwd + turn, right = fwd - turn;
+  traction_control_iterate(left, right);  // does nothing unless traction control is on
+  // threshold + active brake + setting the motors
+  chassis.opcontrol_joystick_threshold_iterate(left, right);
+
+  latencyMutex.take();
+  latencyStats.loop_us += 0.05 * ((int)(pros::micros() - start) - latencyStats.loop_us);
+  latencyMutex.give();
+}
+
+joystick_latency joystick_latency_get() {
+  latencyMutex.take();
+  joystick_latency s = latencyStats;
+  latencyMutex.give();
+  return s;
+}
+
+// Watches for big stick jumps and times how long until the drive motors report a different voltage.
+// This is brain side: controller -> brain radio time isn't in here (the brain can't see it)
+void joystick_latency_task() {
+  int lastStick = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+  while (true) {
+    int stick = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+    if (std::abs(stick - lastStick) >= LATENCY_STICK_STEP) {
+      std::uint64_t t0 = pros::micros();
+      double startVoltage = left_drive.get_voltage();
+      bool responded = false;
+      while (!responded && (pros::micros() - t0) < LATENCY_TIMEOUT * 1000) {
+        responded = std::fabs(left_drive.get_voltage() - startVoltage) > LATENCY_VOLTAGE_STEP;
+        if (!responded) pros::delay(1);
+      }
+      if (responded) {
+        double ms = (pros::micros() - t0) / 1000.0;
+        latencyMutex.take();
+        joystick_latency &s = latencyStats;
+        s.last = ms;
+        s.min = s.samples == 0 ? ms : std::fmin(s.min, ms);
+        s.max = s.samples == 0 ? ms : std::fmax(s.max, ms);
+        s.mean = (s.mean * s.samples + ms) / (s.samples + 1);
+        s.samples++;
+        latencyMutex.give();
+      }
+      stick = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+    }
+    lastStick = stick;
+    pros::delay(1);
+  }
+}
@@ -0,0 +1,94 @@
+#include "loop_profiler.hpp"
+
+#include <cstring>
+
+#include "trace_log.hpp"
+
+// Each loop only gets written by its own task, so there's no mutex on the hot path. Readers might catch a
+// loop halfway through an update, which is one sample off in a printout
+loop_profile loopProfiles[LOOP_PROFILE_MAX];
+int loopProfileCount = 0;
+pros::Mutex loopRegisterMutex;
+
+int loop_profile_register(const char *name, int period_ms) {
+  loopRegisterMutex.take();
+  int id = -1;
+  for (int i = 0; i < loopProfileCount; i++)
+    if (std::strcmp(loopProfiles[i].name, name) == 0) id = i;
+  if (id < 0 && loopProfileCount < LOOP_PROFILE_MAX) {
+    id = loopProfileCount++;
+    loopProfiles[id].name = name;
+  }
+  if (id >= 0) {
+    loopProfiles[id].period = period_ms * 1000;
+    loopProfiles[id].start = 0;  // a new task, don't count the gap since the last one
+  }
+  loopRegisterMutex.give();
+  trace_task_name(name);  // the task's row on the trace gets the loop's name
+  return id;
+}
+
+void loop_profile_start(int loop) {
+  if (loop < 0) return;
+  loop_profile &p = loopProfiles[loop];
+  std::uint32_t now = pros::micros();
+  if (p.start != 0 && now - p.start < LOOP_PROFILE_RESTART_US) loop_profile_period_add(p, now - p.start);
+  p.start = now;
+  trace_begin(TRACE_LOOP, loop);
+}
+
+void loop_profile_end(int loop) {
+  if (loop < 0 || loopProfiles[loop].start == 0) return;
+  loop_profile_exec_add(loopProfiles[loop], pros::micros() - loopProfiles[loop].start);
+  trace_end(TRACE_LOOP, loop);
+}
+
+void loop_profile_reset() {
+  loopRegisterMutex.take();
+  for (int i = 0; i < loopProfileCount; i++) {
+    loop_profile fresh;
+    fresh.name = loopProfiles[i].name;
+    fresh.period = loopProfiles[i].period;
+    loopProfiles[i] = fresh;
+  }
+  loopRegisterMutex.give();
+}
+
+int loop_profile_count() {
+  return loopProfileCount;
+}
+
+loop_profile loop_profile_get(int loop) {
+  return loopProfiles[loop];
+}
+
+void loop_profile_print() {
+  printf("%-14s %6s %7s %8s %7s %7s %8s %7s %5s  jitter <100 <250 <500 <1ms <2ms <5ms 5ms+\n",
+         "loop", "period", "count", "min", "mean", "max", "exec", "max", "over");
+  for (int i = 0; i < loopProfileCount; i++) {
+    loop_profile p = loopProfiles[i];
+    printf("%-14s %6d %7d %8d %7.0f %7d %8.0f %7d %5d        ", p.name, p.period, p.count, p.period_min, p.period_mean(),
+           p.period_max, p.exec_mean(), p.exec_max, p.overruns);
+    for (int b = 0; b < LOOP_PROFILE_BINS; b++) printf(" %4d", p.jitter[b]);
+    printf("\n");
+  }
+}
+
+bool loop_profile_save() {
+  if (!ez::util::SD_CARD_ACTIVE) return false;
+  FILE *file = fopen("/usd/loop_profile.csv", "w");
+  if (file == nullptr) return false;
+  fprintf(file, "loop,period_us,count,period_min,period_mean,period_max,exec_min,exec_mean,exec_max,overruns");
+  for (int b = 0; b < LOOP_PROFILE_BINS - 1; b++) fprintf(file, ",jitter_under_%d", LOOP_PROFILE_BIN_EDGES[b]);
+  fprintf(file, ",jitter_over_%d", LOOP_PROFILE_BIN_EDGES[LOOP_PROFILE_BINS - 2]);
+  fprintf(file, "\n");
+  for (int i = 0; i < loopProfileCount; i++) {
+    loop_profile p = loopProfiles[i];
+    fprintf(file, "%s,%d,%d,%d,%.1f,%d,%d,%.1f,%d,%d", p.name, p.period, p.count, p.period_min, p.period_mean(), p.period_max,
+            p.exec_min, p.exec_mean(), p.exec_max, p.overruns);
+    for (int b = 0; b < LOOP_PROFILE_BINS; b++) fprintf(file, ",%d", p.jitter[b]);
+    fprintf(file, "\n");
+  }
+  fclose(file);
+  return true;
+}
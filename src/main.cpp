@@ -22,7 +22,27 @@ void initialize() {
   chassis.pid_targets_reset();   // Resets PID targets to 0
   chassis.drive_imu_reset();     // Reset gyro position to 0
   chassis.drive_sensor_reset();  // Reset drive sensors to 0
-  pros::delay(500);              // Stop the user from doing anything while legacy ports configure
+
+  // Startup runs in stages that overlap instead of one after another. autonomous() and opcontrol()
+  // wait on only the stages they need with startup_wait(). startup_print() shows when each finished
+
+  // Legacy ports need 500ms to configure. Only things using pistons/3 wire sensors have to wait on this now
+  startup_stage_run(STARTUP_ADI, []() { pros::delay(500); });
+
+  // IMU calibration is the slow one (2-3 s), so it starts first and everything else happens while it runs
+  // This is what chassis.initialize() used to do, minus the loading animation (the auton selector has the screen)
+  startup_stage_run(STARTUP_IMU, []() {
+    imu_fusion_initialize(extraImuPorts);  // extra IMUs calibrate at the same time as the chassis one
+    chassis.drive_imu_calibrate(false);
+    imu_fusion_calibrate_wait();
+    chassis.drive_sensor_reset();
+    master.rumble(chassis.drive_imu_calibrated() ? "." : "---");
+
+    // Fuses every IMU into the heading EZ-Template reads and fails over if the chassis IMU dies. Hands-off with just the chassis IMU
+    pros::Task imuFusionTask(imu_fusion_task);
+    // Tracks how much we can trust odom. Autons can check odom_xy_sigma_get() before precise moves
+    pros::Task odomCovarianceTask(odom_covariance_task);
+  });
 
   // Configure your motor brake modes here.
   intake.set_brake_mode(MOTOR_BRAKE_COAST);  // Intake motor brake mode
@@ -33,27 +53,103 @@ void initialize() {
   chassis.opcontrol_drive_activebrake_set(0.0);   // Sets the active brake kP. We recommend ~2.  0 will disable.
   chassis.opcontrol_curve_default_set(0.0, 0.0);  // Defaults for curve. If using tank, only the first parameter is used. (Comment this line out if you have an SD card!)
 
+  // Tracking wheels that can self calibrate. Their calibrated geometry gets loaded off the SD card below
+  tracker_calibration_register("horiz", &horiz_tracker);
+  tracker_calibration_register("vert", &vert_tracker);
+
   // Set the drive to your own constants from autons.cpp! -> NO TOUCH!
+  // Before the SD stage, the parameter table gets loaded over these
   default_constants();
 
-  // Autonomous Selector using LLEMU
-  // {"Screen Name", FunctionName} <- Format for adding a new auton
-  ez::as::auton_selector.autons_add({{"EXAMPLES", exampleMovements},
-                                     {"Red Negative Elim (No Rush) [1+6]", NegativeRedSafeElim},
-                                     {"Red Negative Qual (No Rush) [1+6]", NegativeRedSafeQual},
-                                     {"Blue Positive Qual (No Rush) [1+5]", PositiveBlueSafeQual},
-                                     {"Blue Negative Qual (No Rush) [1+5]", NegativeBlueQual},
-
-                                     {"Red Positive Qual (No Rush) [1+5]", PositiveRedQual},
-                                     {"Red Positive Elim (No Rush) [1+5]", PositiveRedElim},
-                                     {"Blue Positive Elim (No Rush) [1+5]", PositiveBlueElim}
-
-  });  
-
-  // Initialize chassis and auton selector -> NO TOUCH!!!
-  chassis.initialize();
+  // Constants that can be tuned live and saved on the SD card, see param_table.hpp. Name (10 characters max),
+  // the variable, min, max, how much one press changes it, and what pushes it into the code if that's needed.
+  // Keep adding at the end, the file loads fastest when the order doesn't change
+  param_add("lb.kP", &kP, 0.0, 20.0, 0.05);
+  param_add("lb.kI", &kI, 0.0, 1.0, 0.005);
+  param_add("lb.kD", &kD, 0.0, 20.0, 0.1);
+  param_add("lb.stow", &states[0], 0, 36000, 100, []() { target = states[currState]; });  // centidegrees, moves the arm if it's in that state
+  param_add("lb.load", &states[1], 0, 36000, 100, []() { target = states[currState]; });
+  param_add("lb.score", &states[2], 0, 36000, 100, []() { target = states[currState]; });
+  param_add("drv.eject", &driverEjectRotation, 0, 180, 1);
+  param_add("auto.eject", &autoEjectRotation, 0, 180, 1);
+  param_add("stall.rpm", &stallVelocity, 0, 100, 1);
+  param_add("drv.stall", &driverStallTime, 20, 2000, 20);
+  param_add("auto.stall", &autoStallTime, 20, 2000, 20);
+  param_add("spd.drive", &DRIVE_SPEED, 0, 127, 1);
+  param_add("spd.turn", &TURN_SPEED, 0, 127, 1);
+  param_add("spd.swing", &SWING_SPEED, 0, 127, 1);
+  param_add("drive.kP", &driveConstants.kp, 0.0, 100.0, 0.5, chassis_constants_apply);
+  param_add("drive.kI", &driveConstants.ki, 0.0, 5.0, 0.01, chassis_constants_apply);
+  param_add("drive.kD", &driveConstants.kd, 0.0, 500.0, 1.0, chassis_constants_apply);
+  param_add("head.kP", &headingConstants.kp, 0.0, 50.0, 0.25, chassis_constants_apply);
+  param_add("head.kI", &headingConstants.ki, 0.0, 5.0, 0.01, chassis_constants_apply);
+  param_add("head.kD", &headingConstants.kd, 0.0, 200.0, 0.5, chassis_constants_apply);
+  param_add("turn.kP", &turnConstants.kp, 0.0, 20.0, 0.05, chassis_constants_apply);
+  param_add("turn.kI", &turnConstants.ki, 0.0, 1.0, 0.005, chassis_constants_apply);
+  param_add("turn.kD", &turnConstants.kd, 0.0, 200.0, 0.5, chassis_constants_apply);
+  param_add("turn.si", &turnConstants.start_i, 0.0, 90.0, 1.0, chassis_constants_apply);
+  param_add("swing.kP", &swingConstants.kp, 0.0, 50.0, 0.1, chassis_constants_apply);
+  param_add("swing.kI", &swingConstants.ki, 0.0, 5.0, 0.01, chassis_constants_apply);
+  param_add("swing.kD", &swingConstants.kd, 0.0, 300.0, 0.5, chassis_constants_apply);
+  param_add("odomA.kP", &odomAngularConstants.kp, 0.0, 50.0, 0.1, chassis_constants_apply);
+  param_add("odomA.kI", &odomAngularConstants.ki, 0.0, 5.0, 0.01, chassis_constants_apply);
+  param_add("odomA.kD", &odomAngularConstants.kd, 0.0, 300.0, 0.5, chassis_constants_apply);
+  param_add("boom.kP", &boomerangConstants.kp, 0.0, 50.0, 0.1, chassis_constants_apply);
+  param_add("boom.kI", &boomerangConstants.ki, 0.0, 5.0, 0.01, chassis_constants_apply);
+  param_add("boom.kD", &boomerangConstants.kd, 0.0, 300.0, 0.5, chassis_constants_apply);
+  param_add("tl.pose", &telemetryRate[TELEMETRY_POSE], 0, 100, 5);  // Hz
+  param_add("tl.pid", &telemetryRate[TELEMETRY_PID], 0, 100, 5);
+  param_add("tl.current", &telemetryRate[TELEMETRY_CURRENT], 0, 100, 5);
+  param_add("tl.arm", &telemetryRate[TELEMETRY_ARM], 0, 100, 5);
+
+  // Joystick curves + tracker geometry + the parameter table saved on the SD card. Has to come after the curve defaults above
+  startup_stage_run(STARTUP_SD, []() {
+    chassis.opcontrol_curve_sd_initialize();
+    joystick_lut_rebuild();  // curve tables have to match the scale that just got loaded
+    tracker_calibration_load();
+    param_table_load();
+  });
+
+  // Nothing is precomputed for autons yet (EZ-Template builds paths inside pid_odom_set()).
+  // If that changes, run it with startup_stage_run(STARTUP_PATHS, ...) instead
+  startup_stage_ready_set(STARTUP_PATHS);
+
+  // Takes over the drive motors for motion types with feedforward enabled (does nothing otherwise)
+  pros::Task feedforwardTask(feedforward_task);
+
+  // Scales every motor command to act like a 12V battery, see battery_compensation.hpp
+  pros::Task batteryTask(battery_compensation_task);
+
+  // Hands motions to the S-curve ramp for motion types set to SLEW_SCURVE (does nothing otherwise), see scurve_slew.hpp
+  pros::Task slewProfileTask(slew_profile_task);
+
+  // Per motor temperature model, predicts + derates before the 55C throttle, see thermal_model.hpp
+  pros::Task thermalTask(thermal_task);
+  thermal_log_enable(false);  // true logs current + temperature to the SD card for tools/sim/thermal_replay.cpp
+
+  // Heap + LVGL pool high-water marks, tasks do their own stacks. See memory_monitor.hpp
+  pros::Task memoryTask(memory_monitor_task);
+
+  // CPU use per task + per loop, split by competition mode. See cpu_usage.hpp
+  pros::Task cpuTask(cpu_usage_task);
+
+  // Writes the execution trace to the SD card while it's on (autonomous() turns it on), see trace_log.hpp
+  pros::Task traceTask(trace_task);
+
+  // Splits the motor current between drive/intake/lb by priority, see power_manager.hpp
+  pros::Task powerTask(power_manager_task);
+
+  // Swaps the turn/drive/swing constants to match the mogo clamp + battery (does nothing for modes without a schedule)
+  pros::Task gainScheduleTask(gain_schedule_task);
+
+  // Binary telemetry to tools/telemetry/telemetry_dashboard.py while it's on (B + Y), see telemetry.hpp
+  pros::Task telemetryTask(telemetry_task);
+
+  // Autonomous Selector using LLEMU, the list is autonList at the bottom of autons.cpp
+  ez::as::auton_selector.autons_add(autonList);
+
+  // Initialize auton selector -> NO TOUCH!!!
   ez::as::initialize();
-  master.rumble(chassis.drive_imu_calibrated() ? "." : "---");
 }
 
 /**
@@ -62,6 +158,7 @@ void initialize() {
  * the robot is enabled, this task will exit.
  */
 void disabled() {
+  trace_enable(false);  // the auton gets killed when the period ends, before it can close the trace itself
   //This is useless unless you want a piston to close/open when the robot is disabled
   //this can be useful for last second hangs like Over Under, where you could drift into the hang bar -> 
   //and the bot would go up AFTER the match ended
@@ -92,6 +189,13 @@ void competition_initialize() {
  * from where it left off.
  */
 void autonomous() {
+  // Autons need a calibrated IMU, working pistons and the tuned parameters. This returns right away unless we just booted
+  if (!startup_wait(STARTUP_IMU | STARTUP_ADI | STARTUP_SD | STARTUP_PATHS) && !startup_ready(STARTUP_IMU)) {
+    // Late pistons or parameters are survivable, no heading isn't. Calibration gives up on its own after a few seconds
+    printf("autonomous: waiting on the IMU\n");
+    while (!startup_ready(STARTUP_IMU)) pros::delay(5);
+  }
+
   controller.clear();  // Clear the controller screen. Please avoid touch unless u mess w/controller display :)
 
   //Feel free to remove this if you don't use an optical sensor
@@ -112,7 +216,12 @@ void autonomous() {
 
   //NO TOUCH!!!
   chassis.drive_brake_set(MOTOR_BRAKE_HOLD);  // Set motors to hold.  This helps autonomous consistency
+  trace_enable(true);  // timeline of the auton in /usd/trace.bin, see trace_log.hpp
+  trace_begin(TRACE_AUTON, ez::as::auton_selector.auton_page_current);
   ez::as::auton_selector.selected_auton_call();  // Calls selected auton from autonomous selector
+  trace_end(TRACE_AUTON, ez::as::auton_selector.auton_page_current);
+  trace_enable(false);
+  memory_monitor_sample(memory_monitor_register("autonomous"));  // how deep the auton got into its stack
 }
 
 /**
@@ -134,17 +243,20 @@ void screen_print_tracker(ez::tracking_wheel *tracker, std::string name, int lin
  * and will help you debug problems you're having
  */
 void ez_screen_task() {
+  int memory = memory_monitor_register("ez_screen_task");  // stack high-water mark, see memory_monitor.hpp
   while (true) {
+    memory_monitor_sample(memory);
     // Only run this when not connected to a competition switch
     if (!pros::competition::is_connected()) {
       // Blank page for odom debugging
       if (chassis.odom_enabled() && !chassis.pid_tuner_enabled()) {
         // If we're on the first blank page...
         if (ez::as::page_blank_is_on(0)) {
-          // Display X, Y, and Theta
-          ez::screen_print("x: " + util::to_string_with_precision(chassis.odom_x_get()) +
-                               "\ny: " + util::to_string_with_precision(chassis.odom_y_get()) +
-                               "\na: " + util::to_string_with_precision(chassis.odom_theta_get()),
+          // Display X, Y, and Theta along with their standard deviations
+          pose_covariance cov = odom_covariance_get();
+          ez::screen_print("x: " + util::to_string_with_precision(chassis.odom_x_get()) + "  sd: " + util::to_string_with_precision(std::sqrt(cov.xx)) +
+                               "\ny: " + util::to_string_with_precision(chassis.odom_y_get()) + "  sd: " + util::to_string_with_precision(std::sqrt(cov.yy)) +
+                               "\na: " + util::to_string_with_precision(chassis.odom_theta_get()) + "  sd: " + util::to_string_with_precision(std::sqrt(cov.tt)),
                            1);  // Don't override the top Page line
 
           // Display all trackers that are being used
@@ -153,6 +265,68 @@ void ez_screen_task() {
           screen_print_tracker(chassis.odom_tracker_back, "b", 6);
           screen_print_tracker(chassis.odom_tracker_front, "f", 7);
         }
+        // Second blank page is the current budget (see power_manager.hpp)
+        else if (ez::as::page_blank_is_on(1)) {
+          power_budget_state power = power_budget_state_get();
+          const char *names[POWER_CONSUMERS] = {"drive", "intake", "lb"};
+          ez::screen_print("budget " + std::to_string(power.budget) + "  given " + std::to_string(power.allocated) + "  drawn " + std::to_string(power.drawn) +
+                               (power.throttled ? "  THROTTLED" : "") + (power.pushing ? "  push" : "") + (power.scoring ? "  score" : ""),
+                           1);
+          for (int i = 0; i < POWER_CONSUMERS; i++) {
+            power_consumer_state c = power.consumers[i];
+            ez::screen_print(std::string(names[i]) + ": want " + std::to_string(c.requested) + " got " + std::to_string(c.allocated) + " p" + std::to_string(c.priority) +
+                                 (c.manual ? "m" : "") + "  drawn " + std::to_string(c.drawn),
+                             2 + i);
+          }
+        }
+        // Third blank page is loop timing (see loop_profiler.hpp), all in us
+        else if (ez::as::page_blank_is_on(2)) {
+          ez::screen_print("loop  period  mean/max  exec mean/max  late", 1);
+          for (int i = 0; i < loop_profile_count() && i < 6; i++) {
+            loop_profile p = loop_profile_get(i);
+            ez::screen_print(std::string(p.name) + "  " + std::to_string(p.period) + "  " + std::to_string(int(p.period_mean())) + "/" + std::to_string(p.period_max) +
+                                 "  " + std::to_string(int(p.exec_mean())) + "/" + std::to_string(p.exec_max) + "  " + std::to_string(p.overruns),
+                             2 + i);
+          }
+        }
+        // Fourth blank page is memory (see memory_monitor.hpp). Stack is the least free in this mode, in bytes
+        else if (ez::as::page_blank_is_on(3)) {
+          memory_state mem = memory_state_get();
+          memory_mode mode = memory_mode_get();
+          ez::screen_print("heap free " + std::to_string(mem.heap.free / 1024) + "K big " + std::to_string(mem.heap.largest / 1024) + "K  lvgl free " +
+                               std::to_string(mem.lvgl.free) + " big " + std::to_string(mem.lvgl.largest),
+                           1);
+          std::string stacks = mem.stack_measurable ? "" : "stack: not measurable";
+          for (int i = 0; i < mem.task_count; i++)
+            stacks += std::string(mem.tasks[i].name) + " " + std::to_string(mem.tasks[i].stack_free[mode]) + (i % 2 ? "\n" : "   ");
+          ez::screen_print(stacks, 2);
+          ez::screen_print(mem.warnings > 0 ? std::string("!! ") + mem.warning : "", 7);
+        }
+        // Fifth blank page is CPU use in this mode (see cpu_usage.hpp), k = kernel task, l = profiled loop
+        else if (ez::as::page_blank_is_on(4)) {
+          cpu_usage_state cpu = cpu_usage_get();
+          memory_mode mode = memory_mode_get();
+          ez::screen_print(cpu.kernel_stats ? "cpu %, IDLE = headroom" : "cpu %, loops only (no kernel stats)", 1);
+          std::string lines;
+          for (int i = 0, shown = 0; i < cpu.count && shown < 12; i++) {
+            double percent = cpu.percent(i, mode);
+            if (percent < 0.1) continue;
+            char line[40];
+            snprintf(line, sizeof(line), "%s%s %.1f", cpu.entries[i].kernel ? "k " : "l ", cpu.entries[i].name, percent);
+            lines += std::string(line) + (shown++ % 2 ? "\n" : "   ");
+          }
+          ez::screen_print(lines, 2);
+        }
+        // Sixth blank page is the parameter table and tuning mode (see param_table.hpp), > is the one the controller is on
+        else if (ez::as::page_blank_is_on(5)) {
+          ez::screen_print(std::string(param_table_editing() ? "tuning  params  (B+A closes)" : "tuning  params  (B+A edits)") + (param_table_dirty() ? "  * not saved" : ""), 1);
+          int selected = param_table_selected();
+          int first = std::max(0, std::min(selected - 3, param_count() - 6));
+          std::string lines;
+          for (int i = first; i < param_count() && i < first + 6; i++)
+            lines += std::string(i == selected ? "> " : "  ") + param_text(i) + "   (" + param_fallback_text(i) + ")\n";
+          ez::screen_print(lines, 2);
+        }
       }
     }
 
@@ -173,6 +347,8 @@ pros::Task ezScreenTask(ez_screen_task);
  *   - to prevent this from accidentally happening at a competition, this
  *     is only enabled when you're not connected to competition control.
  * - gives you a GUI to change your PID values live by pressing X
+ * Only called in tuning mode (the parameter table page on the brain), the lady brown has X, B, A, Y and DOWN
+ * the rest of the time
  */
 void ez_template_extras() {
   // Only run this when not connected to a competition switch
@@ -184,9 +360,17 @@ void ez_template_extras() {
     //  When enabled:
     //  * use A and Y to increment / decrement the constants
     //  * use the arrow keys to navigate the constants
-    if (master.get_digital_new_press(DIGITAL_X))
+    if (master.get_digital_new_press(DIGITAL_X) && !param_table_editing())
       chassis.pid_tuner_toggle();
 
+    // Live parameter table, B + A opens/closes it. See param_table.hpp
+    param_table_iterate();
+    if (param_table_editing()) return;  // it has the arrows, A and Y, keep them away from everything below
+
+    // Telemetry stream on/off, see telemetry.hpp. The PID tuner has Y while it's on
+    if (master.get_digital(DIGITAL_B) && master.get_digital_new_press(DIGITAL_Y) && !chassis.pid_tuner_enabled())
+      telemetry_enable(!telemetry_enabled());
+
     // Trigger the selected autonomous routine
     if (master.get_digital(DIGITAL_B) && master.get_digital(DIGITAL_DOWN)) {
       pros::motor_brake_mode_e_t preference = chassis.drive_brake_get();
@@ -194,8 +378,36 @@ void ez_template_extras() {
       chassis.drive_brake_set(preference);
     }
 
+    // Tracking wheel calibration, see tracker_calibration.hpp
+    if (master.get_digital(DIGITAL_B) && master.get_digital(DIGITAL_UP))
+      tracker_calibrate_diameter();
+    if (master.get_digital(DIGITAL_B) && master.get_digital(DIGITAL_LEFT))
+      tracker_calibrate_spin();
+
+    // Sysid, logs go to the SD card. Fit them with tools/sysid/sysid_fit.py
+    if (master.get_digital(DIGITAL_B) && master.get_digital(DIGITAL_RIGHT))
+      sysid_run_all(SYSID_DRIVE);
+    if (master.get_digital(DIGITAL_B) && master.get_digital(DIGITAL_R1))
+      sysid_run_all(SYSID_INTAKE);
+    if (master.get_digital(DIGITAL_B) && master.get_digital(DIGITAL_L1))
+      sysid_run_all(SYSID_LB);
+
+    // Loop timing + memory + CPU stats to the terminal + SD card, see loop_profiler.hpp, memory_monitor.hpp and cpu_usage.hpp
+    if (master.get_digital(DIGITAL_B) && master.get_digital_new_press(DIGITAL_L2)) {
+      loop_profile_print();
+      loop_profile_save();
+      memory_monitor_print();
+      memory_monitor_save();
+      cpu_usage_print();
+      cpu_usage_save();
+      param_table_print();
+    }
+
     // Allow PID Tuner to iterate
     chassis.pid_tuner_iterate();
+
+    // Relay auto-tuner, only while the PID tuner is on. R2 picks the loop, L2 runs it. See pid_autotune.hpp
+    pid_autotune_iterate();
   }
 
   // Disable PID Tuner when connected to a comp switch
@@ -220,6 +432,11 @@ void ez_template_extras() {
  */
 //DRIVER CONTROL CODE HERE
 void opcontrol() {
+  trace_enable(false);  // the auton gets killed when the period ends, before it can close the trace itself
+  // Driving needs pistons and the joystick curves. The drive itself is held still until the IMU is done below,
+  // moving the robot while it calibrates ruins the calibration. Everything else works right away
+  startup_wait(STARTUP_ADI | STARTUP_SD);
+
   // This is preference to what you like to drive on. I suggest no touch
   chassis.drive_brake_set(MOTOR_BRAKE_COAST);
   // Configure your motor brake modes. Feel free to alter
@@ -239,11 +456,30 @@ void opcontrol() {
   // controller task
   pros::Task controllerTask(tempDisplay);  // start the controller task
   //^Run as a task because of the slow update time (controller can only update every 50 ms)
+  // measures stick -> motor latency, see joystick_lut.hpp. It polls at 1 kHz, so only when asked for and never in a match
+  if (JOYSTICK_LATENCY_MEASURE && !pros::competition::is_connected()) pros::Task latencyTask(joystick_latency_task);
+  traction_control_enable(false);  // true = traction + launch control on the drive, see traction_control.hpp
   controller.clear(); //clears controller screen to let display run
   currState = 0; //this sets index to 0
   target = states[currState]; //this actually tells the lady brown to move to stowed
+  int loop = loop_profile_register("opcontrol", ez::util::DELAY_TIME);  // timing stats, see loop_profiler.hpp
+  int memory = memory_monitor_register("opcontrol");  // stack high-water mark, see memory_monitor.hpp
   while (true) {
-    chassis.opcontrol_arcade_standard(ez::SPLIT);  // Split Arcade
+    loop_profile_start(loop);
+    memory_monitor_sample(memory);
+    // Tuning mode is the parameter table page on the brain, off a comp switch only (see param_table.hpp).
+    // The extras (PID tuner, parameter table, test routines) only get the controller then, the arm, pistons
+    // and intake ignore it until the brain leaves that page. The PID tuner covers the brain, so it stays on until X
+    param_table_tuning_set(!pros::competition::is_connected() && (chassis.pid_tuner_enabled() || ez::as::page_blank_is_on(5)));
+    if (param_table_tuning())
+      ez_template_extras();
+    else if (chassis.pid_tuner_enabled())
+      chassis.pid_tuner_disable();
+    if (startup_ready(STARTUP_IMU))
+      opcontrol_lut_arcade(ez::SPLIT);  // Split Arcade, joystick curve from a lookup table (joystick_lut.hpp)
+    else
+      chassis.drive_set(0, 0);  // IMU still calibrating
+    // chassis.opcontrol_arcade_standard(ez::SPLIT);  // Split Arcade, computes the curve every loop
     //These next 2 lines are controller options 
     // chassis.opcontrol_tank(); //Tank Control
     // chassis.opcontrol_arcade_standard(ez::SINGLE);  // Single Stick Arcade
@@ -255,6 +491,7 @@ void opcontrol() {
     // piston driver code
     pneumaticDriverControl(); //This is not run as tasks because they do not need their own timescale
 
+    loop_profile_end(loop);
     pros::delay(ez::util::DELAY_TIME);  // This is used for timer calculations!  Keep this ez::util::DELAY_TIME
   }
 }
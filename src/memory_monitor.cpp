@@ -0,0 +1,172 @@
+#include "memory_monitor.hpp"
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "liblvgl/lvgl.h"
+
+// The stack high-water mark comes from the FreeRTOS kernel under PROS, which doesn't put it in the public
+// headers (and has had it under both names). Weak, so it still links on a kernel without either of them and the
+// stacks just show up as not measurable
+extern "C" {
+__attribute__((weak)) std::uint32_t task_get_stack_high_water_mark(void *task);
+__attribute__((weak)) std::uint32_t uxTaskGetStackHighWaterMark(void *task);
+extern char _heap_end;  // end of the heap, from firmware/v5-common.ld
+}
+
+memory_state memoryState;
+std::uint32_t memorySampleTime[MEMORY_TASKS_MAX] = {};
+pros::Mutex memoryMutex;
+const char *memoryModeNames[MEMORY_MODES] = {"disabled", "auton", "driver"};
+
+// LVGL's pool gets walked to measure it, and LVGL isn't thread safe. So it gets measured by an lv_timer, which
+// runs inside LVGL's own task between screen updates, and memory_monitor_task picks up the latest reading
+lv_mem_monitor_t memoryLvgl = {};
+bool memoryLvglFresh = false;
+
+void memoryLvglTimer(lv_timer_t *) {
+  lv_mem_monitor_t reading = {};
+  lv_mem_monitor(&reading);
+  memoryMutex.take();
+  memoryLvgl = reading;
+  memoryLvglFresh = true;
+  memoryMutex.give();
+}
+
+// least free stack the calling task has ever had, in bytes. -1 if the kernel can't say
+int memoryStackFree() {
+  if (task_get_stack_high_water_mark != nullptr) return task_get_stack_high_water_mark(nullptr) * 4;  // words -> bytes
+  if (uxTaskGetStackHighWaterMark != nullptr) return uxTaskGetStackHighWaterMark(nullptr) * 4;
+  return -1;
+}
+
+// call with memoryMutex taken
+void memoryWarn(const char *what, memory_mode mode, int left) {
+  snprintf(memoryState.warning, sizeof(memoryState.warning), "%s %s: %d B left", what, memoryModeNames[mode], left);
+  memoryState.warnings++;
+  printf("memory: %s\n", memoryState.warning);
+}
+
+memory_mode memory_mode_get() {
+  if (pros::competition::is_disabled()) return MEMORY_DISABLED;
+  if (pros::competition::is_autonomous()) return MEMORY_AUTON;
+  return MEMORY_DRIVER;
+}
+
+int memory_monitor_register(const char *name, int stack_bytes) {
+  memoryMutex.take();
+  int id = -1;
+  for (int i = 0; i < memoryState.task_count; i++)
+    if (std::strcmp(memoryState.tasks[i].name, name) == 0) id = i;
+  if (id < 0 && memoryState.task_count < MEMORY_TASKS_MAX) {
+    id = memoryState.task_count++;
+    memoryState.tasks[id].name = name;
+  }
+  if (id >= 0) {
+    memoryState.tasks[id].stack_size = stack_bytes;
+    memorySampleTime[id] = 0;  // a new task under an old name, measure it right away
+  }
+  memoryMutex.give();
+  return id;
+}
+
+void memory_monitor_sample(int id) {
+  if (id < 0) return;
+  std::uint32_t now = pros::millis();
+  if (memorySampleTime[id] != 0 && now - memorySampleTime[id] < MEMORY_SAMPLE_TIME) return;
+  memorySampleTime[id] = now == 0 ? 1 : now;
+
+  int left = memoryStackFree();
+  if (left < 0) return;
+  memory_mode mode = memory_mode_get();
+  memoryMutex.take();
+  memory_task_state &t = memoryState.tasks[id];
+  memoryState.stack_measurable = true;
+  t.stack_free[mode] = memory_min(t.stack_free[mode], left);
+  if (left < MEMORY_STACK_MARGIN && !t.warned[mode]) {
+    t.warned[mode] = true;
+    memoryWarn(t.name, mode, left);
+  }
+  memoryMutex.give();
+}
+
+memory_state memory_state_get() {
+  memoryMutex.take();
+  memory_state s = memoryState;
+  memoryMutex.give();
+  return s;
+}
+
+// call with memoryMutex taken. Warns once per mode when free drops under margin
+void memoryPoolUpdate(memory_pool_state &pool, const char *name, memory_mode mode, int margin, bool warned[]) {
+  pool.free_min[mode] = memory_min(pool.free_min[mode], pool.free);
+  pool.largest_min[mode] = memory_min(pool.largest_min[mode], pool.largest);
+  if (pool.free < margin && !warned[mode]) {
+    warned[mode] = true;
+    memoryWarn(name, mode, pool.free);
+  }
+}
+
+void memory_monitor_task() {
+  bool heapWarned[MEMORY_MODES] = {}, lvglWarned[MEMORY_MODES] = {};
+  lv_timer_create(memoryLvglTimer, MEMORY_SAMPLE_TIME, nullptr);  // made once at startup, like the screens
+  while (true) {
+    memory_mode mode = memory_mode_get();
+
+    // newlib only knows about the part of the heap it has grabbed so far (the arena). Everything between the
+    // top of the arena and the end of the heap is free too, and joins onto the free chunk at the top
+    struct mallinfo info = mallinfo();
+    int untouched = &_heap_end - (char *)sbrk(0);
+
+    memoryMutex.take();
+    memory_pool_state &heap = memoryState.heap;
+    heap.used = info.uordblks;
+    heap.free = info.fordblks + untouched;
+    heap.largest = info.keepcost + untouched;  // holes inside the arena aren't counted, they only matter once the top is gone
+    memoryPoolUpdate(heap, "heap", mode, MEMORY_HEAP_MARGIN, heapWarned);
+    if (memoryLvglFresh) {
+      memory_pool_state &pool = memoryState.lvgl;
+      pool.used = memoryLvgl.total_size - memoryLvgl.free_size;
+      pool.free = memoryLvgl.free_size;
+      pool.largest = memoryLvgl.free_biggest_size;
+      memoryLvglFresh = false;
+      memoryPoolUpdate(pool, "lvgl", mode, MEMORY_LVGL_MARGIN, lvglWarned);
+    }
+    memoryMutex.give();
+
+    pros::delay(MEMORY_SAMPLE_TIME);
+  }
+}
+
+void memory_monitor_print() {
+  memory_state s = memory_state_get();
+  printf("%-14s %7s  %-26s\n", "task", "stack", "least free: disabled/auton/driver");
+  for (int i = 0; i < s.task_count; i++)
+    printf("%-14s %7d  %8d %8d %8d\n", s.tasks[i].name, s.tasks[i].stack_size, s.tasks[i].stack_free[0], s.tasks[i].stack_free[1], s.tasks[i].stack_free[2]);
+  if (!s.stack_measurable) printf("(no stack high-water mark on this kernel, stacks aren't measured)\n");
+  for (memory_pool_state *pool : {&s.heap, &s.lvgl}) {
+    printf("%-5s used %d free %d largest %d | least free %d/%d/%d | least largest %d/%d/%d\n", pool == &s.heap ? "heap" : "lvgl",
+           pool->used, pool->free, pool->largest, pool->free_min[0], pool->free_min[1], pool->free_min[2],
+           pool->largest_min[0], pool->largest_min[1], pool->largest_min[2]);
+  }
+  printf("%d warnings%s%s\n", s.warnings, s.warnings > 0 ? ", last: " : "", s.warning);
+}
+
+bool memory_monitor_save() {
+  if (!ez::util::SD_CARD_ACTIVE) return false;
+  FILE *file = fopen("/usd/memory_monitor.csv", "w");
+  if (file == nullptr) return false;
+  memory_state s = memory_state_get();
+  // one row per thing, -1 = never measured in that mode
+  fprintf(file, "name,size,free_disabled,free_auton,free_driver,largest_disabled,largest_auton,largest_driver\n");
+  for (int i = 0; i < s.task_count; i++)
+    fprintf(file, "%s,%d,%d,%d,%d,,,\n", s.tasks[i].name, s.tasks[i].stack_size, s.tasks[i].stack_free[0], s.tasks[i].stack_free[1], s.tasks[i].stack_free[2]);
+  fprintf(file, "heap,%d,%d,%d,%d,%d,%d,%d\n", s.heap.used + s.heap.free, s.heap.free_min[0], s.heap.free_min[1], s.heap.free_min[2],
+          s.heap.largest_min[0], s.heap.largest_min[1], s.heap.largest_min[2]);
+  fprintf(file, "lvgl,%d,%d,%d,%d,%d,%d,%d\n", s.lvgl.used + s.lvgl.free, s.lvgl.free_min[0], s.lvgl.free_min[1], s.lvgl.free_min[2],
+          s.lvgl.largest_min[0], s.lvgl.largest_min[1], s.lvgl.largest_min[2]);
+  fclose(file);
+  return true;
+}
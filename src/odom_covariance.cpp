@@ -0,0 +1,176 @@
+#include "odom_covariance.hpp"
+
+#include "subsystems.hpp"
+
+// EZ-Template does the actual odometry, this just follows along and tracks how much we should trust it.
+// Every tick the pose change gets split into forward/sideways/turn, and each piece adds variance based on
+// which sensor measured it (tracking wheels > drive motors). Standard EKF style prediction step:
+//   cov = F * cov * F^T + G * Q * G^T
+
+pros::Mutex covarianceMutex;            // the task writes, autons/screen read
+pose_covariance covariance;             // theta terms are stored in radians internally, converted on the way out
+odom_noise_model noiseModel;            // current noise model
+bool covarianceResetRequested = true;  // starts true so the first tick seeds the covariance
+
+// how far the pose can jump in one tick past what the sensors saw before we call it an odom_xyt_set
+const double POSE_JUMP_XY = 2.0;      // inches
+const double POSE_JUMP_THETA = 10.0;  // degrees
+
+// vertical travel in inches, uses tracking wheels when we have them and the drive motors when we don't
+double verticalSensorGet(bool &usingTrackers) {
+  ez::tracking_wheel *left = chassis.odom_tracker_left;
+  ez::tracking_wheel *right = chassis.odom_tracker_right;
+  usingTrackers = left != nullptr || right != nullptr;
+  if (left != nullptr && right != nullptr) return (left->get() + right->get()) / 2.0;
+  if (left != nullptr) return left->get();
+  if (right != nullptr) return right->get();
+  return (chassis.drive_sensor_left() + chassis.drive_sensor_right()) / 2.0;
+}
+
+// horizontal travel in inches, only exists if there's a horizontal tracking wheel
+bool horizontalTrackerExists() {
+  return chassis.odom_tracker_front != nullptr || chassis.odom_tracker_back != nullptr;
+}
+
+void covarianceSetLocked(double sigmaXY, double sigmaTheta) {
+  double thetaRad = ez::util::to_rad(sigmaTheta);
+  covariance = pose_covariance();
+  covariance.xx = sigmaXY * sigmaXY;
+  covariance.yy = sigmaXY * sigmaXY;
+  covariance.tt = thetaRad * thetaRad;
+}
+
+// one prediction step. forward/lateral are in inches and split at the middle of the step, theta is the heading
+// at the start of the step and dTheta how far it turned, both in radians
+void covariancePredictLocked(double theta, double forward, double lateral, double dTheta, double varForward, double varLateral, double varTheta) {
+  // the move happened along the mid-step heading, so that's where both Jacobians get taken
+  double thetaMid = theta + dTheta / 2.0;
+  double s = std::sin(thetaMid);
+  double c = std::cos(thetaMid);
+
+  // F = d(new pose)/d(old pose) -> only theta couples into x/y
+  double fxt = forward * c - lateral * s;
+  double fyt = -forward * s - lateral * c;
+
+  // F * cov * F^T written out since it's tiny and symmetric
+  pose_covariance p = covariance;
+  pose_covariance n;
+  n.xx = p.xx + 2.0 * fxt * p.xt + fxt * fxt * p.tt;
+  n.xy = p.xy + fyt * p.xt + fxt * p.yt + fxt * fyt * p.tt;
+  n.xt = p.xt + fxt * p.tt;
+  n.yy = p.yy + 2.0 * fyt * p.yt + fyt * fyt * p.tt;
+  n.yt = p.yt + fyt * p.tt;
+  n.tt = p.tt;
+
+  // G * Q * G^T, G rotates robot frame (forward, lateral) into field frame
+  n.xx += s * s * varForward + c * c * varLateral;
+  n.xy += s * c * varForward - s * c * varLateral;
+  n.yy += c * c * varForward + s * s * varLateral;
+  n.tt += varTheta;
+
+  covariance = n;
+}
+
+void odom_covariance_task() {
+  bool usingTrackers = false;
+  ez::pose lastPose = chassis.odom_pose_get();
+  double lastVertical = verticalSensorGet(usingTrackers);
+  double lastImu = chassis.drive_imu_get();
+  int lastTime = pros::millis();
+
+  while (true) {
+    ez::pose pose = chassis.odom_pose_get();
+    double vertical = verticalSensorGet(usingTrackers);
+    double imu = chassis.drive_imu_get();
+    int now = pros::millis();
+    double dt = (now - lastTime) / 1000.0;
+
+    double dx = pose.x - lastPose.x;
+    double dy = pose.y - lastPose.y;
+    double dThetaDeg = ez::util::wrap_angle(pose.theta - lastPose.theta);
+    double dVertical = vertical - lastVertical;
+    double dImu = imu - lastImu;
+
+    // sensors getting zeroed (drive_sensor_reset) look like a huge jump, skip that tick
+    bool sensorsReset = std::fabs(dVertical) > 10.0 || std::fabs(dImu) > 45.0;
+    // odom getting set (odom_xyt_set) moves the pose way more than the sensors moved
+    bool poseSet = std::hypot(dx, dy) > std::fabs(dVertical) + POSE_JUMP_XY ||
+                   std::fabs(dThetaDeg - dImu) > POSE_JUMP_THETA;
+
+    covarianceMutex.take();
+    if (covarianceResetRequested || (poseSet && !sensorsReset)) {
+      covarianceSetLocked(noiseModel.reset_sigma_xy, noiseModel.reset_sigma_theta);
+      covarianceResetRequested = false;
+    } else if (!sensorsReset) {
+      // split the move into the robot's frame at the middle of the step
+      double thetaMid = ez::util::to_rad(lastPose.theta + dThetaDeg / 2.0);
+      double forward = dx * std::sin(thetaMid) + dy * std::cos(thetaMid);
+      double lateral = dx * std::cos(thetaMid) - dy * std::sin(thetaMid);
+
+      double travel = std::fabs(forward) + std::fabs(lateral);
+      double varForward = (usingTrackers ? noiseModel.tracker_var_per_in : noiseModel.ime_var_per_in) * std::fabs(forward);
+      double varLateral = horizontalTrackerExists() ? noiseModel.tracker_var_per_in * std::fabs(lateral)
+                                                    : noiseModel.ime_lateral_var_per_in * travel;
+      double varThetaDeg = noiseModel.imu_var_per_deg * std::fabs(dImu) + noiseModel.imu_drift_var_per_sec * dt;
+      double varTheta = varThetaDeg * std::pow(ez::util::to_rad(1.0), 2);
+
+      covariancePredictLocked(ez::util::to_rad(lastPose.theta), forward, lateral, ez::util::to_rad(dThetaDeg), varForward, varLateral, varTheta);
+    }
+    covarianceMutex.give();
+
+    lastPose = pose;
+    lastVertical = vertical;
+    lastImu = imu;
+    lastTime = now;
+    pros::delay(ez::util::DELAY_TIME);
+  }
+}
+
+pose_covariance odom_covariance_get() {
+  covarianceMutex.take();
+  pose_covariance out = covariance;
+  covarianceMutex.give();
+
+  // convert the theta terms back into degrees
+  double degPerRad = ez::util::to_deg(1.0);
+  out.xt *= degPerRad;
+  out.yt *= degPerRad;
+  out.tt *= degPerRad * degPerRad;
+  return out;
+}
+
+void odom_covariance_reset() {
+  odom_covariance_reset(noiseModel.reset_sigma_xy, noiseModel.reset_sigma_theta);
+}
+
+void odom_covariance_reset(double sigma_xy, double sigma_theta) {
+  covarianceMutex.take();
+  covarianceSetLocked(sigma_xy, sigma_theta);
+  covarianceResetRequested = false;
+  covarianceMutex.give();
+}
+
+// biggest eigenvalue of the x/y block -> the long axis of the uncertainty ellipse
+double odom_xy_sigma_get() {
+  pose_covariance c = odom_covariance_get();
+  double mid = (c.xx + c.yy) / 2.0;
+  double spread = std::sqrt(std::pow((c.xx - c.yy) / 2.0, 2) + c.xy * c.xy);
+  return std::sqrt(std::max(mid + spread, 0.0));
+}
+
+double odom_theta_sigma_get() {
+  return std::sqrt(std::max(odom_covariance_get().tt, 0.0));
+}
+
+void odom_noise_model_set(odom_noise_model model) {
+  covarianceMutex.take();
+  noiseModel = model;
+  covarianceMutex.give();
+}
+
+odom_noise_model odom_noise_model_get() {
+  covarianceMutex.take();
+  odom_noise_model out = noiseModel;
+  covarianceMutex.give();
+  return out;
+}
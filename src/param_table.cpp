@@ -0,0 +1,213 @@
+#include "param_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "subsystems.hpp"
+
+std::vector<param_entry> params;
+bool paramDirty = false;
+
+bool paramTuning = false;
+bool paramEditing = false;
+int paramSelected = 0;
+std::string paramShown;          // what's on the controller's bottom line right now
+std::uint32_t paramShownAt = 0;  // when it last got sent, the controller takes one line per 50 ms
+
+double paramRead(const param_entry &p) {
+  return p.type == PARAM_INT ? *static_cast<int *>(p.value) : *static_cast<double *>(p.value);
+}
+
+// clamps + stores it, true if that changed anything
+bool paramWrite(param_entry &p, double value) {
+  value = std::clamp(value, p.min, p.max);
+  if (p.type == PARAM_INT) value = std::round(value);
+  if (value == paramRead(p)) return false;
+  if (p.type == PARAM_INT)
+    *static_cast<int *>(p.value) = static_cast<int>(value);
+  else
+    *static_cast<double *>(p.value) = value;
+  return true;
+}
+
+int paramAdd(const char *name, param_type type, void *value, double min, double max, double step, void (*apply)()) {
+  param_entry p = {name, type, value, min, max, step, 0.0, apply, param_hash(name)};
+  p.fallback = paramRead(p);
+  if (std::strlen(name) > PARAM_NAME_MAX) printf("param %s: name is over %d characters, it'll get cut off on the controller\n", name, PARAM_NAME_MAX);
+  if (param_find(name) >= 0) printf("param %s: registered twice, the file will only ever find the first one\n", name);
+  params.push_back(p);
+  return params.size() - 1;
+}
+
+int param_add(const char *name, int *value, int min, int max, int step, void (*apply)()) { return paramAdd(name, PARAM_INT, value, min, max, step, apply); }
+int param_add(const char *name, double *value, double min, double max, double step, void (*apply)()) { return paramAdd(name, PARAM_DOUBLE, value, min, max, step, apply); }
+
+int param_count() { return params.size(); }
+const param_entry &param_get_entry(int index) { return params[index]; }
+
+int paramFindHash(std::uint32_t hash) {
+  for (int i = 0; i < (int)params.size(); i++)
+    if (params[i].hash == hash) return i;
+  return -1;
+}
+int param_find(const char *name) { return paramFindHash(param_hash(name)); }
+
+double param_get(int index) {
+  if (index < 0 || index >= (int)params.size()) return 0.0;
+  return paramRead(params[index]);
+}
+
+bool param_set(int index, double value) {
+  if (index < 0 || index >= (int)params.size()) return false;
+  if (paramWrite(params[index], value)) {
+    paramDirty = true;
+    if (params[index].apply != nullptr) params[index].apply();
+  }
+  return true;
+}
+
+// runs every apply once after a lot of values changed at the same time
+void paramApplyAll(const std::vector<bool> &changed) {
+  std::vector<void (*)()> applied;
+  for (int i = 0; i < (int)params.size(); i++) {
+    void (*apply)() = params[i].apply;
+    if (!changed[i] || apply == nullptr || std::find(applied.begin(), applied.end(), apply) != applied.end()) continue;
+    apply();
+    applied.push_back(apply);
+  }
+}
+
+void param_table_reset() {
+  std::vector<bool> changed(params.size());
+  for (int i = 0; i < (int)params.size(); i++) changed[i] = paramWrite(params[i], params[i].fallback);
+  paramApplyAll(changed);
+  paramDirty = true;
+}
+
+bool param_table_load() {
+  if (!ez::util::SD_CARD_ACTIVE) return false;
+  FILE *file = fopen(PARAM_TABLE_FILE.c_str(), "rb");
+  if (file == nullptr) return false;
+
+  param_file_header header;
+  std::vector<param_record> records;
+  bool ok = fread(&header, sizeof(header), 1, file) == 1 && std::memcmp(header.magic, "PRM1", 4) == 0;
+  if (ok) {
+    records.resize(header.count);
+    ok = fread(records.data(), sizeof(param_record), header.count, file) == header.count &&
+         param_hash(records.data(), records.size() * sizeof(param_record)) == header.check;
+  }
+  fclose(file);
+  if (!ok) {
+    printf("%s is damaged, using the compiled-in parameters\n", PARAM_TABLE_FILE.c_str());
+    return false;
+  }
+
+  std::vector<bool> changed(params.size());
+  int loaded = 0;
+  for (int i = 0; i < (int)records.size(); i++) {
+    const param_record &r = records[i];
+    // same spot as when it was saved unless parameters got added/removed since
+    int index = i < (int)params.size() && params[i].hash == r.hash ? i : paramFindHash(r.hash);
+    if (index < 0 || params[index].type != r.type) continue;
+    changed[index] = paramWrite(params[index], r.value) || changed[index];
+    loaded++;
+  }
+  paramApplyAll(changed);
+  paramDirty = false;
+  printf("Loaded %d of %d parameters from %s\n", loaded, (int)params.size(), PARAM_TABLE_FILE.c_str());
+  return true;
+}
+
+bool param_table_save() {
+  if (!ez::util::SD_CARD_ACTIVE) return false;
+  std::vector<param_record> records(params.size());
+  for (int i = 0; i < (int)params.size(); i++) {
+    records[i] = {};
+    records[i].hash = params[i].hash;
+    records[i].type = params[i].type;
+    records[i].value = paramRead(params[i]);
+  }
+  param_file_header header = {{'P', 'R', 'M', '1'}, (std::uint16_t)records.size(), 0, param_hash(records.data(), records.size() * sizeof(param_record))};
+
+  FILE *file = fopen(PARAM_TABLE_FILE.c_str(), "wb");
+  if (file == nullptr) return false;
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(records.data(), sizeof(param_record), records.size(), file) == records.size();
+  fclose(file);
+  if (ok) paramDirty = false;
+  return ok;
+}
+
+bool param_table_dirty() { return paramDirty; }
+
+// as many decimals as the step needs
+std::string paramFormat(const param_entry &p, double value) {
+  if (p.type == PARAM_INT) return std::to_string((int)value);
+  int decimals = std::clamp((int)std::ceil(-std::log10(p.step) - 1e-9), 0, 3);
+  return ez::util::to_string_with_precision(value, decimals);
+}
+
+std::string param_text(int index) {
+  if (index < 0 || index >= (int)params.size()) return "";
+  const param_entry &p = params[index];
+  return std::string(p.name).substr(0, PARAM_NAME_MAX) + " " + paramFormat(p, paramRead(p));
+}
+
+std::string param_fallback_text(int index) {
+  if (index < 0 || index >= (int)params.size()) return "";
+  return paramFormat(params[index], params[index].fallback);
+}
+
+void param_table_print() {
+  printf("\n%-12s %12s %12s\n", "parameter", "value", "compiled in");
+  for (const param_entry &p : params)
+    printf("%-12s %12s %12s%s\n", p.name, paramFormat(p, paramRead(p)).c_str(), paramFormat(p, p.fallback).c_str(), paramRead(p) != p.fallback ? "  <-" : "");
+  printf("%s\n", paramDirty ? "(not saved)" : "");
+}
+
+bool param_table_editing() { return paramEditing; }
+bool param_table_tuning() { return paramTuning; }
+
+void param_table_tuning_set(bool tuning) {
+  if (tuning == paramTuning) return;
+  paramTuning = tuning;
+  if (!tuning && paramEditing) {
+    paramEditing = false;
+    paramShown = "                   ";
+    controller.set_text(2, 0, paramShown);
+  }
+}
+int param_table_selected() { return paramSelected; }
+
+void param_table_iterate() {
+  if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_B) && controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A)) {
+    paramEditing = !paramEditing;
+    if (paramEditing && chassis.pid_tuner_enabled()) chassis.pid_tuner_disable();  // both of them use the arrows + A/Y
+    paramShown = paramEditing ? "" : "                   ";  // closing blanks the bottom line
+    if (!paramEditing) controller.set_text(2, 0, paramShown);
+    return;
+  }
+  if (!paramEditing || params.empty()) return;
+
+  int count = params.size();
+  if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_DOWN)) paramSelected = (paramSelected + 1) % count;
+  if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_UP)) paramSelected = (paramSelected - 1 + count) % count;
+  const param_entry &p = params[paramSelected];
+  if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_RIGHT)) param_set(paramSelected, paramRead(p) + p.step);
+  if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_LEFT)) param_set(paramSelected, paramRead(p) - p.step);
+  if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_Y)) param_set(paramSelected, p.fallback);
+  if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A) && !param_table_save()) {
+    controller.rumble("-");  // no SD card
+    paramShownAt = pros::millis();
+  }
+
+  // bottom line only, tempDisplay() has the other two
+  std::string text = param_text(paramSelected) + (paramDirty ? "*" : "");
+  text.resize(19, ' ');
+  if (text != paramShown && pros::millis() - paramShownAt >= 50) {
+    if (controller.set_text(2, 0, text) == 1) paramShown = text;
+    paramShownAt = pros::millis();
+  }
+}
@@ -0,0 +1,261 @@
+#include "pid_autotune.hpp"
+
+#include "autons.hpp"
+#include "subsystems.hpp"
+
+// Per loop settings. relay is in whatever the loop outputs (drive speed out of 127, lady brown mV),
+// hysteresis/step in whatever it measures (degrees, inches, lady brown centidegrees)
+struct autotuneConfig {
+  const char *name;
+  double relay;       // bang-bang output size
+  double hysteresis;  // dead band so sensor noise doesn't flip the relay
+  double step;        // size of the scored step moves
+  int speed;          // max speed for the scored step moves
+  int dtMs;           // how often that loop's PID runs
+};
+autotuneConfig autotuneConfigs[4] = {
+    {"turn", 50, 0.5, 90, 90, ez::util::DELAY_TIME},
+    {"drive", 40, 0.1, 24, 110, ez::util::DELAY_TIME},
+    {"swing", 60, 0.5, 90, 110, ez::util::DELAY_TIME},
+    {"lb", 4000, 50, 0, 0, 20},  // armDriver runs every 20 ms, the step is states[1] -> states[2]
+};
+
+const int AUTOTUNE_SKIP_CYCLES = 2;  // first couple of wobbles are still settling in, ignore them
+const int AUTOTUNE_CYCLES = 4;       // wobbles that get averaged
+const int AUTOTUNE_RELAY_TIMEOUT = 15000;
+const int AUTOTUNE_STEP_WINDOW = 2000;      // ms each scored step gets measured for
+const double AUTOTUNE_OVERSHOOT_WEIGHT = 4.0;  // how much overshoot hurts compared to being slow
+int autotuneSelected = AUTOTUNE_TURN;
+
+double autotuneMeasure(autotune_loop loop) {
+  if (loop == AUTOTUNE_DRIVE) return (chassis.drive_sensor_left() + chassis.drive_sensor_right()) / 2.0;
+  if (loop == AUTOTUNE_LB) return lbSensor.get_position();
+  return chassis.drive_imu_get();
+}
+
+void autotuneOutput(autotune_loop loop, double out) {
+  if (loop == AUTOTUNE_TURN)
+    chassis.drive_set(out, -out);
+  else if (loop == AUTOTUNE_DRIVE)
+    chassis.drive_set(out, out);
+  else if (loop == AUTOTUNE_SWING)
+    chassis.drive_set(out, 0);  // left swing
+  else
+    lb.move_voltage(out);
+}
+
+autotune_gains autotuneGainsGet(autotune_loop loop) {
+  autotune_gains g;
+  if (loop == AUTOTUNE_LB) {
+    g.kp = kP;
+    g.ki = kI;
+    g.kd = kD;
+    return g;
+  }
+  ez::PID::Constants c = loop == AUTOTUNE_TURN ? chassis.turnPID.constants_get() : loop == AUTOTUNE_DRIVE ? chassis.fwd_rev_drivePID.constants_get()
+                                                                                                          : chassis.fwd_rev_swingPID.constants_get();
+  g.kp = c.kp;
+  g.ki = c.ki;
+  g.kd = c.kd;
+  g.start_i = c.start_i;
+  return g;
+}
+
+void autotuneGainsSet(autotune_loop loop, const autotune_gains &g) {
+  if (loop == AUTOTUNE_LB) {
+    kP = g.kp;
+    kI = g.ki;
+    kD = g.kd;
+    return;
+  }
+  // through the parameter table's copies (param_table.hpp), so they show up there and get saved with it
+  if (loop == AUTOTUNE_TURN)
+    turnConstants = {g.kp, g.ki, g.kd, g.start_i};
+  else if (loop == AUTOTUNE_DRIVE)
+    driveConstants = {g.kp, g.ki, g.kd, g.start_i};
+  else
+    swingConstants = {g.kp, g.ki, g.kd, g.start_i};
+  chassis_constants_apply();
+}
+
+relay_result pid_autotune_relay(autotune_loop loop) {
+  autotuneConfig c = autotuneConfigs[loop];
+  relay_result result;
+
+  if (loop == AUTOTUNE_LB) {
+    // wobble around the middle state, stowed is a hard stop
+    target = states[1];
+    pros::delay(1000);
+    lbOverride = true;
+  } else {
+    chassis.drive_mode_set(ez::DISABLE);  // EZ-Template leaves the motors alone, we write them directly
+  }
+
+  double setpoint = autotuneMeasure(loop);
+  double sign = 1.0;
+  double high = setpoint, low = setpoint;
+  int lastRise = -1;
+  int start = pros::millis();
+  std::vector<double> periods, amplitudes;
+
+  while ((int)periods.size() < AUTOTUNE_SKIP_CYCLES + AUTOTUNE_CYCLES && (int)(pros::millis() - start) < AUTOTUNE_RELAY_TIMEOUT) {
+    int now = pros::millis() - start;
+    double pv = autotuneMeasure(loop);
+    double error = setpoint - pv;
+    high = std::max(high, pv);
+    low = std::min(low, pv);
+
+    if (error > c.hysteresis && sign < 0) {
+      // relay flipped back to +, that's one full cycle since the last time it did this
+      sign = 1.0;
+      if (lastRise >= 0) {
+        periods.push_back((now - lastRise) / 1000.0);
+        amplitudes.push_back((high - low) / 2.0);
+      }
+      lastRise = now;
+      high = low = pv;
+    } else if (error < -c.hysteresis && sign > 0) {
+      sign = -1.0;
+    }
+    autotuneOutput(loop, sign * c.relay);
+    pros::delay(c.dtMs);
+  }
+  autotuneOutput(loop, 0);
+  if (loop == AUTOTUNE_LB) {
+    target = lbSensor.get_position();
+    lbOverride = false;
+  }
+
+  if ((int)periods.size() < AUTOTUNE_SKIP_CYCLES + AUTOTUNE_CYCLES) {
+    printf("autotune %s: relay never oscillated (%d cycles), try a bigger relay amplitude\n", c.name, (int)periods.size());
+    return result;
+  }
+
+  double tu = 0.0, a = 0.0;
+  for (int i = AUTOTUNE_SKIP_CYCLES; i < (int)periods.size(); i++) {
+    tu += periods[i];
+    a += amplitudes[i];
+  }
+  tu /= AUTOTUNE_CYCLES;
+  a /= AUTOTUNE_CYCLES;
+  // a steady oscillation has every period close to the average, if not something was slipping/hitting
+  result.ok = true;
+  for (int i = AUTOTUNE_SKIP_CYCLES; i < (int)periods.size(); i++)
+    if (std::fabs(periods[i] - tu) > 0.25 * tu) result.ok = false;
+
+  result.tu = tu;
+  result.amplitude = a;
+  result.ku = relay_ultimate_gain(c.relay, a, c.hysteresis);
+  result.cycles = AUTOTUNE_CYCLES;
+  if (result.ku <= 0.0) result.ok = false;
+  printf("autotune %s: Ku %.4f Tu %.3fs (amplitude %.3f)%s\n", c.name, result.ku, result.tu, result.amplitude, result.ok ? "" : " NOT STEADY");
+  return result;
+}
+
+// error of whatever motion the step is running right now
+double autotuneStepError(autotune_loop loop) {
+  if (loop == AUTOTUNE_TURN) return chassis.turnPID.error;
+  if (loop == AUTOTUNE_SWING) return chassis.swingPID.error;
+  if (loop == AUTOTUNE_DRIVE) return (chassis.leftPID.error + chassis.rightPID.error) / 2.0;
+  return target - lbSensor.get_position();
+}
+
+double pid_autotune_score(autotune_loop loop, const autotune_gains &gains) {
+  autotuneConfig c = autotuneConfigs[loop];
+  autotuneGainsSet(loop, gains);
+  double score = 0.0;
+
+  // out and back, so the robot ends up where it started
+  for (int direction : {1, -1}) {
+    double size = c.step;
+    if (loop == AUTOTUNE_TURN)
+      chassis.pid_turn_relative_set(c.step * direction, c.speed);
+    else if (loop == AUTOTUNE_DRIVE)
+      chassis.pid_drive_set(c.step * direction, c.speed);
+    else if (loop == AUTOTUNE_SWING)
+      chassis.pid_swing_relative_set(ez::LEFT_SWING, c.step * direction, c.speed);
+    else {
+      size = states[2] - states[1];
+      target = direction > 0 ? states[2] : states[1];
+    }
+
+    // ITAE (time weighted error, punishes being slow AND oscillating late) + worst overshoot
+    double itae = 0.0, overshoot = 0.0;
+    for (int t = 0; t < AUTOTUNE_STEP_WINDOW; t += c.dtMs) {
+      double error = autotuneStepError(loop);
+      itae += (t / 1000.0) * std::fabs(error) * (c.dtMs / 1000.0);
+      if (error * direction < 0) overshoot = std::max(overshoot, std::fabs(error));
+      pros::delay(c.dtMs);
+    }
+    if (loop != AUTOTUNE_LB) chassis.pid_wait();
+    // divide by the step size so the weights mean the same thing for every loop
+    score += itae / size + AUTOTUNE_OVERSHOOT_WEIGHT * overshoot / size;
+  }
+  return score;
+}
+
+autotune_gains pid_autotune_run(autotune_loop loop) {
+  autotuneConfig c = autotuneConfigs[loop];
+  autotune_gains original = autotuneGainsGet(loop);
+  double dt = c.dtMs / 1000.0;
+
+  controller.set_text(0, 0, std::string("autotune ") + c.name + " relay ");
+  relay_result relay = pid_autotune_relay(loop);
+  if (!relay.ok) {
+    controller.set_text(0, 0, "relay failed        ");
+    return original;
+  }
+
+  // classic ZN, "some overshoot" and "no overshoot". I only gets used if start_i is set, otherwise it winds up
+  // the whole motion (and the lady brown loop has nothing to stop windup at all)
+  bool useI = loop != AUTOTUNE_LB && original.start_i > 0.0;
+  std::vector<autotune_gains> candidates = {
+      autotune_gains_from_relay(relay, 0.6, 0.5, 0.125, dt),
+      autotune_gains_from_relay(relay, 0.33, 0.5, 0.33, dt),
+      autotune_gains_from_relay(relay, 0.2, 0.5, 0.33, dt),
+  };
+
+  autotune_gains best = original;
+  autotune_gains bestRule = original;  // best after the rules, both refinements scale this one (not whatever won since)
+  double bestScore = 1e9;
+  for (int i = 0; i < (int)candidates.size() + 2; i++) {
+    // last 2 tries refine the best rule: a bit softer and a bit harder
+    if (i == (int)candidates.size()) bestRule = best;
+    autotune_gains g = i < (int)candidates.size() ? candidates[i] : bestRule;
+    if (i == (int)candidates.size()) g = {bestRule.kp * 0.8, bestRule.ki * 0.8, bestRule.kd * 0.8, bestRule.start_i};
+    if (i == (int)candidates.size() + 1) g = {bestRule.kp * 1.2, bestRule.ki * 1.2, bestRule.kd * 1.2, bestRule.start_i};
+    g.start_i = original.start_i;
+    if (!useI) g.ki = 0.0;
+
+    controller.set_text(0, 0, std::string("autotune ") + c.name + " " + std::to_string(i + 1) + "/5 ");
+    double score = pid_autotune_score(loop, g);
+    printf("autotune %s: kp %.4f ki %.5f kd %.4f -> score %.4f\n", c.name, g.kp, g.ki, g.kd, score);
+    if (score < bestScore) {
+      bestScore = score;
+      best = g;
+    }
+  }
+
+  autotuneGainsSet(loop, best);
+  printf("autotune %s: BEST kp %.4f ki %.5f kd %.4f start_i %.2f (Ku %.4f Tu %.3f)\n", c.name, best.kp, best.ki, best.kd, best.start_i, relay.ku, relay.tu);
+  if (ez::util::SD_CARD_ACTIVE) {
+    FILE *file = fopen(PID_AUTOTUNE_FILE.c_str(), "a");
+    if (file != nullptr) {
+      fprintf(file, "%s kp %.4f ki %.5f kd %.4f start_i %.2f ku %.4f tu %.3f score %.4f\n", c.name, best.kp, best.ki, best.kd, best.start_i, relay.ku, relay.tu, bestScore);
+      fclose(file);
+    }
+  }
+  controller.set_text(0, 0, std::string(c.name) + " " + ez::util::to_string_with_precision(best.kp, 2) + " " + ez::util::to_string_with_precision(best.kd, 1) + "    ");
+  return best;
+}
+
+void pid_autotune_iterate() {
+  if (!chassis.pid_tuner_enabled()) return;
+
+  if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_R2)) {
+    autotuneSelected = (autotuneSelected + 1) % 4;
+    controller.set_text(0, 0, std::string("autotune: ") + autotuneConfigs[autotuneSelected].name + "     ");
+  }
+  if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L2))
+    pid_autotune_run((autotune_loop)autotuneSelected);
+}
@@ -0,0 +1,113 @@
+#include "power_manager.hpp"
+
+#include "subsystems.hpp"
+#include "thermal_model.hpp"
+
+power_budget_state powerState;
+pros::Mutex powerMutex;
+
+const int POWER_LOOP_TIME = 20;      // ms, no point going faster, limits take a bit to matter anyway
+const int PUSH_CURRENT = 1800;       // average drive mA per motor that counts as shoving
+const double PUSH_VELOCITY = 60.0;   // drive rpm under which shoving means pushing (not accelerating)
+const int PUSH_TIME = 100;           // ms it has to look like a push before the drive gets priority
+const int LB_SCORE_DISTANCE = 2000;  // centidegrees from target that counts as "swinging to score"
+
+void power_request(power_consumer consumer, int mA, int priority) {
+  powerMutex.take();
+  powerState.consumers[consumer].requested = ez::util::clamp(mA, POWER_MOTOR_MAX_MA, 0);
+  powerState.consumers[consumer].priority = priority;
+  powerState.consumers[consumer].manual = true;
+  powerMutex.give();
+}
+
+void power_request_clear(power_consumer consumer) {
+  powerMutex.take();
+  powerState.consumers[consumer].manual = false;
+  powerMutex.give();
+}
+
+void power_budget_set(int mA) {
+  powerMutex.take();
+  powerState.budget = mA;
+  powerMutex.give();
+}
+
+power_budget_state power_budget_state_get() {
+  powerMutex.take();
+  power_budget_state s = powerState;
+  powerMutex.give();
+  return s;
+}
+
+void power_manager_task() {
+  int pushTime = 0;
+  int lastApplied[POWER_CONSUMERS] = {-1, -1, -1};
+
+  while (true) {
+    // what everything is doing right now
+    double driveCurrent = 0.0, driveVelocity = 0.0;
+    for (int i = 0; i < 3; i++) {
+      driveCurrent += std::abs(left_drive.get_current_draw(i)) + std::abs(right_drive.get_current_draw(i));
+      driveVelocity += std::fabs(left_drive.get_actual_velocity(i)) + std::fabs(right_drive.get_actual_velocity(i));
+    }
+    driveVelocity /= 6.0;
+    pushTime = driveCurrent / 6.0 > PUSH_CURRENT && driveVelocity < PUSH_VELOCITY ? pushTime + POWER_LOOP_TIME : 0;
+    bool pushing = pushTime >= PUSH_TIME;
+    // anything above the loading state is a score/tip move, and it's only "swinging" while it's far from there
+    bool lbMoving = std::abs(target - lbSensor.get_position()) > LB_SCORE_DISTANCE;
+    bool scoring = target > states[1] && lbMoving;
+    bool intakeRunning = std::abs(intake.get_voltage()) > 1000;
+
+    powerMutex.take();
+    powerState.pushing = pushing;
+    powerState.scoring = scoring;
+    power_consumer_state *c = powerState.consumers;
+    // automatic requests, see power_auto_requests()
+    int autoRequested[POWER_CONSUMERS], autoPriority[POWER_CONSUMERS], autoReserved[POWER_CONSUMERS];
+    power_auto_requests(driveCurrent / 6.0, pushing, intakeRunning, lbMoving, scoring, autoRequested, autoPriority, autoReserved);
+    for (int i = 0; i < POWER_CONSUMERS; i++) {
+      if (c[i].manual) {
+        c[i].reserved = 0;  // power_request() says exactly what it wants, priority decides the rest
+        continue;
+      }
+      c[i].requested = autoRequested[i];
+      c[i].priority = autoPriority[i];
+      c[i].reserved = autoReserved[i];
+    }
+
+    // the drive limit goes on all 6 motors, so the hottest one decides it
+    c[POWER_DRIVE].thermal = POWER_MOTOR_MAX_MA;
+    for (int m = THERMAL_LEFT_1; m <= THERMAL_RIGHT_3; m++) c[POWER_DRIVE].thermal = std::min(c[POWER_DRIVE].thermal, thermal_limit_get((thermal_motor)m));
+    c[POWER_INTAKE].thermal = thermal_limit_get(THERMAL_INTAKE);
+    c[POWER_LB].thermal = thermal_limit_get(THERMAL_LB);
+
+    int requested[POWER_CONSUMERS], priority[POWER_CONSUMERS], reserved[POWER_CONSUMERS], allocated[POWER_CONSUMERS];
+    for (int i = 0; i < POWER_CONSUMERS; i++) {
+      requested[i] = std::min(c[i].requested, c[i].thermal);
+      priority[i] = c[i].priority;
+      reserved[i] = std::min(c[i].reserved, c[i].thermal);
+    }
+    power_budget_split(requested, priority, reserved, POWER_MOTORS, POWER_CONSUMERS, powerState.budget, allocated);
+
+    powerState.allocated = 0;
+    powerState.throttled = false;
+    for (int i = 0; i < POWER_CONSUMERS; i++) {
+      c[i].allocated = allocated[i];
+      powerState.allocated += allocated[i] * POWER_MOTORS[i];
+      powerState.throttled = powerState.throttled || allocated[i] < requested[i];
+    }
+    c[POWER_DRIVE].drawn = driveCurrent;
+    c[POWER_INTAKE].drawn = std::abs(intake.get_current_draw());
+    c[POWER_LB].drawn = std::abs(lb.get_current_draw());
+    powerState.drawn = c[POWER_DRIVE].drawn + c[POWER_INTAKE].drawn + c[POWER_LB].drawn;
+    powerMutex.give();
+
+    // only touch the motors when a limit actually changes
+    if (allocated[POWER_DRIVE] != lastApplied[POWER_DRIVE]) chassis.drive_current_limit_set(allocated[POWER_DRIVE]);
+    if (allocated[POWER_INTAKE] != lastApplied[POWER_INTAKE]) intake.set_current_limit(allocated[POWER_INTAKE]);
+    if (allocated[POWER_LB] != lastApplied[POWER_LB]) lb.set_current_limit(allocated[POWER_LB]);
+    for (int i = 0; i < POWER_CONSUMERS; i++) lastApplied[i] = allocated[i];
+
+    pros::delay(POWER_LOOP_TIME);
+  }
+}
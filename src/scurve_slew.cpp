@@ -0,0 +1,123 @@
+#include "scurve_slew.hpp"
+
+#include "subsystems.hpp"
+
+slew_profile_type driveSlewProfile = SLEW_LINEAR;
+slew_profile_type turnSlewProfile = SLEW_LINEAR;
+slew_profile_type swingSlewProfile = SLEW_LINEAR;
+
+// S-curve state for the motion that's running now, only slew_profile_task touches it
+scurve_slew scurveLeft, scurveRight, scurveAngle;
+
+// the target EZ-Template is driving the current motion to, a new one means a new motion
+double scurveTargetGet(ez::e_mode mode) {
+  return mode == ez::DRIVE ? chassis.leftPID.target : mode == ez::TURN ? chassis.turnPID.target
+                                                                        : chassis.swingPID.target;
+}
+
+void slew_profile_set(ez::e_mode mode, slew_profile_type type) {
+  if (mode == ez::DRIVE) driveSlewProfile = type;
+  if (mode == ez::TURN) turnSlewProfile = type;
+  if (mode == ez::SWING) swingSlewProfile = type;
+}
+
+slew_profile_type slew_profile_get(ez::e_mode mode) {
+  if (mode == ez::DRIVE) return driveSlewProfile;
+  if (mode == ez::TURN) return turnSlewProfile;
+  if (mode == ez::SWING) return swingSlewProfile;
+  return SLEW_LINEAR;
+}
+
+// where the slew measures from (same sensors EZ-Template's slew uses)
+double scurveSwingCurrent() {
+  return chassis.current_swing == ez::LEFT_SWING ? chassis.drive_sensor_left() : chassis.drive_sensor_right();
+}
+
+// a motion just started: copy EZ-Template's slew settings for it, then turn EZ-Template's ramp off
+void scurveStart(ez::e_mode mode, double speed) {
+  if (mode == ez::DRIVE) {
+    ez::slew::Constants c = chassis.slew_left.constants_get();
+    scurveLeft.constants_set(c.distance_to_travel, c.min_speed);
+    scurveRight.constants_set(c.distance_to_travel, c.min_speed);
+    scurveLeft.initialize(chassis.slew_left.enabled(), speed, chassis.leftPID.target, chassis.drive_sensor_left());
+    scurveRight.initialize(chassis.slew_right.enabled(), speed, chassis.rightPID.target, chassis.drive_sensor_right());
+    chassis.slew_left.initialize(false, speed, chassis.leftPID.target, chassis.drive_sensor_left());
+    chassis.slew_right.initialize(false, speed, chassis.rightPID.target, chassis.drive_sensor_right());
+  } else if (mode == ez::TURN) {
+    ez::slew::Constants c = chassis.slew_turn.constants_get();
+    scurveAngle.constants_set(c.distance_to_travel, c.min_speed);
+    scurveAngle.initialize(chassis.slew_turn.enabled(), speed, chassis.turnPID.target, chassis.drive_imu_get());
+    chassis.slew_turn.initialize(false, speed, chassis.turnPID.target, chassis.drive_imu_get());
+  } else {
+    // distance the swinging side has to go isn't known up front, only the direction matters for the ramp
+    ez::slew::Constants c = chassis.slew_swing.constants_get();
+    double direction = chassis.swingPID.target >= chassis.drive_imu_get() ? 1.0 : -1.0;
+    if (chassis.current_swing == ez::RIGHT_SWING) direction = -direction;
+    scurveAngle.constants_set(c.distance_to_travel, c.min_speed);
+    scurveAngle.initialize(chassis.slew_swing.enabled(), speed, scurveSwingCurrent() + direction, scurveSwingCurrent());
+    chassis.slew_swing.initialize(false, speed, chassis.swingPID.target, chassis.drive_imu_get());
+  }
+}
+
+// one tick of the S-curve at the motion's max speed right now, returns the cap
+double scurveStep(ez::e_mode mode) {
+  double speed = chassis.pid_speed_max_get();
+  if (mode == ez::DRIVE) {
+    scurveLeft.speed_max_set(speed);
+    scurveRight.speed_max_set(speed);
+    return std::fmin(scurveLeft.iterate(chassis.drive_sensor_left()), scurveRight.iterate(chassis.drive_sensor_right()));
+  }
+  scurveAngle.speed_max_set(speed);
+  return scurveAngle.iterate(mode == ez::TURN ? chassis.drive_imu_get() : scurveSwingCurrent());
+}
+
+bool scurveRamping(ez::e_mode mode) {
+  return mode == ez::DRIVE ? scurveLeft.enabled() || scurveRight.enabled() : scurveAngle.enabled();
+}
+
+// EZ-Template's slew for the motion is off, so whatever its max speed is set to is the cap its loop uses
+void scurveCapSet(ez::e_mode mode, double cap) {
+  if (mode == ez::DRIVE) {
+    chassis.slew_left.speed_max_set(cap);
+    chassis.slew_right.speed_max_set(cap);
+  } else if (mode == ez::TURN) {
+    chassis.slew_turn.speed_max_set(cap);
+  } else {
+    chassis.slew_swing.speed_max_set(cap);
+  }
+}
+
+void slew_profile_task() {
+  ez::e_mode lastMode = ez::DISABLE;
+  double lastTarget = 0.0;
+  ez::e_mode ramping = ez::DISABLE;  // motion the S-curve has, DISABLE for none
+  double cap = 0.0;
+  int sinceStep = 0;
+  while (true) {
+    // a new mode or target is a new motion, whatever was ramping before is over
+    ez::e_mode mode = chassis.drive_mode_get();
+    double target = scurveTargetGet(mode);
+    if (mode != lastMode || target != lastTarget) {
+      ramping = ez::DISABLE;
+      if (slew_profile_get(mode) == SLEW_SCURVE) {
+        scurveStart(mode, chassis.pid_speed_max_get());
+        ramping = mode;
+        sinceStep = ez::util::DELAY_TIME;  // first step right now
+      }
+    }
+    lastMode = mode;
+    lastTarget = target;
+
+    if (ramping != ez::DISABLE) {
+      if (sinceStep >= ez::util::DELAY_TIME) {
+        cap = scurveStep(ramping);
+        sinceStep = 0;
+      }
+      scurveCapSet(ramping, cap);  // every check, something might have reset it since
+      if (!scurveRamping(ramping)) ramping = ez::DISABLE;  // cap is the full max speed now, nothing left to do
+    }
+
+    sinceStep += SCURVE_WATCH_TIME;
+    pros::delay(SCURVE_WATCH_TIME);
+  }
+}
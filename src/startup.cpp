@@ -0,0 +1,50 @@
+#include "startup.hpp"
+
+#include <atomic>
+
+// initialize() used to do everything in a row: wait on the 3 wire ports, wait on the IMU, then read the SD card.
+// Now each of those runs in its own task and flips a bit when it's done. Anything that needs a stage
+// (autonomous needs the IMU and pistons, driver needs the curves) waits on just the bits it cares about.
+
+std::atomic<int> startupReadyMask = 0;
+int startupReadyTime[4] = {-1, -1, -1, -1};  // ms since boot each stage became ready
+const char *startupStageNames[4] = {"IMU", "ADI", "SD", "PATHS"};
+
+void startup_stage_ready_set(startup_stage stage) {
+  for (int i = 0; i < 4; i++)
+    if (stage == (1 << i)) startupReadyTime[i] = pros::millis();
+  startupReadyMask |= stage;
+}
+
+void startup_stage_run(startup_stage stage, std::function<void()> work) {
+  pros::Task([stage, work]() {
+    work();
+    startup_stage_ready_set(stage);
+  });
+}
+
+bool startup_ready(int stages) {
+  return (startupReadyMask & stages) == stages;
+}
+
+bool startup_wait(int stages, int timeout) {
+  int start = pros::millis();
+  while (!startup_ready(stages)) {
+    if ((int)(pros::millis() - start) >= timeout) {
+      printf("startup_wait timed out after %i ms\n", timeout);
+      startup_print();
+      return false;
+    }
+    pros::delay(5);
+  }
+  return true;
+}
+
+void startup_print() {
+  for (int i = 0; i < 4; i++) {
+    if (startupReadyTime[i] >= 0)
+      printf("startup: %s ready at %i ms\n", startupStageNames[i], startupReadyTime[i]);
+    else
+      printf("startup: %s not ready\n", startupStageNames[i]);
+  }
+}
@@ -1,11 +1,19 @@
 #include "subsystems.hpp"
 
 #include "autons.hpp"
+#include "battery_compensation.hpp"
 #include "pros/distance.hpp"
 #include "pros/misc.h"
 #include "pros/misc.hpp"
 #include "pros/motor_group.hpp"
+#include "loop_profiler.hpp"
+#include "memory_monitor.hpp"
+#include "param_table.hpp"
+#include "sysid.hpp"
+#include "telemetry.hpp"
 #include "pros/motors.hpp"
+#include "thermal_model.hpp"
+#include "trace_log.hpp"
 
 // motors
 pros::Motor intake(11, pros::MotorGears::blue);
@@ -35,6 +43,7 @@ double output = 0;                   // final output to the lady brown
 int descore = 0;                     // bool for descore positions
 bool intakeLockingOverride = false;  // this is used to override the driver to
                                      // allow colorsort/antijam to work.
+bool lbOverride = false;             // same idea for the lady brown, sysid uses this
 bool bangExit = false;
 
 // sensors
@@ -48,8 +57,15 @@ pros::Controller controller(pros::E_CONTROLLER_MASTER);  // controller
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 // DRIVER CONTROL CODE GOES HERE
 
+// In tuning mode (param_table.hpp) the controller runs the PID tuner, the table and the test routines in
+// ez_template_extras() instead, and everything stays put while sysid has the robot
+bool driverButtonsBlocked() {
+  return sysid_running() || param_table_tuning();
+}
+
 // piston driver control code, works through toggles
 void pneumaticDriverControl() {
+  if (driverButtonsBlocked()) return;
   // mogo
   if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1)) {
     mogoToggle = !mogoToggle;
@@ -91,11 +107,11 @@ bool BangBang(double exitRange, double error, pros::MotorGroup obj) {
     bangExit = false;            // does not exit because the arm is outside of optimal PID
                                  // control range
     if (error > 0) {             // Checks if error is (+) or (-)
-      obj.move_voltage(120000);  // Full Speed in direction of target. Might need
+      battery_move_voltage(obj, 120000);  // Full Speed in direction of target. Might need
                                  // to make (-) depending on motor orientation
     } else {
-      obj.move_voltage(
-          -120000);  // Full Speed in direction of target. Might need to make (+)
+      battery_move_voltage(
+          obj, -120000);  // Full Speed in direction of target. Might need to make (+)
                      // depending on motor orientation
     }
 
@@ -191,9 +207,16 @@ void descoreState() {
 void armDriver() {
   // this is in a while loop because it needs to run constantly
   //  this should be called in a task to run the arm
+  int loop = loop_profile_register("armDriver", 20);  // timing stats, see loop_profiler.hpp
+  int memory = memory_monitor_register("armDriver");  // stack high-water mark, see memory_monitor.hpp
+  int tracedTarget = -1;                              // last target on the trace, see trace_log.hpp
   while (true) {
+    loop_profile_start(loop);
+    memory_monitor_sample(memory);
     // X moves the arm to the next state
-    if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_X)) {
+    if (driverButtonsBlocked()) {
+      // the sysid prompts or tuning mode have the controller, the arm stays where it is
+    } else if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_X)) {
       nextState();
       // this is the button to move the arm to the previous state
     } else if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_B)) {
@@ -207,6 +230,19 @@ void armDriver() {
                    pros::E_CONTROLLER_DIGITAL_DOWN)) {
       descoreState();
     }
+    // autons set target straight, so changes get caught here instead of in the state functions
+    if (target != tracedTarget) {
+      trace_instant(TRACE_ARM, target);
+      tracedTarget = target;
+    }
+    // something else (sysid) is driving the arm, stay out of its way
+    if (lbOverride) {
+      armIntegral = 0;
+      prevError = 0;
+      loop_profile_end(loop);
+      pros::delay(20);
+      continue;
+    }
     // PID calculations
     error = target - lbSensor.get_position();  // error = difference between
                                                // target and current position
@@ -216,9 +252,10 @@ void armDriver() {
     output = (kP * error) + (kI * armIntegral) +
              (kD * derivative);  // final output to the lady brown
 
-    lb.move_voltage(output);  // actually move the arm
+    battery_move_voltage(lb, output);  // actually move the arm
 
     prevError = error;  // set the previous error to the current error
+    loop_profile_end(loop);
     pros::delay(20);    // delay to avoid CPU overload
   }
 }
@@ -231,7 +268,9 @@ void BangBangInjectedArmDriver() {
   //  this should be called in a task to run the arm
   while (true) {
     // X moves the arm to the next state
-    if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_X)) {
+    if (driverButtonsBlocked()) {
+      // the sysid prompts or tuning mode have the controller, the arm stays where it is
+    } else if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_X)) {
       nextState();
       // this is the button to move the arm to the previous state
     } else if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_B)) {
@@ -261,7 +300,7 @@ void BangBangInjectedArmDriver() {
     // the arm
     if (BangBang(500, error, lb)) {
     } else {
-      lb.move_voltage(output);  // PID output is triggered if bang bang exits
+      battery_move_voltage(lb, output);  // PID output is triggered if bang bang exits
     }
   }
   prevError = error;  // set the previous error to the current error
@@ -270,7 +309,7 @@ void BangBangInjectedArmDriver() {
 
 // Intake Driver Control Function
 void intakeDriver() {
-  if (!intakeLockingOverride) {  // checks to see if the intake is being
+  if (!intakeLockingOverride && !driverButtonsBlocked()) {  // checks to see if the intake is being
                                  // overridden by the antijam or colorsort. Can
                                  // be removed if not running either
     if (controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1)) {
@@ -287,26 +326,32 @@ void intakeDriver() {
 }
 
 // antijam code for driver control
+// These are globals so the parameter table (param_table.hpp) can tune them live
+int stallVelocity = 10;        // rpm under which the intake counts as jammed
+int driverStallTime = 300;     // ms of sustained low velocity to count as jam
+int driverEjectRotation = 20;  // degrees to spin intake to eject (tune this!)
+
 void antiJamDriverControl() {
   const int checkInterval = 20;  // ms per loop
-  const int stallTime = 300;     // ms of sustained low velocity to count as jam
-  const int stallTicks =
-      stallTime / checkInterval;  // allows u to play with loop time and stall
-                                  // time without changing how the code runs
 
   int stallCounter =
       0;             // essentially a counter for how long the intake has been jammed
   int cooldown = 0;  // stops antijam from running constantly due to motors
                      // needing to accelerate after antijamming
 
+  int loop = loop_profile_register("antiJamDriver", checkInterval);  // timing stats, see loop_profiler.hpp
+
+  int memory = memory_monitor_register("antiJamDriver");  // stack high-water mark, see memory_monitor.hpp
   while (true) {
+    loop_profile_start(loop);
+    memory_monitor_sample(memory);
     if (intakeState == 1 && sortingBool == false && currState != 1) {
       // checks for: intake is intaking, not colorsorting, and lady brown is not
       // in the loading state
       //  If velocity is very low, count it as a potential jam
-      if (std::abs(intake.get_actual_velocity()) <= 10 && cooldown == 0) {
+      if (std::abs(intake.get_actual_velocity()) <= stallVelocity && cooldown == 0) {
         stallCounter++;  // increment the stall counter if the intake is jammed
-        if (stallCounter >= stallTicks) {
+        if (stallCounter >= driverStallTime / checkInterval) {  // in ticks, so the loop time can change without changing how the code runs
           // Jam confirmed, do anti-jam action
           intakeLockingOverride = true;  // set the override to true
           outtake();                     // reverses to unjam the intake
@@ -329,12 +374,12 @@ void antiJamDriverControl() {
 
     if (cooldown > 0)
       cooldown--;  // decrement the cooldown counter
+    loop_profile_end(loop);
     pros::delay(checkInterval);
   }
 }
 
 void colorSortDriverControl() {
-  const int ejectRotation = 20;  // degrees to spin intake to eject (tune this!)
   bool ejecting = false;         // bool to check if the intake is ejecting a ring
   int ejectTarget = 0;           // target position for the intake to eject the ring
 
@@ -347,8 +392,9 @@ void colorSortDriverControl() {
       sortingBool =
           true;  // sorting bool is set to true, overriding the antijam code
       ejectTarget =
-          intake.get_position() - ejectRotation;  // sets the target position for
-                                                  // the intake to eject the ring
+          intake.get_position() - driverEjectRotation;  // sets the target position for
+                                                        // the intake to eject the ring
+      telemetry_color_event(TELEMETRY_COLOR_DETECT, vision.get_hue(), ringsEjected);  // live on the dashboard, see telemetry.hpp
       // NOTE: it is (-), but sometimes it is (+) depending on the orientation
       // of the intake motor
     } else if (ejecting) {
@@ -361,6 +407,7 @@ void colorSortDriverControl() {
         pros::delay(200);              // Adjustable timeout, just how long the sorting
                                        // should wait before resuming intaking
         autoIntake();                  // intake again after the ring is ejected
+        telemetry_color_event(TELEMETRY_COLOR_EJECT, vision.get_hue(), ringsEjected + 1);
         ejecting = false;              // stops the ejecting from happening again until
                                        // boundary conditions are met
         ringsEjected++;                // increment the number of rings ejected, can be
@@ -386,14 +433,13 @@ void tempDisplay() {
   //  Variables for temperature readings
   int avgTempLeft = 0;
   int avgTempRight = 0;
-  int avgTempIntake = 0;
   int returning = 0;
-  int avgTempLb = 0;
-  int avgTempTotal = 0;
-  int batteryLevel =
-      ((pros::battery::get_capacity()) / 1100) *
-      100;  // more accurate battery level than the default display
+  bool thermalLine = false;  // which controller line gets updated this time
+  int loop = loop_profile_register("tempDisplay", 50);  // timing stats, see loop_profiler.hpp
+  int memory = memory_monitor_register("tempDisplay");  // stack high-water mark, see memory_monitor.hpp
   while (true) {
+    loop_profile_start(loop);
+    memory_monitor_sample(memory);
     // Averaging each dt half for left and right drive motors
     avgTempLeft =
         (left_drive.get_temperature(0) + left_drive.get_temperature(1) +
@@ -406,19 +452,32 @@ void tempDisplay() {
         3;
     returning = (avgTempLeft + avgTempRight) / 2;  // avg
     returning = (returning * 1.8) + 32;            // Convert to Fahrenheit
-    // Averaging the intake and lady brown motor temperatures + convert to F
-    avgTempIntake = (1.8 * intake.get_temperature()) + 32;
-    avgTempLb = (1.8 * lb.get_temperature()) + 32;
-
-    // Convert to F while averaging both sides
+    // the intake and lady brown are on the HOT line below, the thermal model watches every motor
 
     // Convert temperatures to string and display
-    controller.set_text(0, 0, "DT: " + std::to_string(int(returning)));
+    // the controller only takes one line per 50 ms, so the two lines take turns
+    if (thermalLine) {
+      // time until the motor closest to 55C throttles (thermal_model.hpp), * = it's being derated
+      thermal_motor worst = thermal_worst_get();
+      thermal_motor_state s = thermal_state_get(worst);
+      std::string ttt = std::isinf(s.time_to_throttle) ? "--" : std::to_string(int(s.time_to_throttle)) + "s";
+      controller.set_text(1, 0, "HOT " + std::string(thermal_motor_name(worst)) + " " + ttt + (s.limit < THERMAL_MAX_MA ? "*" : "") + "     ");
+    } else {
+      controller.set_text(0, 0, "DT: " + std::to_string(int(returning)));
+    }
+    thermalLine = !thermalLine;
 
+    loop_profile_end(loop);
     pros::delay(50);  // delay to avoid cpu/controller screen overload
   }
 }
 
+// Extra IMUs that get fused with the chassis IMU (port 6 below is always used). Leave empty to run on just the one
+// ex: {5, 9} -> a dropped/unplugged extra IMU gets ignored automatically
+// With one extra IMU it gets checked against the chassis IMU. A chassis IMU going bad can only be caught by a
+// vote, which takes 2 extras (3 IMUs total)
+std::vector<int> extraImuPorts = {};
+
 // Chassis constructor
 ez::Drive chassis(
     // These are your drive motors, the first motor is used for sensing!
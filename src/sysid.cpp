@@ -0,0 +1,143 @@
+#include "sysid.hpp"
+
+#include "subsystems.hpp"
+
+// Samples get buffered in RAM while the test runs and written after, SD writes are way too slow for a 10 ms loop
+struct sysidSample {
+  int time;          // ms since the test started
+  float commanded;   // mV we asked for
+  float applied;     // mV the motor says it's actually putting out (this is what gets fit)
+  float position;    // drive: inches, intake: motor degrees, lb: motor degrees
+  float velocity;    // motor rpm, just for reference. the fit uses the position
+  float angle;       // lb: rotation sensor degrees (for kG), otherwise 0
+  float ground;      // drive: vert_tracker inches (ground truth for wheel slip), otherwise 0
+};
+
+const int SYSID_MAX_SAMPLES = SYSID_MAX_TIME / ez::util::DELAY_TIME + 1;
+sysidSample sysidLog[SYSID_MAX_SAMPLES];
+const char *sysidMechanismNames[3] = {"drive", "intake", "lb"};
+const char *sysidTestNames[3] = {"quasistatic", "dynamic", "launch"};
+
+void sysidVoltageSet(sysid_mechanism mechanism, double mV) {
+  if (mechanism == SYSID_DRIVE) {
+    left_drive.move_voltage(mV);
+    right_drive.move_voltage(mV);
+  } else if (mechanism == SYSID_INTAKE) {
+    intake.move_voltage(mV);
+  } else {
+    lb.move_voltage(mV);
+  }
+}
+
+sysidSample sysidMeasure(sysid_mechanism mechanism) {
+  sysidSample s = {};
+  if (mechanism == SYSID_DRIVE) {
+    s.applied = (left_drive.get_voltage() + right_drive.get_voltage()) / 2.0;
+    s.position = (chassis.drive_sensor_left() + chassis.drive_sensor_right()) / 2.0;
+    s.velocity = (left_drive.get_actual_velocity() + right_drive.get_actual_velocity()) / 2.0;
+    s.ground = vert_tracker.get();
+  } else if (mechanism == SYSID_INTAKE) {
+    s.applied = intake.get_voltage();
+    s.position = intake.get_position();
+    s.velocity = intake.get_actual_velocity();
+  } else {
+    s.applied = lb.get_voltage();
+    s.position = lb.get_position();
+    s.velocity = lb.get_actual_velocity();
+    s.angle = lbSensor.get_position() / 100.0;  // centidegrees -> degrees
+  }
+  return s;
+}
+
+// true if the mechanism ran out of room and the test should stop
+bool sysidOutOfRoom(sysid_mechanism mechanism, const sysidSample &start, const sysidSample &now) {
+  if (mechanism == SYSID_DRIVE)
+    return std::fabs(now.position - start.position) > SYSID_DRIVE_MAX_TRAVEL;
+  if (mechanism == SYSID_LB) {
+    // same range the driver states use: stowed (states[0]) to untip (40000)
+    double centidegrees = now.angle * 100.0;
+    return centidegrees < states[0] - 500 || centidegrees > 40500;
+  }
+  return false;
+}
+
+bool sysid_run(sysid_mechanism mechanism, sysid_test test, bool forward) {
+  if (test == SYSID_LAUNCH && mechanism != SYSID_DRIVE) {
+    printf("sysid: launch test is drive only\n");
+    return false;
+  }
+  // keep the driver code + subsystem tasks off of whatever is being tested
+  if (mechanism == SYSID_INTAKE) intakeLockingOverride = true;
+  if (mechanism == SYSID_LB) lbOverride = true;
+  if (mechanism == SYSID_DRIVE) {
+    chassis.drive_sensor_reset();
+    vert_tracker.reset();
+  }
+
+  double direction = forward ? 1.0 : -1.0;
+  sysidSample start = sysidMeasure(mechanism);
+  int count = 0;
+  int startTime = pros::millis();
+
+  while (count < SYSID_MAX_SAMPLES) {
+    int elapsed = pros::millis() - startTime;
+    double mV = test == SYSID_QUASISTATIC ? SYSID_RAMP_MV_PER_SEC * elapsed / 1000.0 : test == SYSID_DYNAMIC ? SYSID_STEP_MV
+                                                                                                           : SYSID_LAUNCH_MV;
+    mV = std::min(mV, 12000.0) * direction;
+    sysidVoltageSet(mechanism, mV);
+
+    sysidSample s = sysidMeasure(mechanism);
+    s.time = elapsed;
+    s.commanded = mV;
+    sysidLog[count++] = s;
+    if (sysidOutOfRoom(mechanism, start, s)) break;
+
+    pros::delay(ez::util::DELAY_TIME);
+  }
+  sysidVoltageSet(mechanism, 0);
+
+  intakeLockingOverride = false;
+  lbOverride = false;
+  if (mechanism == SYSID_LB) target = lbSensor.get_position();  // hold the arm wherever it stopped instead of snapping back
+
+  if (!ez::util::SD_CARD_ACTIVE) {
+    printf("sysid: no SD card, log not saved\n");
+    return false;
+  }
+  std::string name = std::string("/usd/sysid_") + sysidMechanismNames[mechanism] + "_" + sysidTestNames[test] + (forward ? "_fwd" : "_rev") + ".csv";
+  FILE *file = fopen(name.c_str(), "w");
+  if (file == nullptr) return false;
+  fprintf(file, "time_ms,commanded_mv,applied_mv,position,velocity_rpm,angle_deg,ground_in\n");
+  for (int i = 0; i < count; i++)
+    fprintf(file, "%d,%.0f,%.0f,%.4f,%.2f,%.2f,%.4f\n", sysidLog[i].time, sysidLog[i].commanded, sysidLog[i].applied, sysidLog[i].position, sysidLog[i].velocity, sysidLog[i].angle, sysidLog[i].ground);
+  fclose(file);
+  printf("sysid: saved %d samples to %s\n", count, name.c_str());
+  return true;
+}
+
+void sysidWaitForL2(std::string prompt) {
+  controller.clear();
+  pros::delay(50);
+  controller.set_text(0, 0, prompt + ": L2 go");
+  while (!controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L2)) pros::delay(ez::util::DELAY_TIME);
+}
+
+bool sysidRunning = false;
+
+bool sysid_running() { return sysidRunning; }
+
+void sysid_run_all(sysid_mechanism mechanism) {
+  sysidRunning = true;
+  for (sysid_test test : {SYSID_QUASISTATIC, SYSID_DYNAMIC}) {
+    for (bool forward : {true, false}) {
+      sysidWaitForL2(std::string(sysidMechanismNames[mechanism]) + (forward ? " fwd" : " rev"));
+      sysid_run(mechanism, test, forward);
+    }
+  }
+  if (mechanism == SYSID_DRIVE) {
+    sysidWaitForL2("launch fwd");
+    sysid_run(mechanism, SYSID_LAUNCH, true);
+  }
+  controller.set_text(0, 0, "sysid done          ");
+  sysidRunning = false;
+}
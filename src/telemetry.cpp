@@ -0,0 +1,125 @@
+#include "telemetry.hpp"
+
+#include "autons.hpp"
+#include "loop_profiler.hpp"
+#include "pros/apix.h"
+#include "subsystems.hpp"
+
+int telemetryRate[TELEMETRY_CHANNELS] = {TELEMETRY_RATE_DEFAULT[0], TELEMETRY_RATE_DEFAULT[1], TELEMETRY_RATE_DEFAULT[2],
+                                         TELEMETRY_RATE_DEFAULT[3], TELEMETRY_RATE_DEFAULT[4]};
+bool telemetryOn = false;
+int telemetryDropped = 0;
+pros::Serial *telemetrySerial = nullptr;  // made the first time it's turned on, TELEMETRY_PORT != 0 only
+
+// Color sort events, the sort loops add and telemetry_task takes. There's a handful a match, a mutex is fine
+telemetry_color telemetryEvents[TELEMETRY_EVENTS];
+int telemetryEventHead = 0, telemetryEventTail = 0;
+pros::Mutex telemetryEventMutex;
+
+// Everything a tick sends goes into here and out in one write
+std::uint8_t telemetryOut[TELEMETRY_FRAME_MAX * (TELEMETRY_CHANNELS + TELEMETRY_EVENTS)];
+int telemetryOutSize = 0;
+std::uint8_t telemetrySequence[TELEMETRY_CHANNELS] = {};
+
+void telemetry_enable(bool enable) {
+  if (enable == telemetryOn) return;
+  if (TELEMETRY_PORT == 0) {
+    fflush(stdout);  // whatever was printed before goes out in PROS's framing
+    pros::c::serctl(enable ? SERCTL_DISABLE_COBS : SERCTL_ENABLE_COBS, nullptr);
+  } else if (telemetrySerial == nullptr) {
+    telemetrySerial = new pros::Serial(TELEMETRY_PORT, TELEMETRY_BAUD);
+  }
+  telemetryOn = enable;
+}
+
+bool telemetry_enabled() { return telemetryOn; }
+
+void telemetry_rate_set(telemetry_channel channel, int hz) {
+  if (channel < TELEMETRY_CHANNELS) telemetryRate[channel] = hz < 0 ? 0 : hz;
+}
+
+void telemetry_color_event(telemetry_color_kind kind, int hue, int ejected) {
+  if (!telemetryOn) return;
+  telemetryEventMutex.take();
+  int next = (telemetryEventHead + 1) % TELEMETRY_EVENTS;
+  if (next != telemetryEventTail) {
+    telemetryEvents[telemetryEventHead] = {kind, 0, (std::uint16_t)hue, (std::uint16_t)ejected};
+    telemetryEventHead = next;
+  } else {
+    telemetryDropped++;
+  }
+  telemetryEventMutex.give();
+}
+
+int telemetry_dropped() { return telemetryDropped; }
+
+void telemetryAdd(telemetry_channel channel, std::uint32_t now, const void *payload, int size) {
+  telemetryOutSize += telemetry_frame_encode(channel, telemetrySequence[channel]++, now, payload, size, &telemetryOut[telemetryOutSize]);
+}
+
+// A whole tick in one go. Frames that don't fit get dropped, never half sent
+void telemetryWrite() {
+  if (telemetryOutSize == 0) return;
+  if (telemetrySerial == nullptr) {
+    fwrite(telemetryOut, 1, telemetryOutSize, stdout);
+    fflush(stdout);
+  } else if (telemetrySerial->get_write_free() >= telemetryOutSize) {
+    telemetrySerial->write(telemetryOut, telemetryOutSize);
+  } else {
+    telemetryDropped++;
+  }
+  telemetryOutSize = 0;
+}
+
+void telemetry_task() {
+  int loop = loop_profile_register("telemetry", TELEMETRY_TICK);  // timing stats, see loop_profiler.hpp
+  int countdown[TELEMETRY_CHANNELS] = {};                          // ticks until each channel is due
+  while (true) {
+    loop_profile_start(loop);
+    if (telemetryOn) {
+      std::uint32_t now = pros::millis();
+      bool due[TELEMETRY_CHANNELS] = {};
+      for (int i = 0; i < TELEMETRY_CHANNELS; i++) {
+        if (telemetryRate[i] <= 0) continue;
+        if (--countdown[i] > 0) continue;
+        countdown[i] = 1000 / TELEMETRY_TICK / telemetryRate[i];  // 0 (too fast) sends every tick
+        due[i] = true;
+      }
+
+      if (due[TELEMETRY_POSE]) {
+        telemetry_pose pose = {(float)chassis.odom_x_get(), (float)chassis.odom_y_get(), (float)chassis.odom_theta_get()};
+        telemetryAdd(TELEMETRY_POSE, now, &pose, sizeof(pose));
+      }
+      if (due[TELEMETRY_PID]) {
+        telemetry_pid pid = {(float)chassis.leftPID.error, (float)chassis.turnPID.error, (float)chassis.swingPID.error, (float)error};
+        telemetryAdd(TELEMETRY_PID, now, &pid, sizeof(pid));
+      }
+      if (due[TELEMETRY_CURRENT]) {
+        telemetry_current current;
+        for (int i = 0; i < 3; i++) {
+          current.mA[i] = left_drive.get_current_draw(i);
+          current.mA[i + 3] = right_drive.get_current_draw(i);
+        }
+        current.mA[6] = intake.get_current_draw();
+        current.mA[7] = lb.get_current_draw();
+        telemetryAdd(TELEMETRY_CURRENT, now, &current, sizeof(current));
+      }
+      if (due[TELEMETRY_ARM]) {
+        telemetry_arm arm = {lbSensor.get_position(), target};
+        telemetryAdd(TELEMETRY_ARM, now, &arm, sizeof(arm));
+      }
+
+      // color events go out as soon as they're seen, whatever the rate says
+      telemetryEventMutex.take();
+      while (telemetryEventTail != telemetryEventHead) {
+        telemetryAdd(TELEMETRY_COLOR, now, &telemetryEvents[telemetryEventTail], sizeof(telemetry_color));
+        telemetryEventTail = (telemetryEventTail + 1) % TELEMETRY_EVENTS;
+      }
+      telemetryEventMutex.give();
+
+      telemetryWrite();
+    }
+    loop_profile_end(loop);
+    pros::delay(TELEMETRY_TICK);
+  }
+}
@@ -0,0 +1,161 @@
+#include "thermal_model.hpp"
+
+#include "subsystems.hpp"
+
+struct thermalConstants {
+  double heat = THERMAL_HEAT;
+  double cool = THERMAL_COOL;
+};
+
+thermal_motor_state thermalState[THERMAL_MOTORS];
+thermalConstants thermalK[THERMAL_MOTORS];
+bool thermalDerateOn = false;  // until thermal_replay passes on a real log
+bool thermalLogOn = false;
+pros::Mutex thermalMutex;
+const char *thermalNames[THERMAL_MOTORS] = {"L1", "L2", "L3", "R1", "R2", "R3", "IN", "LB"};
+
+// RAM buffer for the log, written out every few seconds (SD writes are slow)
+struct thermalLogRow {
+  int time;
+  short mA[THERMAL_MOTORS];
+  signed char reported[THERMAL_MOTORS];
+};
+const int THERMAL_LOG_ROWS = 50;  // 5 s of samples
+thermalLogRow thermalLog[THERMAL_LOG_ROWS];
+int thermalLogCount = 0;
+bool thermalLogHeaderDone = false;
+
+void thermal_constants_set(thermal_motor motor, double heat, double cool) {
+  thermalMutex.take();
+  thermalK[motor].heat = heat;
+  thermalK[motor].cool = cool;
+  thermalMutex.give();
+}
+
+void thermal_derate_enable(bool enable) {
+  thermalDerateOn = enable;
+}
+
+void thermal_log_enable(bool enable) {
+  thermalLogOn = enable;
+}
+
+thermal_motor_state thermal_state_get(thermal_motor motor) {
+  thermalMutex.take();
+  thermal_motor_state s = thermalState[motor];
+  thermalMutex.give();
+  return s;
+}
+
+int thermal_limit_get(thermal_motor motor) {
+  thermalMutex.take();
+  int limit = thermalState[motor].limit;
+  thermalMutex.give();
+  return limit;
+}
+
+const char *thermal_motor_name(thermal_motor motor) {
+  return thermalNames[motor];
+}
+
+thermal_motor thermal_worst_get() {
+  thermalMutex.take();
+  int worst = 0;
+  for (int i = 1; i < THERMAL_MOTORS; i++) {
+    // ties (everything cool = all INFINITY) go to whoever is hottest
+    const thermal_motor_state &a = thermalState[i], &b = thermalState[worst];
+    if (a.time_to_throttle < b.time_to_throttle || (a.time_to_throttle == b.time_to_throttle && a.temperature > b.temperature)) worst = i;
+  }
+  thermalMutex.give();
+  return (thermal_motor)worst;
+}
+
+// current (mA) + reported temperature (C) for one motor. false if the motor isn't there
+bool thermalRead(int motor, double &mA, double &reported) {
+  if (motor <= THERMAL_LEFT_3) {
+    mA = left_drive.get_current_draw(motor);
+    reported = left_drive.get_temperature(motor);
+  } else if (motor <= THERMAL_RIGHT_3) {
+    mA = right_drive.get_current_draw(motor - THERMAL_RIGHT_1);
+    reported = right_drive.get_temperature(motor - THERMAL_RIGHT_1);
+  } else if (motor == THERMAL_INTAKE) {
+    mA = intake.get_current_draw();
+    reported = intake.get_temperature();
+  } else {
+    mA = lb.get_current_draw();
+    reported = lb.get_temperature();
+  }
+  return mA != PROS_ERR && std::isfinite(reported) && reported < 150.0;
+}
+
+void thermalLogFlush() {
+  if (thermalLogCount == 0) return;
+  if (ez::util::SD_CARD_ACTIVE) {
+    FILE *file = fopen("/usd/thermal_log.csv", thermalLogHeaderDone ? "a" : "w");
+    if (file != nullptr) {
+      // a new file every time the program starts, the replay expects one continuous run
+      if (!thermalLogHeaderDone) {
+        fprintf(file, "time_ms");
+        for (int m = 0; m < THERMAL_MOTORS; m++) fprintf(file, ",%s_ma,%s_c", thermalNames[m], thermalNames[m]);
+        fprintf(file, "\n");
+        thermalLogHeaderDone = true;
+      }
+      for (int i = 0; i < thermalLogCount; i++) {
+        fprintf(file, "%d", thermalLog[i].time);
+        for (int m = 0; m < THERMAL_MOTORS; m++) fprintf(file, ",%d,%d", thermalLog[i].mA[m], thermalLog[i].reported[m]);
+        fprintf(file, "\n");
+      }
+      fclose(file);
+    }
+  }
+  thermalLogCount = 0;
+}
+
+void thermal_task() {
+  const double dt = THERMAL_SAMPLE_TIME / 1000.0;
+  const double currentAlpha = dt / (THERMAL_CURRENT_FILTER_TIME + dt);
+  bool started[THERMAL_MOTORS] = {};
+
+  while (true) {
+    thermalLogRow row = {};
+    row.time = pros::millis();
+
+    thermalMutex.take();
+    for (int m = 0; m < THERMAL_MOTORS; m++) {
+      double mA, reported;
+      row.reported[m] = THERMAL_LOG_ABSENT;
+      if (!thermalRead(m, mA, reported)) continue;  // unplugged, keep the old estimate
+      row.mA[m] = mA;
+      row.reported[m] = reported;
+
+      thermal_motor_state &s = thermalState[m];
+      const thermalConstants &k = thermalK[m];
+      double amps = std::fabs(mA) / 1000.0;
+      // first reading: the middle of whatever step it reports (a motor can start warm from the last match)
+      s.temperature = started[m] ? thermal_step(s.temperature, amps, THERMAL_AMBIENT, k.heat, k.cool, dt) : reported + THERMAL_SENSOR_STEP / 2.0;
+      s.temperature = thermal_correct(s.temperature, reported);
+      s.reported = reported;
+      // RMS, heat goes with I^2 (half the time at 1.8 A and half at 0.4 A averages 1.1 A but heats like 1.3 A)
+      s.current = started[m] ? std::sqrt(s.current * s.current + currentAlpha * (amps * amps - s.current * s.current)) : amps;
+      s.time_to_throttle = thermal_time_to(s.temperature, s.current, THERMAL_AMBIENT, k.heat, k.cool, THERMAL_THROTTLE_TEMP);
+      started[m] = true;
+
+      // ease the limit down to what makes it through the horizon, and back up once it doesn't need to
+      double wanted = THERMAL_MAX_MA;
+      if (thermalDerateOn && s.time_to_throttle < THERMAL_HORIZON) {
+        double allowed = thermal_current_for(s.temperature, THERMAL_AMBIENT, k.heat, k.cool, THERMAL_LIMIT_TEMP, THERMAL_HORIZON);
+        wanted = std::fmin(std::fmax(allowed * 1000.0, (double)THERMAL_MIN_MA), (double)THERMAL_MAX_MA);
+      }
+      double step = THERMAL_DERATE_RATE * dt;
+      s.limit = std::round(s.limit + std::fmin(std::fmax(wanted - s.limit, -step), step));
+    }
+    thermalMutex.give();
+
+    if (thermalLogOn) {
+      thermalLog[thermalLogCount++] = row;
+      if (thermalLogCount == THERMAL_LOG_ROWS) thermalLogFlush();
+    }
+
+    pros::delay(THERMAL_SAMPLE_TIME);
+  }
+}
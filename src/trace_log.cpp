@@ -0,0 +1,242 @@
+#include "trace_log.hpp"
+
+#include <atomic>
+#include <cstring>
+
+#include "subsystems.hpp"
+
+// Any task can add to the buffer, only trace_task (or trace_enable) takes out of it. Writers grab a slot with
+// one atomic add, so there's no mutex on the hot path. The writer stays TRACE_SLACK slots behind the newest
+// so it doesn't save a record that's still being filled in
+bool traceOn = false;
+trace_record traceBuffer[TRACE_BUFFER];
+std::atomic<std::uint32_t> traceHead(0);
+std::atomic<std::uint32_t> traceTail(0);
+std::atomic<int> traceDropped(0);
+FILE *traceFile = nullptr;
+pros::Mutex traceMutex;  // the file + the task table
+
+// Task table. Slot 0 is the made up "drive" row. Handles are checked without the mutex, so the handle gets
+// filled in before the count goes up
+void *traceTasks[TRACE_TASKS_MAX] = {};
+char traceTaskNames[TRACE_TASKS_MAX][TRACE_NAME_LENGTH] = {"drive"};
+bool traceTaskNamed[TRACE_TASKS_MAX] = {};  // name is in the file already
+std::atomic<int> traceTaskCount(1);
+
+const char *traceEventNames[TRACE_EVENTS] = {"auton", "pid_wait", "motion", "loop", "arm", "color_detect", "color_eject"};
+
+// id of the calling task, -1 if it isn't in the table yet
+int traceTaskFind(void *me) {
+  int count = traceTaskCount;
+  for (int i = 1; i < count; i++)
+    if (traceTasks[i] == me) return i;
+  return -1;
+}
+
+// adds the calling task if it's new and names it (nullptr = whatever PROS calls it)
+int traceTaskAdd(const char *name) {
+  void *me = pros::c::task_get_current();
+  traceMutex.take();
+  int task = traceTaskFind(me);
+  if (task < 0 && traceTaskCount < TRACE_TASKS_MAX) {
+    task = traceTaskCount;
+    traceTasks[task] = me;
+    traceTaskCount = task + 1;
+    if (name == nullptr) name = pros::c::task_get_name(me);
+  }
+  if (task < 0) {
+    task = TRACE_TASKS_MAX;  // full, the converter calls it "task 32"
+  } else if (name != nullptr) {
+    std::strncpy(traceTaskNames[task], name, TRACE_NAME_LENGTH - 1);
+    traceTaskNamed[task] = false;  // tasks that get made every auton can reuse an old handle, write it again
+  }
+  traceMutex.give();
+  return task;
+}
+
+void traceRecord(trace_event event, char phase, int arg, int task) {
+  std::uint32_t now = pros::micros();
+  if (traceHead - traceTail >= (std::uint32_t)(TRACE_BUFFER - TRACE_SLACK)) {
+    traceDropped++;
+    return;
+  }
+  trace_record &r = traceBuffer[traceHead.fetch_add(1) % TRACE_BUFFER];
+  r.time = now;
+  r.arg = arg;
+  r.event = event;
+  r.phase = phase;
+  r.task = task;
+  r.spare = 0;
+}
+
+void trace_write(trace_event event, char phase, int arg) {
+  int task = traceTaskFind(pros::c::task_get_current());
+  if (task < 0) task = traceTaskAdd(nullptr);  // only the first event from each task
+  traceRecord(event, phase, arg, task);
+}
+
+void trace_task_name(const char *name) {
+  traceTaskAdd(name);
+}
+
+// call with traceMutex taken
+void traceWriteName(char phase, int id, const char *name) {
+  trace_record r = {0, 0, (std::uint8_t)id, (std::uint8_t)phase, (std::uint8_t)id, 0};
+  char padded[TRACE_NAME_LENGTH] = {};
+  std::strncpy(padded, name, TRACE_NAME_LENGTH - 1);
+  fwrite(&r, sizeof(r), 1, traceFile);
+  fwrite(padded, 1, TRACE_NAME_LENGTH, traceFile);
+}
+
+// call with traceMutex taken. all = everything, even the newest TRACE_SLACK records
+void traceFlush(bool all) {
+  if (traceFile == nullptr) return;
+  int count = traceTaskCount;
+  for (int i = 0; i < count; i++) {
+    if (traceTaskNamed[i]) continue;
+    traceWriteName(TRACE_TASK_NAME, i, traceTaskNames[i]);
+    traceTaskNamed[i] = true;
+  }
+
+  std::uint32_t head = traceHead, tail = traceTail;
+  if (!all) head = head - tail > (std::uint32_t)TRACE_SLACK ? head - TRACE_SLACK : tail;
+  while (tail != head) {
+    // up to the end of the buffer at a time
+    std::uint32_t start = tail % TRACE_BUFFER;
+    std::uint32_t n = head - tail;
+    if (n > TRACE_BUFFER - start) n = TRACE_BUFFER - start;
+    fwrite(&traceBuffer[start], sizeof(trace_record), n, traceFile);
+    tail += n;
+  }
+  traceTail = tail;
+  fflush(traceFile);
+}
+
+void trace_enable(bool enable) {
+  traceMutex.take();
+  traceOn = false;
+  if (traceFile != nullptr) {
+    traceFlush(true);
+    fclose(traceFile);
+    traceFile = nullptr;
+  }
+  if (enable && ez::util::SD_CARD_ACTIVE) traceFile = fopen("/usd/trace.bin", "wb");
+  if (traceFile != nullptr) {
+    fwrite("EZTRACE1", 1, 8, traceFile);
+    for (int i = 0; i < TRACE_EVENTS; i++) traceWriteName(TRACE_EVENT_NAME, i, traceEventNames[i]);
+    for (int i = 0; i < TRACE_TASKS_MAX; i++) traceTaskNamed[i] = false;  // new file, every name again
+    traceHead = 0;
+    traceTail = 0;
+    traceDropped = 0;
+    traceOn = true;
+  }
+  traceMutex.give();
+}
+
+bool trace_enabled() {
+  return traceOn;
+}
+
+int trace_dropped() {
+  return traceDropped;
+}
+
+// The current motion's target, whichever PID that lives in. A new target in the same mode is a new motion
+double traceMotionTarget(ez::e_mode mode) {
+  if (mode == ez::TURN) return chassis.turnPID.target_get();
+  if (mode == ez::SWING) return chassis.swingPID.target_get();
+  return chassis.leftPID.target_get();
+}
+
+// EZ-Template only checks the exit conditions inside pid_wait() and keeps their timers private, so trace_task
+// keeps its own copies of the motion's PIDs (same constants, their own timers) and feeds them the real ones'
+// error every tick. Drive checks both sides, like pid_wait. Odom motions only get xy, the angle only counts
+// for boomerang and that can't be told from out here
+struct traceExitWatch {
+  ez::PID *real[2] = {nullptr, nullptr};
+  ez::PID copy[2];
+  bool exited[2] = {true, true};
+};
+traceExitWatch traceExit;
+
+void traceExitStart(ez::e_mode mode) {
+  traceExit = traceExitWatch();
+  if (mode == ez::DRIVE) {
+    traceExit.real[0] = &chassis.leftPID;
+    traceExit.real[1] = &chassis.rightPID;
+  } else if (mode == ez::TURN || mode == ez::TURN_TO_POINT) {
+    traceExit.real[0] = &chassis.turnPID;
+  } else if (mode == ez::SWING) {
+    traceExit.real[0] = &chassis.swingPID;
+  } else if (mode == ez::POINT_TO_POINT || mode == ez::PURE_PURSUIT) {
+    traceExit.real[0] = &chassis.xyPID;
+  }
+  for (int i = 0; i < 2; i++) {
+    if (traceExit.real[i] == nullptr) continue;
+    traceExit.copy[i] = *traceExit.real[i];
+    traceExit.copy[i].timers_reset();
+    traceExit.exited[i] = false;
+  }
+}
+
+// one tick of the exit conditions, true once every PID the motion has is done
+bool traceExitTick() {
+  bool done = true;
+  for (int i = 0; i < 2; i++) {
+    if (traceExit.exited[i]) continue;
+    ez::PID &copy = traceExit.copy[i], &real = *traceExit.real[i];
+    copy.error = real.error;
+    copy.cur = real.cur;
+    copy.derivative = real.derivative;
+    copy.velocity_sensor_secondary_set(real.velocity_sensor_secondary_get());
+    // mA timeout off the side's first motor, like pid_wait for drive motions
+    ez::exit_output exit = copy.exit_condition(i == 0 ? chassis.left_motors.front() : chassis.right_motors.front());
+    traceExit.exited[i] = exit != ez::RUNNING;
+    done = done && traceExit.exited[i];
+  }
+  return done;
+}
+
+void trace_task() {
+  ez::e_mode lastMode = ez::DISABLE;
+  double lastTarget = 0.0;
+  bool moving = false;
+  bool waiting = false;
+  int motion = 0;  // motions since the trace was turned on
+  int flushTimer = 0;
+  while (true) {
+    if (traceOn) {
+      ez::e_mode mode = chassis.drive_mode_get();
+      double target = traceMotionTarget(mode);
+      if (mode != lastMode || target != lastTarget) {
+        if (waiting) traceRecord(TRACE_PID_WAIT, TRACE_END, motion, TRACE_DRIVE_TASK);  // next one came first
+        if (moving) traceRecord(TRACE_MOTION, TRACE_END, lastMode, TRACE_DRIVE_TASK);
+        moving = waiting = mode != ez::DISABLE;
+        if (moving) {
+          motion++;
+          traceRecord(TRACE_MOTION, TRACE_BEGIN, mode, TRACE_DRIVE_TASK);
+          traceRecord(TRACE_PID_WAIT, TRACE_BEGIN, motion, TRACE_DRIVE_TASK);
+          traceExitStart(mode);
+        }
+      } else if (waiting && traceExitTick()) {
+        traceRecord(TRACE_PID_WAIT, TRACE_END, motion, TRACE_DRIVE_TASK);
+        waiting = false;
+      }
+      lastMode = mode;
+      lastTarget = target;
+    } else {
+      moving = waiting = false;  // the converter closes whatever was still open when the trace stopped
+      lastMode = ez::DISABLE;
+      motion = 0;
+    }
+
+    flushTimer += TRACE_OBSERVE_TIME;
+    if (flushTimer >= TRACE_FLUSH_TIME) {
+      flushTimer = 0;
+      traceMutex.take();
+      traceFlush(false);
+      traceMutex.give();
+    }
+    pros::delay(TRACE_OBSERVE_TIME);
+  }
+}
@@ -0,0 +1,126 @@
+#include "tracker_calibration.hpp"
+
+#include "subsystems.hpp"
+
+struct trackerEntry {
+  std::string name;
+  ez::tracking_wheel *tracker;
+};
+std::vector<trackerEntry> calibrationTrackers;
+
+void tracker_calibration_register(std::string name, ez::tracking_wheel *tracker) {
+  calibrationTrackers.push_back({name, tracker});
+}
+
+// file is one tracker per line: name distance_to_center wheel_diameter
+bool tracker_calibration_load() {
+  if (!ez::util::SD_CARD_ACTIVE) return false;
+  FILE *file = fopen(TRACKER_CALIBRATION_FILE.c_str(), "r");
+  if (file == nullptr) return false;
+
+  char name[32];
+  double distance, diameter;
+  while (fscanf(file, "%31s %lf %lf", name, &distance, &diameter) == 3) {
+    for (auto &entry : calibrationTrackers) {
+      if (entry.name != name) continue;
+      entry.tracker->wheel_diameter_set(diameter);
+      entry.tracker->distance_to_center_set(distance);
+      printf("Loaded %s tracker: distance %.3f diameter %.4f\n", name, distance, diameter);
+    }
+  }
+  fclose(file);
+  return true;
+}
+
+bool tracker_calibration_save() {
+  if (!ez::util::SD_CARD_ACTIVE) return false;
+  FILE *file = fopen(TRACKER_CALIBRATION_FILE.c_str(), "w");
+  if (file == nullptr) return false;
+  for (auto &entry : calibrationTrackers)
+    fprintf(file, "%s %.4f %.5f\n", entry.name.c_str(), entry.tracker->distance_to_center_get(), entry.tracker->wheel_diameter_get());
+  fclose(file);
+  return true;
+}
+
+void tracker_calibrate_diameter(double distance) {
+  std::vector<double> start;
+  for (auto &entry : calibrationTrackers) start.push_back(entry.tracker->get());
+
+  controller.clear();
+  pros::delay(50);
+  controller.set_text(0, 0, "Push " + ez::util::to_string_with_precision(distance, 0) + "in, then L2");
+  while (!controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L2)) pros::delay(ez::util::DELAY_TIME);  // L2 isn't used by anything else
+
+  for (int i = 0; i < (int)calibrationTrackers.size(); i++) {
+    ez::tracking_wheel *tracker = calibrationTrackers[i].tracker;
+    double reported = tracker->get() - start[i];
+    // horizontal wheels don't roll when pushed straight, leave them alone
+    if (std::fabs(reported) < distance / 4.0) continue;
+    double diameter = tracker_diameter_solve(tracker->wheel_diameter_get(), reported, distance);
+    printf("%s tracker: reported %.3f in, diameter %.4f -> %.4f\n", calibrationTrackers[i].name.c_str(), reported, tracker->wheel_diameter_get(), diameter);
+    tracker->wheel_diameter_set(diameter);
+  }
+  tracker_calibration_save();
+  controller.set_text(0, 0, "Diameter saved     ");
+}
+
+void tracker_calibrate_spin(int rotations, int speed) {
+  std::vector<std::vector<tracker_spin_sample>> samples(calibrationTrackers.size());
+
+  // both directions so anything direction dependent (IMU drift, the robot walking while it spins) averages out
+  for (int direction : {1, -1}) {
+    double imuStart = chassis.drive_imu_get();
+    std::vector<double> start;
+    for (auto &entry : calibrationTrackers) start.push_back(entry.tracker->get());
+
+    chassis.drive_set(speed * direction, -speed * direction);
+    int startTime = pros::millis();
+    int checkedTime = startTime;
+    double checked = imuStart;
+    const char *abort = nullptr;
+    while (std::fabs(chassis.drive_imu_get() - imuStart) < rotations * 360.0 - 15.0) {
+      int now = pros::millis();
+      double heading = chassis.drive_imu_get();
+      if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L2)) abort = "stopped";
+      else if (std::isinf(heading) || std::isnan(heading)) abort = "IMU lost";
+      else if (now - startTime > TRACKER_SPIN_TIMEOUT) abort = "timed out";
+      else if (now - checkedTime >= TRACKER_SPIN_STALL_TIME) {
+        if (std::fabs(heading - checked) < TRACKER_SPIN_STALL_DEGREES) abort = "not turning";
+        checked = heading;
+        checkedTime = now;
+      }
+      if (abort != nullptr) break;
+      pros::delay(ez::util::DELAY_TIME);
+    }
+    chassis.drive_set(0, 0);
+    if (abort != nullptr) {
+      // nothing gets saved, the old values are still in
+      printf("Tracker spin %s, nothing changed\n", abort);
+      std::string text = "Spin " + std::string(abort);
+      text.resize(19, ' ');
+      controller.set_text(0, 0, text);
+      return;
+    }
+    pros::delay(750);  // let it coast to a stop, both the IMU and wheels see the coast
+
+    double turned = chassis.drive_imu_get() - imuStart;
+    for (int i = 0; i < (int)calibrationTrackers.size(); i++) {
+      tracker_spin_sample sample;
+      sample.imu_degrees = turned;
+      sample.travel = calibrationTrackers[i].tracker->get() - start[i];
+      samples[i].push_back(sample);
+    }
+  }
+
+  for (int i = 0; i < (int)calibrationTrackers.size(); i++) {
+    ez::tracking_wheel *tracker = calibrationTrackers[i].tracker;
+    double offset = tracker_offset_solve(samples[i]);
+    double distance = tracker_distance_signed(offset, tracker->distance_to_center_flip_get());
+    printf("%s tracker: distance to center %.3f -> %.3f (raw fit %.3f)\n", calibrationTrackers[i].name.c_str(), tracker->distance_to_center_get(), distance, offset);
+    if (tracker->distance_to_center_get() * distance < 0.0)
+      printf("%s tracker: the sign changed from what was typed in, the typed one was wrong\n", calibrationTrackers[i].name.c_str());
+    tracker->distance_to_center_set(distance);
+  }
+  tracker_calibration_save();
+  controller.set_text(0, 0, "Trackers saved     ");
+}
@@ -0,0 +1,92 @@
+#include "traction_control.hpp"
+
+#include "feedforward.hpp"
+#include "subsystems.hpp"
+
+bool tractionOn = false;
+double tractionLaunchAccel = 0.0;  // in/s^2, 0 = use the drive feedforward max_accel
+double tractionSlipTarget = TRACTION_SLIP_TARGET;
+traction_state tractionState;
+pros::Mutex tractionMutex;
+
+// last tick's sensors, everything gets differentiated off these
+std::uint32_t tractionLastTime = 0;
+double tractionLastLeft = 0.0, tractionLastRight = 0.0, tractionLastTracker = 0.0, tractionLastHeading = 0.0;
+
+const double INCHES_PER_G = 386.09;
+const double MAX_TICK_GAP = 0.05;  // s, a gap longer than this (traction was off, auton ran) starts the estimate over
+
+void traction_control_enable(bool enable) {
+  tractionOn = enable;
+}
+
+bool traction_control_enabled() {
+  return tractionOn;
+}
+
+void traction_launch_set(double accel, double slip_target) {
+  tractionLaunchAccel = std::fabs(accel);
+  tractionSlipTarget = std::fabs(slip_target);
+}
+
+traction_state traction_control_state_get() {
+  tractionMutex.take();
+  traction_state s = tractionState;
+  tractionMutex.give();
+  return s;
+}
+
+void traction_control_iterate(int &left, int &right) {
+  if (!tractionOn) return;
+  std::uint32_t start = pros::micros();
+
+  std::uint32_t now = pros::millis();
+  double leftPos = chassis.drive_sensor_left();
+  double rightPos = chassis.drive_sensor_right();
+  double trackerPos = vert_tracker.get();
+  double heading = chassis.drive_imu_get();
+  double dt = (now - tractionLastTime) / 1000.0;
+
+  tractionMutex.take();
+  traction_state &s = tractionState;
+  if (tractionLastTime == 0 || dt <= 0.0 || dt > MAX_TICK_GAP) {
+    // nothing to differentiate against yet, start from rest
+    s.left = s.right = traction_side();
+    s.ground_speed = 0.0;
+  } else {
+    s.left.wheel_speed = (leftPos - tractionLastLeft) / dt;
+    s.right.wheel_speed = (rightPos - tractionLastRight) / dt;
+    double omega = (heading - tractionLastHeading) * M_PI / 180.0 / dt;  // rad/s, clockwise like the IMU
+
+    // the tracker sees the robot's speed plus whatever turning adds at its offset from the center
+    double offset = vert_tracker.distance_to_center_get() * (vert_tracker.distance_to_center_flip_get() ? -1.0 : 1.0);
+    double trackerSpeed = (trackerPos - tractionLastTracker) / dt + omega * offset;
+
+    pros::imu_accel_s_t a = chassis.imu.get_accel();
+    double accel = (TRACTION_IMU_FORWARD_AXIS == 0 ? a.x : a.y) * TRACTION_IMU_FORWARD_SIGN * INCHES_PER_G;
+    if (!std::isfinite(accel) || std::fabs(accel) > 10.0 * INCHES_PER_G) accel = 0.0;  // IMU unplugged/errored
+
+    // complementary filter: IMU for the fast part, tracker keeps it from drifting
+    double alpha = TRACTION_GROUND_FILTER / (TRACTION_GROUND_FILTER + dt);
+    s.ground_speed = alpha * (s.ground_speed + accel * dt) + (1.0 - alpha) * trackerSpeed;
+    s.ground_accel = accel;
+
+    // turning clockwise the left side goes faster than the center, the right side slower
+    double width = chassis.drive_width_get() > 1.0 ? chassis.drive_width_get() : TRACTION_DRIVE_WIDTH;
+    s.left.ground_speed = s.ground_speed + omega * width / 2.0;
+    s.right.ground_speed = s.ground_speed - omega * width / 2.0;
+
+    feedforward_constants ff = feedforward_constants_get(ez::DRIVE);
+    double launchAccel = tractionLaunchAccel > 0.0 ? tractionLaunchAccel : ff.max_accel;
+    left = traction_side_step(s.left, left, dt, ff.kS, ff.kV, ff.kA, launchAccel, tractionSlipTarget);
+    right = traction_side_step(s.right, right, dt, ff.kS, ff.kV, ff.kA, launchAccel, tractionSlipTarget);
+  }
+  s.loop_us += 0.05 * ((int)(pros::micros() - start) - s.loop_us);
+  tractionMutex.give();
+
+  tractionLastTime = now;
+  tractionLastLeft = leftPos;
+  tractionLastRight = rightPos;
+  tractionLastTracker = trackerPos;
+  tractionLastHeading = heading;
+}
@@ -0,0 +1,117 @@
+// Tiny benchmark harness for the host benchmarks in tools/bench (Google Benchmark would be one more thing to
+// install on every laptop). Each benchmark gets run in batches big enough to take BENCH_SAMPLE_NS, BENCH_SAMPLES
+// times. Baselines get compared on the fastest batch: anything else running on the laptop only ever makes a
+// batch slower, so the fastest one is what barely moves between runs. Median and spread are printed to show
+// how noisy the run was.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+const double BENCH_SAMPLE_NS = 10e6;  // each batch runs at least 10 ms
+const int BENCH_SAMPLES = 21;
+const long BENCH_ITERATIONS_MAX = 1L << 30;
+const double BENCH_NOISE_NS = 0.5;    // differences under this are the clock, not the code
+
+struct bench_result {
+  std::string name;
+  double median = 0;  // ns per call
+  double min = 0;     // ns per call, fastest batch
+  double mad = 0;     // ns, median absolute deviation of the batches
+  long iterations = 0;  // calls per batch
+};
+
+// Makes the compiler think v gets used, so the call doesn't get optimized out
+template <class T>
+inline void bench_keep(const T &v) {
+  asm volatile("" : : "r,m"(v) : "memory");
+}
+
+template <class F>
+double benchBatch(F &fn, long iterations) {
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < iterations; i++) {
+    fn(i);
+    asm volatile("" : : : "memory");  // keeps the loop even if fn turns out to be nothing
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// fn(i) is one call, i is the iteration so it can walk through inputs
+template <class F>
+bench_result bench_run(const char *name, F fn) {
+  bench_result r;
+  r.name = name;
+  r.iterations = 1;
+  while (benchBatch(fn, r.iterations) < BENCH_SAMPLE_NS && r.iterations < BENCH_ITERATIONS_MAX) r.iterations *= 2;  // also warms up the caches
+
+  std::vector<double> ns;
+  for (int s = 0; s < BENCH_SAMPLES; s++) ns.push_back(benchBatch(fn, r.iterations) / r.iterations);
+  std::sort(ns.begin(), ns.end());
+  r.median = ns[ns.size() / 2];
+  r.min = ns[0];
+  std::vector<double> dev;
+  for (double n : ns) dev.push_back(std::fabs(n - r.median));
+  std::sort(dev.begin(), dev.end());
+  r.mad = dev[dev.size() / 2];
+  printf("%-34s %10.2f ns  (median %.2f, mad %.2f, %ld per batch)\n", name, r.min, r.median, r.mad, r.iterations);
+  return r;
+}
+
+inline bool bench_save(const char *path, const std::vector<bench_result> &results) {
+  FILE *file = fopen(path, "w");
+  if (file == nullptr) return false;
+  fprintf(file, "{\n  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const bench_result &r = results[i];
+    fprintf(file, "    {\"name\": \"%s\", \"median_ns\": %.4f, \"min_ns\": %.4f, \"mad_ns\": %.4f, \"iterations\": %ld}%s\n",
+            r.name.c_str(), r.median, r.min, r.mad, r.iterations, i + 1 < results.size() ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+  fclose(file);
+  return true;
+}
+
+// Reads back what bench_save wrote (only that, it's not a real JSON parser)
+inline std::vector<bench_result> bench_load(const char *path) {
+  std::vector<bench_result> results;
+  FILE *file = fopen(path, "r");
+  if (file == nullptr) return results;
+  char line[512];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    char name[128];
+    bench_result r;
+    if (sscanf(line, " {\"name\": \"%127[^\"]\", \"median_ns\": %lf, \"min_ns\": %lf, \"mad_ns\": %lf, \"iterations\": %ld",
+               name, &r.median, &r.min, &r.mad, &r.iterations) == 5) {
+      r.name = name;
+      results.push_back(r);
+    }
+  }
+  fclose(file);
+  return results;
+}
+
+// Prints old vs new, returns how many got slower by more than tolerance (0.15 = 15%)
+inline int bench_compare(const std::vector<bench_result> &baseline, const std::vector<bench_result> &results, double tolerance) {
+  int regressions = 0;
+  printf("\n%-34s %10s %10s %8s\n", "vs baseline (fastest)", "old ns", "new ns", "change");
+  for (const bench_result &r : results) {
+    const bench_result *old = nullptr;
+    for (const bench_result &b : baseline)
+      if (b.name == r.name) old = &b;
+    if (old == nullptr) {
+      printf("%-34s %10s %10.2f %8s\n", r.name.c_str(), "-", r.min, "new");
+      continue;
+    }
+    double change = (r.min - old->min) / old->min;
+    bool slower = change > tolerance && r.min - old->min > BENCH_NOISE_NS;
+    regressions += slower;
+    printf("%-34s %10.2f %10.2f %+7.1f%%%s\n", r.name.c_str(), old->min, r.min, 100 * change, slower ? "  SLOWER" : "");
+  }
+  return regressions;
+}
@@ -0,0 +1,53 @@
+// Host benchmark for the field raycast (src/field_model.cpp)
+// Build + run from the repo root:
+//   g++ -std=gnu++20 -O2 -Iinclude -U_GNU_SOURCE -D_GNU_SOURCE= tools/bench/field_model_bench.cpp src/field_model.cpp tools/host/pros_stubs.cpp -o field_model_bench && ./field_model_bench
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "field_model.hpp"
+
+int main() {
+  field_model field = field_model_high_stakes();
+
+  // sanity checks against hand math
+  bool ok = true;
+  double toPost = field_raycast(field, 0, 0, 0, DISTANCE_SENSOR_MAX_RANGE);  // ladder post at (0, 24), r 1.25
+  double toWall = field_raycast(field, 30, 60, 0, DISTANCE_SENSOR_MAX_RANGE);  // wall at y = 70.2
+  double toStake = field_raycast(field, 0, 60, 0, DISTANCE_SENSOR_MAX_RANGE);  // neutral stake at (0, 68.7), r 1.5
+  double toCorner = field_raycast(field, -60, 60, -45, DISTANCE_SENSOR_MAX_RANGE);  // 45 deg into the corner
+  ok &= std::fabs(toPost - 22.75) < 1e-6;
+  ok &= std::fabs(toWall - 10.2) < 1e-6;
+  ok &= std::fabs(toStake - 7.2) < 1e-6;
+  ok &= std::fabs(toCorner - 10.2 * std::sqrt(2.0)) < 1e-6;
+  printf("post %.3f  wall %.3f  stake %.3f  corner %.3f  -> %s\n", toPost, toWall, toStake, toCorner, ok ? "ok" : "WRONG");
+
+  // 4 sensors (front, back, left, right) and a particle cloud worth of poses
+  distance_sensor_mount mounts[4];
+  mounts[0].y = 6;
+  mounts[1].y = -6, mounts[1].theta = 180;
+  mounts[2].x = -6, mounts[2].theta = -90;
+  mounts[3].x = 6, mounts[3].theta = 90;
+
+  const int POSES = 500;
+  std::mt19937 rng(1380);
+  std::uniform_real_distribution<double> xy(-66, 66), theta(0, 360);
+  std::vector<ez::pose> poses(POSES);
+  for (auto &p : poses) p = {xy(rng), xy(rng), theta(rng)};
+  std::vector<double> out(POSES * 4);
+
+  const int ROUNDS = 2000;
+  double checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS; i++) {
+    field_expected_ranges(field, poses.data(), POSES, mounts, 4, out.data());
+    checksum += out[i % out.size()];
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  double perRay = ns / (double(ROUNDS) * POSES * 4);
+  printf("%d poses x 4 sensors: %.1f us per call, %.1f ns per ray (checksum %.1f)\n", POSES, ns / ROUNDS / 1000.0, perRay, checksum);
+  return ok ? 0 : 1;
+}
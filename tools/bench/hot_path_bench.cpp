@@ -0,0 +1,201 @@
+// Host benchmarks for the math that runs every tick on the robot, so a change that makes a control loop more
+// expensive shows up here before it shows up on the loop profiler (include/loop_profiler.hpp).
+// Our own per-tick code (the stuff in the headers marked "pure math", the field raycast) plus the library math
+// every motion runs. EZ-Template only comes as an ARM archive in the PROS template, so its rows time the host port
+// in tools/host/sim_ez.cpp, which is the same math but not the same build. okapi's median/average filters are
+// header only and get timed as they are. okapi's EKFFilter and VelMath and squiggles' SplineGenerator are only in
+// the archives, there's nothing to time on a laptop, the loop profiler is the only number for those.
+// Build + run from the repo root (Release flags, see tools/bench/Makefile):
+//   make -C tools/bench                 # just run
+//   make -C tools/bench baseline        # run and save tools/bench/baseline.json
+//   make -C tools/bench check           # run and fail if anything got >15% slower than the baseline
+// Or by hand:
+//   g++ -std=gnu++20 -O2 -DNDEBUG -Iinclude -Itools/host -U_GNU_SOURCE -D_GNU_SOURCE= tools/bench/hot_path_bench.cpp src/field_model.cpp \
+//     tools/host/sim_ez.cpp tools/host/pros_stubs.cpp -o hot_path_bench
+//   ./hot_path_bench [--save baseline.json] [--check baseline.json] [--tolerance 0.15]
+// Baselines only mean something on the machine that saved them, so each laptop keeps its own.
+#include <cstdlib>
+#include <random>
+
+#include "bench.hpp"
+#include "cpu_usage.hpp"
+#include "field_model.hpp"
+#include "gain_schedule.hpp"
+#include "joystick_lut.hpp"
+#include "loop_profiler.hpp"
+#include "okapi/api/filter/averageFilter.hpp"
+#include "okapi/api/filter/medianFilter.hpp"
+#include "power_manager.hpp"
+#include "sim_ez.hpp"
+#include "telemetry.hpp"
+#include "thermal_model.hpp"
+#include "trace_log.hpp"
+#include "traction_control.hpp"
+
+// trace_log.cpp needs the robot, the benchmark only measures the check every event does when tracing is off
+bool traceOn = false;
+void trace_write(trace_event, char, int) {}
+okapi::Filter::~Filter() = default;  // out of line in okapi, only the archive has it
+
+const int INPUTS = 1024;  // power of 2, inputs get walked with i & (INPUTS - 1)
+
+int main(int argc, char **argv) {
+  const char *save = nullptr, *check = nullptr;
+  double tolerance = 0.15;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc) save = argv[++i];
+    else if (std::strcmp(argv[i], "--check") == 0 && i + 1 < argc) check = argv[++i];
+    else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) tolerance = std::atof(argv[++i]);
+  }
+
+  // random but the same every run
+  std::mt19937 rng(1380);
+  std::uniform_int_distribution<int> stick(-127, 127);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  int sticks[INPUTS];
+  double speeds[INPUTS], commands[INPUTS], temps[INPUTS], amps[INPUTS];
+  for (int i = 0; i < INPUTS; i++) {
+    sticks[i] = stick(rng);
+    speeds[i] = 60.0 * unit(rng) - 10.0;       // in/s
+    commands[i] = 24000.0 * unit(rng) - 12000.0;  // mV
+    temps[i] = 25.0 + 30.0 * unit(rng);          // C
+    amps[i] = 2.5 * unit(rng);
+  }
+  const int M = INPUTS - 1;
+
+  std::vector<bench_result> results;
+
+  // opcontrol, 10 ms: joystick curve, per stick
+  static const joystick_lut lut = joystick_lut_make(2.1);
+  results.push_back(bench_run("joystick_lut_apply", [&](long i) { bench_keep(joystick_lut_apply(lut, sticks[i & M])); }));
+  results.push_back(bench_run("joystick_lut_curve (no table)", [&](long i) { bench_keep(joystick_lut_curve(sticks[i & M], 2.1)); }));
+
+  // opcontrol, 10 ms: traction control, per side
+  traction_side side;
+  results.push_back(bench_run("traction_side_step", [&](long i) {
+    side.ground_speed = speeds[i & M];
+    side.wheel_speed = speeds[(i + 7) & M];
+    bench_keep(traction_side_step(side, sticks[i & M], 0.01, 600, 157, 20, 300, TRACTION_SLIP_TARGET));
+    bench_keep(side);
+  }));
+
+  // every motion, 10 ms: EZ-Template's PID + slew for one side, and the angle math turns and odom motions run
+  ez::PID pid(0.45, 0.0, 5.0, 0.0, "drive");
+  pid.target_set(24.0);
+  results.push_back(bench_run("ez_pid_compute", [&](long i) { bench_keep(pid.compute(speeds[i & M])); }));
+  results.push_back(bench_run("ez_pid_compute_error", [&](long i) { bench_keep(pid.compute_error(commands[i & M] / 500.0, speeds[i & M])); }));
+  ez::slew slew(3.0, 70);
+  results.push_back(bench_run("ez_slew_iterate", [&](long i) {
+    if ((i & 63) == 0) slew.initialize(true, 110, 24.0, 0.0);  // a fresh ramp every so often, or it's just the max speed
+    bench_keep(slew.iterate((i & 63) * 0.05));
+  }));
+  results.push_back(bench_run("ez_wrap_angle", [&](long i) { bench_keep(ez::util::wrap_angle(12.0 * speeds[i & M])); }));
+  results.push_back(bench_run("ez_turn_shortest+longest", [&](long i) {
+    bench_keep(ez::util::turn_shortest(6.0 * temps[i & M], 12.0 * speeds[i & M]));
+    bench_keep(ez::util::turn_longest(6.0 * temps[i & M], 12.0 * speeds[i & M]));
+  }));
+  results.push_back(bench_run("ez_point_math", [&](long i) {
+    ez::pose current = {speeds[i & M], speeds[(i + 3) & M], 6.0 * temps[i & M]}, target = {speeds[(i + 5) & M], speeds[(i + 9) & M], 0.0};
+    bench_keep(ez::util::absolute_angle_to_point(target, current));
+    bench_keep(ez::util::distance_to_point(target, current));
+    bench_keep(ez::util::vector_off_point(4.0, current));
+  }));
+
+  // pure pursuit, once per motion: inject + smooth a 4 point path
+  std::vector<ez::odom> movements = {
+      {{24, 24, 45}, ez::fwd, 110}, {{24, 48, ez::ANGLE_NOT_SET}, ez::fwd, 110}, {{0, 48, ez::ANGLE_NOT_SET}, ez::fwd, 110}, {{0, 0, 180}, ez::fwd, 110}};
+  results.push_back(bench_run("ez_path_inject+smooth", [&](long i) {
+    std::vector<int> legs;
+    std::vector<ez::odom> path = sim_inject_points({0, (double)(i & 1), 0}, movements, 0.5, legs);
+    bench_keep(sim_smooth_path(path, SIM_SMOOTH_WEIGHT, SIM_SMOOTH_DATA, SIM_SMOOTH_TOLERANCE).size());
+  }));
+
+  // sensor filters, per reading
+  okapi::MedianFilter<5> median;
+  okapi::AverageFilter<5> average;
+  results.push_back(bench_run("okapi_median_filter<5>", [&](long i) { bench_keep(median.filter(speeds[i & M])); }));
+  results.push_back(bench_run("okapi_average_filter<5>", [&](long i) { bench_keep(average.filter(speeds[i & M])); }));
+
+  // thermal task, 100 ms: model step + derate for one motor
+  results.push_back(bench_run("thermal_motor_step", [&](long i) {
+    double t = thermal_step(temps[i & M], amps[i & M], THERMAL_AMBIENT, THERMAL_HEAT, THERMAL_COOL, 0.1);
+    t = thermal_correct(t, 5.0 * (int)(temps[i & M] / 5.0));
+    bench_keep(thermal_current_for(t, THERMAL_AMBIENT, THERMAL_HEAT, THERMAL_COOL, THERMAL_LIMIT_TEMP, THERMAL_HORIZON));
+  }));
+
+  // power task, 20 ms: the budget split
+  results.push_back(bench_run("power_budget_split", [&](long i) {
+    int requested[POWER_CONSUMERS] = {2500, 1000 + (int)(i & 1023), 1500};
+    int priority[POWER_CONSUMERS] = {1, 2, (int)(i & 3)};
+    int reserved[POWER_CONSUMERS] = {0, POWER_INTAKE_RUN_MA, POWER_LB_HOLD_MA};
+    int allocated[POWER_CONSUMERS];
+    power_budget_split(requested, priority, reserved, POWER_MOTORS, POWER_CONSUMERS, POWER_BUDGET_MA, allocated);
+    bench_keep(allocated);
+  }));
+
+  // gain schedule task: blend a 2 x 2 schedule
+  std::vector<gain_schedule_point> schedule = {
+      {0.0, 12.8, {3.0, 0.05, 20.0, 15.0}},
+      {0.0, 11.5, {3.4, 0.05, 22.0, 15.0}},
+      {1.0, 12.8, {4.0, 0.05, 26.0, 15.0}},
+      {1.0, 11.5, {4.5, 0.05, 29.0, 15.0}},
+  };
+  results.push_back(bench_run("gain_schedule_interpolate", [&](long i) {
+    ez::PID::Constants c = gain_schedule_interpolate(schedule, i & 1 ? 1.0 : 0.0, 11.5 + 1.3 * (temps[i & M] - 25.0) / 30.0);
+    bench_keep(c);
+  }));
+
+  // every instrumented loop, every tick: profiler + the trace check
+  loop_profile profile;
+  results.push_back(bench_run("loop_profile_add", [&](long i) {
+    loop_profile_period_add(profile, 20000 + sticks[i & M]);
+    loop_profile_exec_add(profile, 300 + sticks[i & M]);
+    bench_keep(profile);
+  }));
+  results.push_back(bench_run("trace_begin+end (off)", [&](long i) {
+    trace_begin(TRACE_LOOP, (int)i);
+    trace_end(TRACE_LOOP, (int)i);
+  }));
+
+  // cpu usage task, 1 s: one line of run-time stats
+  const char *statsLine = "armDriver      \t1234567\t\t3%\n";
+  results.push_back(bench_run("cpu_usage_parse_line", [&](long i) {
+    char name[CPU_NAME_LENGTH];
+    std::uint32_t counter = 0;
+    bench_keep(cpu_usage_parse_line(statsLine + (i & 1), name, counter));
+    bench_keep(counter);
+  }));
+
+  // telemetry task, up to 100 Hz: one pose frame (header + CRC + COBS)
+  std::uint8_t frame[TELEMETRY_FRAME_MAX];
+  results.push_back(bench_run("telemetry_frame_encode (pose)", [&](long i) {
+    telemetry_pose pose = {(float)speeds[i & M], (float)speeds[(i + 3) & M], (float)temps[(i + 5) & M]};
+    bench_keep(telemetry_frame_encode(TELEMETRY_POSE, (std::uint8_t)i, (std::uint32_t)i, &pose, sizeof(pose), frame));
+    bench_keep(frame);
+  }));
+
+  // distance sensor localization: one ray
+  field_model field = field_model_high_stakes();
+  results.push_back(bench_run("field_raycast", [&](long i) {
+    bench_keep(field_raycast(field, speeds[i & M], speeds[(i + 3) & M], 6.0 * temps[(i + 5) & M], DISTANCE_SENSOR_MAX_RANGE));
+  }));
+
+  int regressions = 0;
+  if (check != nullptr) {
+    std::vector<bench_result> baseline = bench_load(check);
+    if (baseline.empty()) {
+      printf("no baseline in %s, save one with --save first\n", check);
+      return 2;
+    }
+    regressions = bench_compare(baseline, results, tolerance);
+    printf("%d slower than the baseline by more than %.0f%%\n", regressions, 100 * tolerance);
+  }
+  if (save != nullptr) {
+    if (!bench_save(save, results)) {
+      printf("couldn't write %s\n", save);
+      return 2;
+    }
+    printf("saved %s\n", save);
+  }
+  return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,9 @@
+// Just enough of PROS for our plain-math files to link on a computer.
+// EZ-Template/util.hpp checks for an SD card when it gets included, so that has to exist.
+#include "api.h"
+
+namespace pros {
+namespace usd {
+std::int32_t is_installed(void) { return 0; }
+}  // namespace usd
+}  // namespace pros
@@ -0,0 +1,533 @@
+// PROS's devices for the host simulator (see tools/sim/sim_world.hpp). Motors, sensors and pistons read and
+// write simWorld, everything else (controller, screen) is there so the robot code links and does nothing.
+// Motors are by port like the real ones, so any number of pros::Motor/MotorGroup objects can share one.
+// A lot of these objects are globals made before main(), so constructors never touch simWorld.
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "EZ-Template/util.hpp"
+#include "api.h"
+#include "liblvgl/lvgl.h"
+#include "sim_world.hpp"
+
+static sim_motor &simMotorOf(std::int8_t port) { return simWorld.motors[std::abs(port)]; }
+static double simDir(std::int8_t port) { return port < 0 ? -1.0 : 1.0; }
+
+namespace pros {
+inline namespace v5 {
+Device::Device(const std::uint8_t port) : _port(port) {}
+std::uint8_t Device::get_port() const { return _port; }
+bool Device::is_installed() { return true; }
+
+// ---- Motor ----
+Motor::Motor(const std::int8_t port, const MotorGears, const MotorUnits) : Device(std::abs(port), DeviceType::motor), _port(port) {}
+std::int32_t Motor::move(std::int32_t voltage) const { return move_voltage(voltage * 12000 / 127); }
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const { return move_velocity(position > get_position() ? velocity : -velocity); }  // no profile, it just goes
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const { return move_velocity(position > 0 ? velocity : -velocity); }
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const {
+  sim_motor &m = simMotorOf(_port);
+  m.velocity_mode = velocity != 0;
+  m.velocity_target = simDir(_port) * velocity;
+  m.command = 0.0;
+  return 1;
+}
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const {
+  sim_motor &m = simMotorOf(_port);
+  m.velocity_mode = false;
+  m.command = simDir(_port) * std::clamp(voltage, -12000, 12000);
+  return 1;
+}
+std::int32_t Motor::brake(void) const { return move_voltage(0); }
+std::int32_t Motor::modify_profiled_velocity(const std::int32_t velocity) const { return move_velocity(velocity); }
+double Motor::get_target_position(const std::uint8_t) const { return 0.0; }
+std::int32_t Motor::get_target_velocity(const std::uint8_t) const { return simDir(_port) * simMotorOf(_port).velocity_target; }
+double Motor::get_actual_velocity(const std::uint8_t) const { return simDir(_port) * simMotorOf(_port).velocity; }
+std::int32_t Motor::get_current_draw(const std::uint8_t) const { return simMotorOf(_port).current; }
+std::int32_t Motor::get_direction(const std::uint8_t) const { return get_actual_velocity() < 0 ? -1 : 1; }
+double Motor::get_efficiency(const std::uint8_t) const { return 100.0 * (1.0 - simMotorOf(_port).current / 2500.0); }
+std::uint32_t Motor::get_faults(const std::uint8_t) const { return 0; }
+std::uint32_t Motor::get_flags(const std::uint8_t) const { return 0; }
+double Motor::get_position(const std::uint8_t) const {
+  sim_motor &m = simMotorOf(_port);
+  return simDir(_port) * (m.position - m.tare) + sim_noise(simWorld.params.encoder_noise);
+}
+double Motor::get_power(const std::uint8_t) const { return std::fabs(get_voltage() / 1000.0 * get_current_draw() / 1000.0); }
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t) const {
+  if (timestamp != nullptr) *timestamp = pros::millis();
+  return get_position();
+}
+double Motor::get_temperature(const std::uint8_t) const { return simMotorOf(_port).temperature; }
+double Motor::get_torque(const std::uint8_t) const { return 2.1 * get_current_draw() / 2500.0; }  // Nm, 100 rpm cartridge stall torque
+std::int32_t Motor::get_voltage(const std::uint8_t) const { return simDir(_port) * simMotorOf(_port).voltage; }
+std::int32_t Motor::is_over_current(const std::uint8_t) const {
+  sim_motor &m = simMotorOf(_port);
+  return m.current >= m.current_limit;
+}
+std::int32_t Motor::is_over_temp(const std::uint8_t) const { return simMotorOf(_port).temperature >= 55.0; }
+MotorBrake Motor::get_brake_mode(const std::uint8_t) const {
+  sim_brake brake = simMotorOf(_port).brake;
+  return brake == SIM_HOLD ? MotorBrake::hold : brake == SIM_BRAKE ? MotorBrake::brake : MotorBrake::coast;
+}
+std::int32_t Motor::get_current_limit(const std::uint8_t) const { return simMotorOf(_port).current_limit; }
+MotorUnits Motor::get_encoder_units(const std::uint8_t) const { return MotorUnits::degrees; }
+MotorGears Motor::get_gearing(const std::uint8_t) const {
+  double rpm = simMotorOf(_port).gear_rpm;
+  return rpm > 300 ? MotorGears::blue : rpm > 150 ? MotorGears::green : MotorGears::red;
+}
+std::int32_t Motor::get_voltage_limit(const std::uint8_t) const { return 12000; }
+std::int32_t Motor::is_reversed(const std::uint8_t) const { return _port < 0; }
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t) const {
+  simMotorOf(_port).brake = mode == MotorBrake::hold ? SIM_HOLD : mode == MotorBrake::brake ? SIM_BRAKE : SIM_COAST;
+  return 1;
+}
+std::int32_t Motor::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const { return set_brake_mode(static_cast<MotorBrake>(mode), index); }
+std::int32_t Motor::set_current_limit(const std::int32_t limit, const std::uint8_t) const {
+  simMotorOf(_port).current_limit = limit;
+  return 1;
+}
+std::int32_t Motor::set_encoder_units(const MotorUnits, const std::uint8_t) const { return 1; }  // always degrees
+std::int32_t Motor::set_encoder_units(const pros::motor_encoder_units_e_t, const std::uint8_t) const { return 1; }  // always degrees
+std::int32_t Motor::set_gearing(const MotorGears, const std::uint8_t) const { return 1; }  // the cartridge in the sim is whatever the robot has
+std::int32_t Motor::set_gearing(const pros::motor_gearset_e_t, const std::uint8_t) const { return 1; }  // the cartridge in the sim is whatever the robot has
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t) {
+  _port = reverse ? -std::abs(_port) : std::abs(_port);
+  return 1;
+}
+std::int32_t Motor::set_voltage_limit(const std::int32_t, const std::uint8_t) const { return 1; }
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t) const {
+  sim_motor &m = simMotorOf(_port);
+  m.tare = m.position - simDir(_port) * position;
+  return 1;
+}
+std::int32_t Motor::tare_position(const std::uint8_t index) const { return set_zero_position(0.0, index); }
+std::int8_t Motor::size(void) const { return 1; }
+std::vector<Motor> Motor::get_all_devices() { return {}; }
+std::int8_t Motor::get_port(const std::uint8_t) const { return _port; }
+std::vector<double> Motor::get_target_position_all(void) const { return {get_target_position(0)}; }
+std::vector<std::int32_t> Motor::get_target_velocity_all(void) const { return {get_target_velocity(0)}; }
+std::vector<double> Motor::get_actual_velocity_all(void) const { return {get_actual_velocity(0)}; }
+std::vector<std::int32_t> Motor::get_current_draw_all(void) const { return {get_current_draw(0)}; }
+std::vector<std::int32_t> Motor::get_direction_all(void) const { return {get_direction(0)}; }
+std::vector<double> Motor::get_efficiency_all(void) const { return {get_efficiency(0)}; }
+std::vector<std::uint32_t> Motor::get_faults_all(void) const { return {get_faults(0)}; }
+std::vector<std::uint32_t> Motor::get_flags_all(void) const { return {get_flags(0)}; }
+std::vector<double> Motor::get_position_all(void) const { return {get_position(0)}; }
+std::vector<double> Motor::get_power_all(void) const { return {get_power(0)}; }
+std::vector<std::int32_t> Motor::get_raw_position_all(std::uint32_t* const timestamp) const { return {get_raw_position(timestamp, 0)}; }
+std::vector<double> Motor::get_temperature_all(void) const { return {get_temperature(0)}; }
+std::vector<double> Motor::get_torque_all(void) const { return {get_torque(0)}; }
+std::vector<std::int32_t> Motor::get_voltage_all(void) const { return {get_voltage(0)}; }
+std::vector<std::int32_t> Motor::is_over_current_all(void) const { return {is_over_current(0)}; }
+std::vector<std::int32_t> Motor::is_over_temp_all(void) const { return {is_over_temp(0)}; }
+std::vector<MotorBrake> Motor::get_brake_mode_all(void) const { return {get_brake_mode(0)}; }
+std::vector<std::int32_t> Motor::get_current_limit_all(void) const { return {get_current_limit(0)}; }
+std::vector<MotorUnits> Motor::get_encoder_units_all(void) const { return {get_encoder_units(0)}; }
+std::vector<MotorGears> Motor::get_gearing_all(void) const { return {get_gearing(0)}; }
+std::vector<std::int8_t> Motor::get_port_all(void) const { return {get_port(0)}; }
+std::vector<std::int32_t> Motor::get_voltage_limit_all(void) const { return {get_voltage_limit(0)}; }
+std::vector<std::int32_t> Motor::is_reversed_all(void) const { return {is_reversed(0)}; }
+std::int32_t Motor::set_brake_mode_all(const MotorBrake mode) const { return set_brake_mode(mode, 0); }
+std::int32_t Motor::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const { return set_brake_mode(mode, 0); }
+std::int32_t Motor::set_current_limit_all(const std::int32_t limit) const { return set_current_limit(limit, 0); }
+std::int32_t Motor::set_encoder_units_all(const MotorUnits units) const { return set_encoder_units(units, 0); }
+std::int32_t Motor::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const { return set_encoder_units(units, 0); }
+std::int32_t Motor::set_gearing_all(const MotorGears gearset) const { return set_gearing(gearset, 0); }
+std::int32_t Motor::set_gearing_all(const pros::motor_gearset_e_t gearset) const { return set_gearing(gearset, 0); }
+std::int32_t Motor::set_reversed_all(const bool reverse) { return set_reversed(reverse, 0); }
+std::int32_t Motor::set_voltage_limit_all(const std::int32_t limit) const { return set_voltage_limit(limit, 0); }
+std::int32_t Motor::set_zero_position_all(const double position) const { return set_zero_position(position, 0); }
+std::int32_t Motor::tare_position_all(void) const { return tare_position(0); }
+
+// ---- MotorGroup, everything goes through a Motor on each port ----
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears, const MotorUnits) : _ports(ports) {}
+MotorGroup::MotorGroup(const std::vector<std::int8_t> &ports, const MotorGears, const MotorUnits) : _ports(ports) {}
+MotorGroup::MotorGroup(AbstractMotor &motor_group) : _ports(motor_group.get_port_all()) {}
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+  for (std::int8_t port : _ports) Motor(port).move(voltage);
+  return 1;
+}
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+  for (std::int8_t port : _ports) Motor(port).move_absolute(position, velocity);
+  return 1;
+}
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+  for (std::int8_t port : _ports) Motor(port).move_relative(position, velocity);
+  return 1;
+}
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+  for (std::int8_t port : _ports) Motor(port).move_velocity(velocity);
+  return 1;
+}
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+  for (std::int8_t port : _ports) Motor(port).move_voltage(voltage);
+  return 1;
+}
+std::int32_t MotorGroup::brake(void) const {
+  for (std::int8_t port : _ports) Motor(port).brake();
+  return 1;
+}
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+  for (std::int8_t port : _ports) Motor(port).modify_profiled_velocity(velocity);
+  return 1;
+}
+double MotorGroup::get_target_position(const std::uint8_t index) const { return Motor(_ports[index]).get_target_position(); }
+std::vector<double> MotorGroup::get_target_position_all(void) const {
+  std::vector<double> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_target_position());
+  return out;
+}
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const { return Motor(_ports[index]).get_target_velocity(); }
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_target_velocity());
+  return out;
+}
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const { return Motor(_ports[index]).get_actual_velocity(); }
+std::vector<double> MotorGroup::get_actual_velocity_all(void) const {
+  std::vector<double> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_actual_velocity());
+  return out;
+}
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const { return Motor(_ports[index]).get_current_draw(); }
+std::vector<std::int32_t> MotorGroup::get_current_draw_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_current_draw());
+  return out;
+}
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const { return Motor(_ports[index]).get_direction(); }
+std::vector<std::int32_t> MotorGroup::get_direction_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_direction());
+  return out;
+}
+double MotorGroup::get_efficiency(const std::uint8_t index) const { return Motor(_ports[index]).get_efficiency(); }
+std::vector<double> MotorGroup::get_efficiency_all(void) const {
+  std::vector<double> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_efficiency());
+  return out;
+}
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const { return Motor(_ports[index]).get_faults(); }
+std::vector<std::uint32_t> MotorGroup::get_faults_all(void) const {
+  std::vector<std::uint32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_faults());
+  return out;
+}
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const { return Motor(_ports[index]).get_flags(); }
+std::vector<std::uint32_t> MotorGroup::get_flags_all(void) const {
+  std::vector<std::uint32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_flags());
+  return out;
+}
+double MotorGroup::get_position(const std::uint8_t index) const { return Motor(_ports[index]).get_position(); }
+std::vector<double> MotorGroup::get_position_all(void) const {
+  std::vector<double> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_position());
+  return out;
+}
+double MotorGroup::get_power(const std::uint8_t index) const { return Motor(_ports[index]).get_power(); }
+std::vector<double> MotorGroup::get_power_all(void) const {
+  std::vector<double> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_power());
+  return out;
+}
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const { return Motor(_ports[index]).get_raw_position(timestamp); }
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_raw_position(timestamp));
+  return out;
+}
+double MotorGroup::get_temperature(const std::uint8_t index) const { return Motor(_ports[index]).get_temperature(); }
+std::vector<double> MotorGroup::get_temperature_all(void) const {
+  std::vector<double> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_temperature());
+  return out;
+}
+double MotorGroup::get_torque(const std::uint8_t index) const { return Motor(_ports[index]).get_torque(); }
+std::vector<double> MotorGroup::get_torque_all(void) const {
+  std::vector<double> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_torque());
+  return out;
+}
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const { return Motor(_ports[index]).get_voltage(); }
+std::vector<std::int32_t> MotorGroup::get_voltage_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_voltage());
+  return out;
+}
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const { return Motor(_ports[index]).is_over_current(); }
+std::vector<std::int32_t> MotorGroup::is_over_current_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).is_over_current());
+  return out;
+}
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const { return Motor(_ports[index]).is_over_temp(); }
+std::vector<std::int32_t> MotorGroup::is_over_temp_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).is_over_temp());
+  return out;
+}
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const { return Motor(_ports[index]).get_brake_mode(); }
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all(void) const {
+  std::vector<MotorBrake> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_brake_mode());
+  return out;
+}
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const { return Motor(_ports[index]).get_current_limit(); }
+std::vector<std::int32_t> MotorGroup::get_current_limit_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_current_limit());
+  return out;
+}
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const { return Motor(_ports[index]).get_encoder_units(); }
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all(void) const {
+  std::vector<MotorUnits> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_encoder_units());
+  return out;
+}
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const { return Motor(_ports[index]).get_gearing(); }
+std::vector<MotorGears> MotorGroup::get_gearing_all(void) const {
+  std::vector<MotorGears> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_gearing());
+  return out;
+}
+std::vector<std::int8_t> MotorGroup::get_port_all(void) const { return _ports; }
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const { return Motor(_ports[index]).get_voltage_limit(); }
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).get_voltage_limit());
+  return out;
+}
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const { return Motor(_ports[index]).is_reversed(); }
+std::vector<std::int32_t> MotorGroup::is_reversed_all(void) const {
+  std::vector<std::int32_t> out;
+  for (std::int8_t port : _ports) out.push_back(Motor(port).is_reversed());
+  return out;
+}
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const { return Motor(_ports[index]).set_brake_mode(mode); }
+std::int32_t MotorGroup::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const { return Motor(_ports[index]).set_brake_mode(mode); }
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const {
+  for (std::int8_t port : _ports) Motor(port).set_brake_mode(mode);
+  return 1;
+}
+std::int32_t MotorGroup::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const {
+  for (std::int8_t port : _ports) Motor(port).set_brake_mode(mode);
+  return 1;
+}
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const { return Motor(_ports[index]).set_current_limit(limit); }
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+  for (std::int8_t port : _ports) Motor(port).set_current_limit(limit);
+  return 1;
+}
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const { return Motor(_ports[index]).set_encoder_units(units); }
+std::int32_t MotorGroup::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const { return Motor(_ports[index]).set_encoder_units(units); }
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const {
+  for (std::int8_t port : _ports) Motor(port).set_encoder_units(units);
+  return 1;
+}
+std::int32_t MotorGroup::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+  for (std::int8_t port : _ports) Motor(port).set_encoder_units(units);
+  return 1;
+}
+std::int32_t MotorGroup::set_gearing(std::vector<pros::motor_gearset_e_t>) const { return 1; }
+std::int32_t MotorGroup::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const { return Motor(_ports[index]).set_gearing(gearset); }
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears>) const { return 1; }
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const { return Motor(_ports[index]).set_gearing(gearset); }
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const {
+  for (std::int8_t port : _ports) Motor(port).set_gearing(gearset);
+  return 1;
+}
+std::int32_t MotorGroup::set_gearing_all(const pros::motor_gearset_e_t gearset) const {
+  for (std::int8_t port : _ports) Motor(port).set_gearing(gearset);
+  return 1;
+}
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+  Motor m(_ports[index]);
+  m.set_reversed(reverse);
+  _ports[index] = m.get_port();
+  return 1;
+}
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+  for (int i = 0; i < size(); i++) set_reversed(reverse, i);
+  return 1;
+}
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const { return Motor(_ports[index]).set_voltage_limit(limit); }
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+  for (std::int8_t port : _ports) Motor(port).set_voltage_limit(limit);
+  return 1;
+}
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const { return Motor(_ports[index]).set_zero_position(position); }
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+  for (std::int8_t port : _ports) Motor(port).set_zero_position(position);
+  return 1;
+}
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const { return Motor(_ports[index]).tare_position(); }
+std::int32_t MotorGroup::tare_position_all(void) const {
+  for (std::int8_t port : _ports) Motor(port).tare_position();
+  return 1;
+}
+std::int8_t MotorGroup::size(void) const { return _ports.size(); }
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const { return _ports[index]; }
+void MotorGroup::append(AbstractMotor& other) { for (std::int8_t port : other.get_port_all()) _ports.push_back(port); }
+void MotorGroup::erase_port(std::int8_t port) { std::erase_if(_ports, [port](std::int8_t p) { return std::abs(p) == std::abs(port); }); }
+
+// ---- IMU, reads the robot's heading with the IMU error from sim_params ----
+static double simImuOffset[SIM_PORTS];  // raw reading that means rotation 0
+
+Imu Imu::get_imu() { return Imu(SIM_IMU_PORT); }
+std::int32_t Imu::reset(bool) const { return tare(); }
+std::int32_t Imu::set_data_rate(std::uint32_t) const { return 1; }
+std::vector<Imu> Imu::get_all_devices() { return {Imu(SIM_IMU_PORT)}; }
+double Imu::get_rotation() const { return sim_imu_rotation() - simImuOffset[_port]; }
+double Imu::get_heading() const {
+  double heading = std::fmod(get_rotation(), 360.0);
+  return heading < 0 ? heading + 360.0 : heading;
+}
+pros::quaternion_s_t Imu::get_quaternion() const { return {}; }
+pros::euler_s_t Imu::get_euler() const { return {0.0, 0.0, get_yaw()}; }
+double Imu::get_pitch() const { return 0.0; }
+double Imu::get_roll() const { return 0.0; }
+double Imu::get_yaw() const { return std::remainder(get_rotation(), 360.0); }
+pros::imu_gyro_s_t Imu::get_gyro_rate() const { return {}; }
+std::int32_t Imu::tare_rotation() const { return set_rotation(0.0); }
+std::int32_t Imu::tare_heading() const { return set_rotation(0.0); }
+std::int32_t Imu::tare_pitch() const { return 1; }
+std::int32_t Imu::tare_yaw() const { return set_rotation(0.0); }
+std::int32_t Imu::tare_roll() const { return 1; }
+std::int32_t Imu::tare() const { return set_rotation(0.0); }
+std::int32_t Imu::tare_euler() const { return set_rotation(0.0); }
+std::int32_t Imu::set_heading(const double target) const { return set_rotation(target); }
+std::int32_t Imu::set_rotation(const double target) const {
+  simImuOffset[_port] = sim_imu_rotation() - target;
+  return 1;
+}
+std::int32_t Imu::set_yaw(const double target) const { return set_rotation(target); }
+std::int32_t Imu::set_pitch(const double) const { return 1; }
+std::int32_t Imu::set_roll(const double) const { return 1; }
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const { return set_rotation(target.yaw); }
+pros::imu_accel_s_t Imu::get_accel() const { return {}; }
+pros::ImuStatus Imu::get_status() const { return pros::ImuStatus::ready; }
+bool Imu::is_calibrating() const { return false; }
+imu_orientation_e_t Imu::get_physical_orientation() const { return pros::E_IMU_Z_UP; }
+
+// ---- Rotation, the lady brown sensor reads the arm, anything else reads 0 (the odom pods aren't on the chassis) ----
+static std::int32_t simRotationOffset[SIM_PORTS];
+static bool simRotationReversed[SIM_PORTS];
+
+static std::int32_t simRotationRaw(std::uint8_t port) {
+  std::int32_t raw = port == SIM_LB_SENSOR_PORT ? std::lround(simWorld.lb_angle) : 0;
+  return simRotationReversed[port] ? -raw : raw;
+}
+
+Rotation::Rotation(const std::int8_t port) : Device(std::abs(port), DeviceType::rotation) { simRotationReversed[_port] = port < 0; }
+std::int32_t Rotation::reset() { return reset_position(); }
+std::int32_t Rotation::set_data_rate(std::uint32_t) const { return 1; }
+std::int32_t Rotation::set_position(std::uint32_t position) const {
+  simRotationOffset[_port] = simRotationRaw(_port) - (std::int32_t)position;
+  return 1;
+}
+std::int32_t Rotation::reset_position() const { return set_position(0); }
+std::vector<Rotation> Rotation::get_all_devices() { return {}; }
+std::int32_t Rotation::get_position() const { return simRotationRaw(_port) - simRotationOffset[_port]; }
+std::int32_t Rotation::get_velocity() const { return 0; }
+std::int32_t Rotation::get_angle() const { return ((get_position() % 36000) + 36000) % 36000; }
+std::int32_t Rotation::set_reversed(bool value) const {
+  simRotationReversed[_port] = value;
+  return 1;
+}
+std::int32_t Rotation::reverse() const { return set_reversed(!simRotationReversed[_port]); }
+std::int32_t Rotation::get_reversed() const { return simRotationReversed[_port]; }
+
+// ---- Optical + distance: no rings on this field ----
+Optical::Optical(const std::uint8_t port) : Device(port, DeviceType::optical) {}
+std::vector<Optical> Optical::get_all_devices() { return {}; }
+double Optical::get_hue() { return 0.0; }
+double Optical::get_saturation() { return 0.0; }
+double Optical::get_brightness() { return 0.0; }
+std::int32_t Optical::get_proximity() { return 0; }
+std::int32_t Optical::set_led_pwm(uint8_t) { return 1; }
+std::int32_t Optical::get_led_pwm() { return 0; }
+pros::c::optical_rgb_s_t Optical::get_rgb() { return {}; }
+pros::c::optical_raw_s_t Optical::get_raw() { return {}; }
+pros::c::optical_direction_e_t Optical::get_gesture() { return pros::c::NO_GESTURE; }
+pros::c::optical_gesture_s_t Optical::get_gesture_raw() { return {}; }
+std::int32_t Optical::enable_gesture() { return 1; }
+std::int32_t Optical::disable_gesture() { return 1; }
+
+Distance::Distance(const std::uint8_t port) : Device(port, DeviceType::distance) {}
+std::vector<Distance> Distance::get_all_devices() { return {}; }
+std::int32_t Distance::get() { return 9999; }
+std::int32_t Distance::get_distance() { return 9999; }
+std::int32_t Distance::get_confidence() { return 0; }
+std::int32_t Distance::get_object_size() { return 0; }
+double Distance::get_object_velocity() { return 0.0; }
+
+// ---- Controller: nobody's holding it ----
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+std::int32_t Controller::get_analog(controller_analog_e_t) { return 0; }
+std::int32_t Controller::get_digital(controller_digital_e_t) { return 0; }
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t) { return 0; }
+std::int32_t Controller::set_text(std::uint8_t, std::uint8_t, const char *) { return 1; }
+std::int32_t Controller::set_text(std::uint8_t, std::uint8_t, const std::string &) { return 1; }
+std::int32_t Controller::clear() { return 1; }
+std::int32_t Controller::clear_line(std::uint8_t) { return 1; }
+std::int32_t Controller::rumble(const char *) { return 1; }
+}  // namespace v5
+
+// ---- ADI, pistons go in simWorld.adi ----
+namespace adi {
+static std::uint8_t simAdiIndex(std::uint8_t port) {
+  if (port >= 'a' && port <= 'h') return port - 'a';
+  if (port >= 'A' && port <= 'H') return port - 'A';
+  return (port - 1) & (SIM_ADI_PORTS - 1);  // 1 -> 8
+}
+
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t) : _smart_port(INTERNAL_ADI_PORT), _adi_port(simAdiIndex(adi_port)) {}
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t) : _smart_port(port_pair.first), _adi_port(simAdiIndex(port_pair.second)) {}
+std::int32_t Port::set_value(std::int32_t value) const {
+  simWorld.adi[_adi_port] = value != 0;
+  return 1;
+}
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port + 1, 0}; }
+
+// these get made before main(), pistons start retracted when the world gets reset
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool) : Port(adi_port, E_ADI_DIGITAL_OUT) {}
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool) : Port(port_pair, E_ADI_DIGITAL_OUT) {}
+
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t, bool) : Port(adi_port_top, E_ADI_LEGACY_ENCODER) {}
+Encoder::Encoder(ext_adi_port_tuple_t port_tuple, bool) : Port({std::get<0>(port_tuple), std::get<1>(port_tuple)}, E_ADI_LEGACY_ENCODER) {}
+std::int32_t Encoder::reset() const { return 1; }
+std::int32_t Encoder::get_value() const { return 0; }
+ext_adi_port_tuple_t Encoder::get_port() const { return Port::get_port(); }
+}  // namespace adi
+
+namespace battery {
+double get_capacity() { return 100.0; }
+std::int32_t get_voltage() { return std::lround(sim_battery_voltage() * 1000.0); }
+std::int32_t get_current() { return 0; }
+double get_temperature() { return 25.0; }
+}  // namespace battery
+
+namespace competition {
+std::uint8_t is_connected() { return 1; }  // like a match, the test combos stay off
+}  // namespace competition
+}  // namespace pros
+
+namespace ez {
+void screen_print(std::string, int) {}
+}  // namespace ez
+
+// ---- LVGL, the auton's screen stuff draws into nothing ----
+static lv_obj_t simScreenObject;
+
+extern "C" {
+lv_disp_t *lv_disp_get_default(void) { return nullptr; }
+lv_obj_t *lv_disp_get_scr_act(lv_disp_t *) { return &simScreenObject; }
+lv_obj_t *lv_obj_create(lv_obj_t *) { return &simScreenObject; }
+lv_obj_t *lv_label_create(lv_obj_t *) { return &simScreenObject; }
+void lv_label_set_text(lv_obj_t *, const char *) {}
+void lv_obj_align(lv_obj_t *, lv_align_t, lv_coord_t, lv_coord_t) {}
+void lv_obj_clear_flag(lv_obj_t *, lv_obj_flag_t) {}
+void lv_obj_set_size(lv_obj_t *, lv_coord_t, lv_coord_t) {}
+void lv_obj_set_style_bg_color(lv_obj_t *, lv_color_t, lv_style_selector_t) {}
+}
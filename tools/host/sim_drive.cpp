@@ -0,0 +1,679 @@
+// EZ-Template's chassis for the host simulator (see tools/sim/sim_world.hpp): the parts of ez::Drive autons.cpp
+// uses, on top of the PID/slew/util math in sim_ez.cpp. EZ-Template only comes as an ARM archive, so these are written off its docs and
+// headers, not copied out of it. The motions do what the docs say they do (drive/turn/swing PIDs with heading
+// correction, point to point, boomerang, pure pursuit, the exit conditions and the pid_wait family), the
+// details (injection, turn bias, when the angular PID lets go) are ours. Close enough that a change to our
+// constants or autons moves the times the way it would on the robot, not so close the numbers are the robot's.
+// Odom is EZ's no tracking wheel odom: the first motor on each side for distance, the IMU for heading.
+#include <cmath>
+#include <functional>
+
+#include "EZ-Template/api.hpp"
+#include "api.h"
+#include "sim_ez.hpp"
+#include "sim_world.hpp"
+
+using namespace ez;
+
+std::vector<sim_leg> simLegs;
+
+const double SIM_MOTOR_DEG_PER_WHEEL_REV = 360.0 * 600.0;  // / wheel rpm, chassis ctor "ticks" (blue cartridge)
+const double SIM_ODOM_HOLD = 3.0;                           // in, closer than this the angular PID stops aiming at the point
+
+// Set by the Drive constructor, ez_auto_task() is private so this is the way in
+static std::function<void()> &simDriveStep() {
+  static std::function<void()> step;  // function static, chassis gets made before this file's globals
+  return step;
+}
+static Drive *simChassis = nullptr;
+
+// The motion that's running, for the waits and the report
+static std::uint32_t simMotionStart = 0;  // ms
+static int simMotion = 0;                 // motions started so far
+static double simTraveled = 0.0;          // in, odom motions
+static bool simSpeedOverride = false;     // pid_speed_max_set() during pure pursuit beats the points' speeds
+static bool simHolding = false;           // odom: close enough the angular PID holds instead of aiming
+static double simHoldAngle = 0.0;
+static slew *simOdomSlew = nullptr;
+static bool simAngleExits = false;        // boomerang: the angle has to settle too, not just xy
+
+// Pure pursuit, after injection
+static std::vector<odom> simPath;
+static std::vector<int> simPathLeg;       // which point in the original list each injected one leads to
+static std::vector<double> simRemaining;  // in, path length from each injected point to the end
+
+static void simMotionBegin() {
+  simMotionStart = pros::millis();
+  simMotion++;
+  simTraveled = 0.0;
+  simSpeedOverride = false;
+  simHolding = false;
+}
+
+namespace ez {
+
+// ---- ez::PID ---- (the rest is in sim_ez.cpp, these need the motors)
+exit_output PID::exit_condition(pros::Motor sensor, bool print) { return exit_condition(std::vector<pros::Motor>{sensor}, print); }
+exit_output PID::exit_condition(std::vector<pros::Motor> sensor, bool print) {
+  if (exit.mA_timeout != 0) {
+    bool over = false;
+    for (pros::Motor &motor : sensor) over = over || motor.is_over_current();
+    if (over) {
+      l += util::DELAY_TIME;
+      if (l > exit.mA_timeout) {
+        timers_reset();
+        return mA_EXIT;
+      }
+    } else {
+      l = 0;
+    }
+  }
+  return exit_condition(print);
+}
+exit_output PID::exit_condition(pros::MotorGroup sensor, bool print) {
+  std::vector<pros::Motor> motors;
+  for (std::int8_t port : sensor.get_port_all()) motors.push_back(pros::Motor(port));
+  return exit_condition(motors, print);
+}
+
+// ---- ez::tracking_wheel ---- (ours get made in subsystems.cpp but never given to the chassis)
+tracking_wheel::tracking_wheel(int port, double wheel_diameter, double distance_to_center, double ratio)
+    : adi_encoder(1, 2), smart_encoder(port) {
+  IS_TRACKER = DRIVE_ROTATION;
+  WHEEL_DIAMETER = wheel_diameter;
+  DISTANCE_TO_CENTER = distance_to_center;
+  RATIO = ratio;
+}
+
+}  // namespace ez
+
+// ---- ez::Drive ----
+Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_ports, int imu_port, double wheel_diameter, double ticks, double ratio)
+    : imu(imu_port), left_tracker(1, 2), right_tracker(3, 4), left_rotation(0), right_rotation(0), ez_auto((pros::task_t) nullptr) {
+  for (int port : left_motor_ports) left_motors.push_back(pros::Motor(port));
+  for (int port : right_motor_ports) right_motors.push_back(pros::Motor(port));
+  odom_tracker_left = odom_tracker_right = odom_tracker_front = odom_tracker_back = nullptr;
+  mode = DISABLE;
+  current_swing = LEFT_SWING;
+  max_speed = 0;
+  WHEEL_DIAMETER = wheel_diameter;
+  CARTRIDGE = ticks;
+  RATIO = ratio;
+  CIRCUMFERENCE = WHEEL_DIAMETER * M_PI;
+  TICK_PER_REV = SIM_MOTOR_DEG_PER_WHEEL_REV / (CARTRIDGE * RATIO);  // the sim's motors count degrees
+  TICK_PER_INCH = TICK_PER_REV / CIRCUMFERENCE;
+  simChassis = this;
+  simDriveStep() = [this] { ez_auto_task(); };
+}
+
+double Drive::drive_sensor_left() { return left_motors.front().get_position() / TICK_PER_INCH; }
+double Drive::drive_sensor_right() { return right_motors.front().get_position() / TICK_PER_INCH; }
+double Drive::drive_imu_get() { return imu.get_rotation() * IMU_SCALER; }
+
+void Drive::drive_imu_reset(double new_heading) {
+  imu.set_rotation(new_heading);
+  h_last = new_heading;
+}
+
+void Drive::drive_sensor_reset() {
+  for (pros::Motor &motor : left_motors) motor.tare_position();
+  for (pros::Motor &motor : right_motors) motor.tare_position();
+  l_last = r_last = 0.0;
+}
+
+void Drive::drive_brake_set(pros::motor_brake_mode_e_t brake_type) {
+  CURRENT_BRAKE = brake_type;
+  for (pros::Motor &motor : left_motors) motor.set_brake_mode(brake_type);
+  for (pros::Motor &motor : right_motors) motor.set_brake_mode(brake_type);
+}
+
+void Drive::pid_targets_reset() {
+  headingPID.target_set(0);
+  leftPID.target_set(0);
+  rightPID.target_set(0);
+  turnPID.target_set(0);
+  swingPID.target_set(0);
+  xyPID.target_set(0);
+  current_a_odomPID.target_set(0);
+  odom_target = {0.0, 0.0, 0.0};
+}
+
+void Drive::private_drive_set(int left, int right) {
+  left = util::clamp(left, 127);
+  right = util::clamp(right, 127);
+  for (pros::Motor &motor : left_motors) motor.move_voltage(left * (12000.0 / 127.0));
+  for (pros::Motor &motor : right_motors) motor.move_voltage(right * (12000.0 / 127.0));
+}
+
+// ---- odom ----
+void Drive::odom_xyt_set(double x, double y, double t) {
+  if (!simWorld.robot.placed) sim_world_place(x, y, t);  // the first one is where the robot got put down
+  odom_current = {x, y, t};
+  drive_imu_reset(t);
+  headingPID.target_set(t);
+  was_odom_just_set = true;
+}
+double Drive::odom_x_get() { return odom_current.x; }
+double Drive::odom_y_get() { return odom_current.y; }
+double Drive::odom_theta_get() { return odom_current.theta; }
+void Drive::odom_turn_bias_set(double bias) { odom_turn_bias_amount = bias; }
+void Drive::odom_look_ahead_set(okapi::QLength distance) { LOOK_AHEAD = distance.convert(okapi::inch); }
+void Drive::odom_boomerang_distance_set(okapi::QLength distance) { max_boomerang_distance = distance.convert(okapi::inch); }
+void Drive::odom_boomerang_dlead_set(double input) { dlead = input; }
+
+// How far the robot still has to go to get to target, along the way it's heading there (negative once it's past)
+double Drive::is_past_target(pose target, pose current) {
+  double along = target.theta != ANGLE_NOT_SET ? target.theta + (current_drive_direction == rev ? 180.0 : 0.0)
+                                               : util::absolute_angle_to_point(target, odom_second_to_last);
+  along = util::to_rad(along);
+  return (target.x - current.x) * std::sin(along) + (target.y - current.y) * std::cos(along);
+}
+
+// ---- constants ----
+void Drive::pid_drive_constants_set(double p, double i, double d, double p_start_i) {
+  forward_drivePID.constants_set(p, i, d, p_start_i);
+  backward_drivePID.constants_set(p, i, d, p_start_i);
+  fwd_rev_drivePID.constants_set(p, i, d, p_start_i);
+  leftPID.constants_set(p, i, d, p_start_i);
+  rightPID.constants_set(p, i, d, p_start_i);
+  xyPID.constants_set(p, i, d, p_start_i);
+}
+void Drive::pid_heading_constants_set(double p, double i, double d, double p_start_i) { headingPID.constants_set(p, i, d, p_start_i); }
+void Drive::pid_turn_constants_set(double p, double i, double d, double p_start_i) { turnPID.constants_set(p, i, d, p_start_i); }
+void Drive::pid_swing_constants_set(double p, double i, double d, double p_start_i) {
+  forward_swingPID.constants_set(p, i, d, p_start_i);
+  backward_swingPID.constants_set(p, i, d, p_start_i);
+  fwd_rev_swingPID.constants_set(p, i, d, p_start_i);
+  swingPID.constants_set(p, i, d, p_start_i);
+}
+void Drive::pid_odom_angular_constants_set(double p, double i, double d, double p_start_i) { odom_angularPID.constants_set(p, i, d, p_start_i); }
+void Drive::pid_odom_boomerang_constants_set(double p, double i, double d, double p_start_i) { boomerangPID.constants_set(p, i, d, p_start_i); }
+
+void Drive::pid_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error, okapi::QTime p_big_exit_time, okapi::QLength p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool) {
+  int small = p_small_exit_time.convert(okapi::millisecond), big = p_big_exit_time.convert(okapi::millisecond);
+  int velocity = p_velocity_exit_time.convert(okapi::millisecond), mA = p_mA_timeout.convert(okapi::millisecond);
+  leftPID.exit_condition_set(small, p_small_error.convert(okapi::inch), big, p_big_error.convert(okapi::inch), velocity, mA);
+  rightPID.exit_condition_set(small, p_small_error.convert(okapi::inch), big, p_big_error.convert(okapi::inch), velocity, mA);
+}
+void Drive::pid_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool) {
+  turnPID.exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond),
+                             p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond));
+}
+void Drive::pid_swing_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool) {
+  swingPID.exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond),
+                              p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond));
+}
+void Drive::pid_odom_turn_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QAngle p_small_error, okapi::QTime p_big_exit_time, okapi::QAngle p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool) {
+  for (PID *pid : {&odom_angularPID, &boomerangPID, &current_a_odomPID})
+    pid->exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::degree), p_big_exit_time.convert(okapi::millisecond),
+                            p_big_error.convert(okapi::degree), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond));
+}
+void Drive::pid_odom_drive_exit_condition_set(okapi::QTime p_small_exit_time, okapi::QLength p_small_error, okapi::QTime p_big_exit_time, okapi::QLength p_big_error, okapi::QTime p_velocity_exit_time, okapi::QTime p_mA_timeout, bool) {
+  xyPID.exit_condition_set(p_small_exit_time.convert(okapi::millisecond), p_small_error.convert(okapi::inch), p_big_exit_time.convert(okapi::millisecond),
+                           p_big_error.convert(okapi::inch), p_velocity_exit_time.convert(okapi::millisecond), p_mA_timeout.convert(okapi::millisecond));
+}
+
+void Drive::pid_drive_chain_constant_set(okapi::QLength input) { drive_forward_motion_chain_scale = drive_backward_motion_chain_scale = input.convert(okapi::inch); }
+void Drive::pid_turn_chain_constant_set(okapi::QAngle input) { turn_motion_chain_scale = input.convert(okapi::degree); }
+void Drive::pid_swing_chain_constant_set(okapi::QAngle input) { swing_forward_motion_chain_scale = swing_backward_motion_chain_scale = input.convert(okapi::degree); }
+
+void Drive::slew_drive_constants_set(okapi::QLength distance, int min_speed) {
+  for (slew *s : {&slew_left, &slew_right, &slew_forward, &slew_backward}) s->constants_set(distance.convert(okapi::inch), min_speed);
+}
+void Drive::slew_turn_constants_set(okapi::QAngle distance, int min_speed) { slew_turn.constants_set(distance.convert(okapi::degree), min_speed); }
+void Drive::slew_swing_constants_set(okapi::QLength distance, int min_speed) {
+  for (slew *s : {&slew_swing, &slew_swing_forward, &slew_swing_backward}) s->constants_set(distance.convert(okapi::inch), min_speed);
+  slew_swing_using_angle = false;
+}
+
+void Drive::pid_angle_behavior_set(e_angle_behavior behavior) { default_turn_type = default_swing_type = default_odom_type = behavior; }
+
+void Drive::pid_speed_max_set(int speed) {
+  max_speed = std::abs(speed);
+  simSpeedOverride = true;
+  for (slew *s : {&slew_left, &slew_right, &slew_turn, &slew_swing, &slew_forward, &slew_backward}) s->speed_max_set(max_speed);
+}
+int Drive::pid_speed_max_get() { return max_speed; }
+e_mode Drive::drive_mode_get() { return mode; }
+bool Drive::pid_tuner_enabled() { return false; }  // no controller in the sim to run it from
+void Drive::pid_drive_toggle(bool toggle) { drive_toggle = toggle; }
+bool Drive::pid_drive_toggle_get() { return drive_toggle; }
+bool Drive::pto_check(pros::Motor) { return false; }  // nothing's on a PTO in the sim
+
+// ---- motions ----
+// Where an absolute angle ends up next to current, the way behavior says to get there
+double Drive::new_turn_target_compute(double target, double current, e_angle_behavior behavior) {
+  double nearest = util::turn_shortest(target, current);
+  switch (behavior) {
+    case left_turn: return nearest > current ? nearest - 360.0 : nearest;
+    case right_turn: return nearest < current ? nearest + 360.0 : nearest;
+    case shortest: return nearest;
+    case longest: return util::turn_longest(target, current);
+    default: return target;
+  }
+}
+
+void Drive::pid_drive_set(okapi::QLength p_target, int speed) { pid_drive_set(p_target, speed, global_forward_drive_slew_enabled, true); }
+void Drive::pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading) {
+  double target = p_target.convert(okapi::inch);
+  simMotionBegin();
+  heading_on = toggle_heading;
+  max_speed = std::abs(speed);
+  PID &constants = target < 0 ? backward_drivePID : forward_drivePID;
+  leftPID.constants = rightPID.constants = constants.constants;
+  leftPID.timers_reset();
+  rightPID.timers_reset();
+  l_start = drive_sensor_left();
+  r_start = drive_sensor_right();
+  leftPID.target_set(l_start + target);
+  rightPID.target_set(r_start + target);
+  slew &ramp = target < 0 ? slew_backward : slew_forward;
+  slew_left.constants = slew_right.constants = ramp.constants;
+  slew_left.initialize(slew_on, max_speed, l_start + target, l_start);
+  slew_right.initialize(slew_on, max_speed, r_start + target, r_start);
+  mode = DRIVE;
+}
+
+void Drive::pid_turn_set(double target, int speed) { pid_turn_set(target, speed, default_turn_type, global_turn_slew_enabled); }
+void Drive::pid_turn_set(double target, int speed, bool slew_on) { pid_turn_set(target, speed, default_turn_type, slew_on); }
+void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior) { pid_turn_set(target, speed, behavior, global_turn_slew_enabled); }
+void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
+  simMotionBegin();
+  double current = drive_imu_get();
+  double new_target = new_turn_target_compute(target, current, behavior);
+  max_speed = std::abs(speed);
+  turnPID.timers_reset();
+  turnPID.target_set(new_target);
+  headingPID.target_set(new_target);
+  slew_turn.initialize(slew_on, max_speed, new_target, current);
+  mode = TURN;
+}
+void Drive::pid_turn_relative_set(double target, int speed) { pid_turn_set(headingPID.target_get() + target, speed, raw, global_turn_slew_enabled); }
+
+void Drive::pid_swing_set(e_swing type, double target, int speed) { pid_swing_set(type, target, speed, 0, default_swing_type, global_forward_swing_slew_enabled); }
+void Drive::pid_swing_set(e_swing type, double target, int speed, bool slew_on) { pid_swing_set(type, target, speed, 0, default_swing_type, slew_on); }
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) { pid_swing_set(type, target, speed, opposite_speed, default_swing_type, slew_on); }
+void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+  simMotionBegin();
+  double current = drive_imu_get();
+  double new_target = new_turn_target_compute(target, current, behavior);
+  current_swing = type;
+  swing_opposite_speed = opposite_speed;
+  max_speed = std::abs(speed);
+  swingPID.timers_reset();
+  swingPID.target_set(new_target);
+  headingPID.target_set(new_target);
+  // the ramp is in inches of the swinging side, which goes forwards for a left swing turning right
+  int side_direction = util::sgn(new_target - current) * (type == LEFT_SWING ? 1 : -1);
+  double side = type == LEFT_SWING ? drive_sensor_left() : drive_sensor_right();
+  slew_swing.initialize(slew_on, max_speed, side + side_direction, side);
+  mode = SWING;
+}
+void Drive::pid_swing_relative_set(e_swing type, double target, int speed) { pid_swing_set(type, headingPID.target_get() + target, speed, 0, raw, global_forward_swing_slew_enabled); }
+
+void Drive::raw_pid_odom_ptp_set(odom imovement, bool slew_on) {
+  simMotionBegin();
+  odom_target = imovement.target;
+  current_drive_direction = imovement.drive_direction;
+  max_speed = std::abs(imovement.max_xy_speed);
+  odom_start = odom_second_to_last = odom_current;
+  bool boomerang = odom_target.theta != ANGLE_NOT_SET;
+  current_a_odomPID.constants = (boomerang ? boomerangPID : odom_angularPID).constants;
+  current_a_odomPID.timers_reset();
+  xyPID.timers_reset();
+  simOdomSlew = current_drive_direction == rev ? &slew_backward : &slew_forward;
+  simOdomSlew->initialize(slew_on, max_speed, util::distance_to_point(odom_target, odom_current), 0.0);
+  simPath.clear();
+  simAngleExits = boomerang;
+  mode = POINT_TO_POINT;
+}
+
+std::vector<odom> Drive::inject_points(std::vector<odom> imovements) { return sim_inject_points(odom_current, imovements, SPACING, injected_pp_index); }
+std::vector<odom> Drive::smooth_path(std::vector<odom> ipath, double weight_smooth, double weight_data, double tolerance) {
+  return sim_smooth_path(ipath, weight_smooth, weight_data, tolerance);
+}
+
+// Points every SPACING along the straight lines between the ones given (the last of each keeps its angle), then smoothed
+void Drive::raw_pid_odom_pp_set(std::vector<odom> imovements, bool slew_on) {
+  simPath = smooth_path(inject_points(imovements), SIM_SMOOTH_WEIGHT, SIM_SMOOTH_DATA, SIM_SMOOTH_TOLERANCE);
+  simPathLeg.clear();
+  for (size_t leg = 0; leg < injected_pp_index.size(); leg++)
+    while ((int)simPathLeg.size() <= injected_pp_index[leg]) simPathLeg.push_back(leg);
+  simRemaining.assign(simPath.size(), 0.0);
+  for (int p = (int)simPath.size() - 2; p >= 0; p--) simRemaining[p] = simRemaining[p + 1] + util::distance_to_point(simPath[p + 1].target, simPath[p].target);
+
+  simMotionBegin();
+  pp_movements = imovements;
+  pp_index = 0;
+  odom_start = odom_current;
+  odom_target = imovements.back().target;
+  odom_second_to_last = imovements.size() > 1 ? imovements[imovements.size() - 2].target : odom_current;
+  current_drive_direction = simPath[0].drive_direction;
+  max_speed = std::abs(simPath[0].max_xy_speed);
+  current_a_odomPID.constants = odom_angularPID.constants;
+  current_a_odomPID.timers_reset();
+  xyPID.timers_reset();
+  simOdomSlew = current_drive_direction == rev ? &slew_backward : &slew_forward;
+  simOdomSlew->initialize(slew_on, max_speed, util::distance_to_point(simPath[0].target, odom_current) + simRemaining[0], 0.0);
+  simAngleExits = odom_target.theta != ANGLE_NOT_SET;
+  mode = PURE_PURSUIT;
+}
+
+void Drive::pid_odom_set(odom imovement) { pid_odom_set(imovement, imovement.drive_direction == rev ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled); }
+void Drive::pid_odom_set(odom imovement, bool slew_on) { raw_pid_odom_ptp_set(imovement, slew_on); }
+void Drive::pid_odom_set(std::vector<odom> imovements, bool slew_on) {
+  if (imovements.size() == 1) raw_pid_odom_ptp_set(imovements[0], slew_on);
+  else raw_pid_odom_pp_set(imovements, slew_on);
+}
+
+// Straight at the heading it's at, target inches away (backwards if it's negative)
+void Drive::pid_odom_set(double target, int speed) { pid_odom_set(target, speed, target < 0 ? global_backward_drive_slew_enabled : global_forward_drive_slew_enabled); }
+void Drive::pid_odom_set(double target, int speed, bool slew_on) {
+  pose point = util::vector_off_point(target, {odom_current.x, odom_current.y, odom_current.theta});
+  raw_pid_odom_ptp_set({{point.x, point.y, ANGLE_NOT_SET}, target < 0 ? rev : fwd, speed}, slew_on);
+}
+void Drive::pid_odom_set(okapi::QLength p_target, int speed) { pid_odom_set(p_target.convert(okapi::inch), speed); }
+void Drive::pid_odom_set(okapi::QLength p_target, int speed, bool slew_on) { pid_odom_set(p_target.convert(okapi::inch), speed, slew_on); }
+
+// ---- what runs every 10 ms ----
+void Drive::drive_pid_task() {
+  leftPID.compute(drive_sensor_left());
+  rightPID.compute(drive_sensor_right());
+  headingPID.compute(drive_imu_get());
+  double l_out = util::clamp(leftPID.output, slew_left.iterate(drive_sensor_left()));
+  double r_out = util::clamp(rightPID.output, slew_right.iterate(drive_sensor_right()));
+  double gyro_out = heading_on ? headingPID.output : 0.0;
+  l_out += gyro_out;
+  r_out -= gyro_out;
+  // heading correction can push a side past max speed, scale both down so the ratio stays
+  double faster = std::max(std::fabs(l_out), std::fabs(r_out));
+  if (faster > max_speed) {
+    l_out *= max_speed / faster;
+    r_out *= max_speed / faster;
+  }
+  if (drive_toggle) private_drive_set(l_out, r_out);
+}
+
+void Drive::turn_pid_task() {
+  double current = drive_imu_get();
+  turnPID.compute(current);
+  double out = util::clamp(turnPID.output, slew_turn.iterate(current));
+  if (drive_toggle) private_drive_set(out, -out);
+}
+
+void Drive::swing_pid_task() {
+  swingPID.compute(drive_imu_get());
+  double side = current_swing == LEFT_SWING ? drive_sensor_left() : drive_sensor_right();
+  double out = util::clamp(swingPID.output, slew_swing.iterate(side));
+  double opposite = max_speed != 0 ? swing_opposite_speed * out / max_speed : 0.0;
+  if (!drive_toggle) return;
+  if (current_swing == LEFT_SWING) private_drive_set(out, opposite);
+  else private_drive_set(-opposite, -out);
+}
+
+// Point to point, the last point of pure pursuit, and boomerang when the target has an angle
+void Drive::ptp_task() {
+  bool reversed = current_drive_direction == rev;
+  double dist = util::distance_to_point(odom_target, odom_current);
+  pose aim = odom_target;
+  double xy_error;
+  if (mode == PURE_PURSUIT && pp_index < (int)simPath.size() - 1) {
+    aim = simPath[pp_index].target;
+    xy_error = util::distance_to_point(aim, odom_current) + simRemaining[pp_index];
+  } else {
+    bool behind = std::fabs(util::wrap_angle(util::absolute_angle_to_point(odom_target, odom_current) - odom_current.theta - (reversed ? 180.0 : 0.0))) > 90.0;
+    xy_error = behind ? -dist : dist;  // it's gone by it
+    if (odom_target.theta != ANGLE_NOT_SET) {
+      // boomerang: aim at a carrot behind the target on the line the robot should come in on
+      double h = std::min(dlead * dist, max_boomerang_distance);
+      aim = util::vector_off_point(-h, {odom_target.x, odom_target.y, odom_target.theta + (reversed ? 180.0 : 0.0)});
+    }
+  }
+
+  // aim the front (back when reversing) at the point until it's close, then hold. A point that's close and
+  // behind (it overshot) gets backed up to instead of turned around for
+  double travel = odom_current.theta + (reversed ? 180.0 : 0.0);
+  bool aim_behind = dist < LOOK_AHEAD && std::fabs(util::wrap_angle(util::absolute_angle_to_point(aim, odom_current) - travel)) > 90.0;
+  if (!simHolding && dist < SIM_ODOM_HOLD && !(mode == PURE_PURSUIT && pp_index < (int)simPath.size() - 1)) {
+    simHolding = true;
+    simHoldAngle = odom_target.theta != ANGLE_NOT_SET ? odom_target.theta : odom_current.theta;
+  }
+  double a_target = simHolding ? simHoldAngle : util::absolute_angle_to_point(aim, odom_current) + (reversed != aim_behind ? 180.0 : 0.0);
+  double a_error = util::wrap_angle(a_target - odom_current.theta);
+  double a_out = util::clamp(current_a_odomPID.compute_error(a_error, odom_current.theta), max_speed);
+
+  double xy_out = xyPID.compute_error(xy_error, 0.0) * (reversed ? -1.0 : 1.0);
+  xy_out *= std::max(0.0, std::cos(util::to_rad(a_error)));  // don't drive much while pointed the wrong way
+  xy_out = util::clamp(xy_out, simOdomSlew != nullptr ? simOdomSlew->iterate(simTraveled) : max_speed);
+
+  // can't do both at full speed, the turn gets odom_turn_bias_amount of it
+  double l_out = xy_out + a_out, r_out = xy_out - a_out;
+  if (std::max(std::fabs(l_out), std::fabs(r_out)) > max_speed) {
+    a_out = util::clamp(a_out, max_speed * std::min(odom_turn_bias_amount, 1.0));
+    xy_out = util::clamp(xy_out, max_speed - std::fabs(a_out));
+    l_out = xy_out + a_out;
+    r_out = xy_out - a_out;
+  }
+  if (drive_toggle) private_drive_set(l_out, r_out);
+}
+
+void Drive::boomerang_task() { ptp_task(); }
+
+void Drive::pp_task() {
+  // the lookahead point is the first one further than LOOK_AHEAD away
+  int last = simPath.size() - 1;
+  while (pp_index < last && util::distance_to_point(simPath[pp_index].target, odom_current) < LOOK_AHEAD) pp_index++;
+  current_drive_direction = simPath[pp_index].drive_direction;
+  if (!simSpeedOverride) max_speed = std::abs(simPath[pp_index].max_xy_speed);
+  if (pp_index == last) current_a_odomPID.constants = (odom_target.theta != ANGLE_NOT_SET ? boomerangPID : odom_angularPID).constants;
+  ptp_task();
+}
+
+void Drive::ez_auto_task() {
+  double l = drive_sensor_left(), r = drive_sensor_right(), h = drive_imu_get();
+  if (was_odom_just_set) {
+    l_last = l;
+    r_last = r;
+    h_last = h;
+    was_odom_just_set = false;
+  }
+  double distance = ((l - l_last) + (r - r_last)) / 2.0;
+  double mid = util::to_rad(h_last + (h - h_last) / 2.0);
+  odom_current.x += distance * std::sin(mid);
+  odom_current.y += distance * std::cos(mid);
+  odom_current.theta = h;
+  simTraveled += std::fabs(distance);
+  l_last = l;
+  r_last = r;
+  h_last = h;
+
+  switch (mode) {
+    case DRIVE: drive_pid_task(); break;
+    case TURN: turn_pid_task(); break;
+    case SWING: swing_pid_task(); break;
+    case POINT_TO_POINT:
+      if (odom_target.theta != ANGLE_NOT_SET) boomerang_task();
+      else ptp_task();
+      break;
+    case PURE_PURSUIT: pp_task(); break;
+    default: break;
+  }
+}
+
+void sim_drive_task() {
+  std::vector<int> left, right;
+  for (pros::Motor &motor : simChassis->left_motors) left.push_back(motor.get_port());
+  for (pros::Motor &motor : simChassis->right_motors) right.push_back(motor.get_port());
+  sim_world_drive_set(left, right);
+  while (true) {
+    simDriveStep()();
+    pros::delay(util::DELAY_TIME);
+  }
+}
+
+// ---- waits ----
+// The exit conditions for whatever's running, one tick. Two PIDs (drive's sides, odom's xy + boomerang's angle)
+// both have to exit, what's reported is the one that took longer
+struct simExits {
+  exit_output a = RUNNING, b = RUNNING;
+};
+
+static exit_output simExitTick(Drive &d, simExits &e) {
+  std::vector<pros::Motor> sides = {d.left_motors.front(), d.right_motors.front()};
+  exit_output before_a = e.a;
+  switch (d.mode) {
+    case DRIVE:
+      if (e.a == RUNNING) e.a = d.leftPID.exit_condition(d.left_motors.front());
+      if (e.b == RUNNING) e.b = d.rightPID.exit_condition(d.right_motors.front());
+      break;
+    case TURN: e.a = e.b = d.turnPID.exit_condition(sides); break;
+    case SWING: e.a = e.b = d.swingPID.exit_condition(d.current_swing == LEFT_SWING ? d.left_motors.front() : d.right_motors.front()); break;
+    case POINT_TO_POINT:
+    case PURE_PURSUIT:
+      if (e.a == RUNNING) e.a = d.xyPID.exit_condition(sides);
+      if (!simAngleExits) e.b = e.a;
+      else if (e.b == RUNNING) e.b = d.current_a_odomPID.exit_condition(sides);
+      break;
+    default: return ERROR_NO_CONSTANTS;
+  }
+  if (e.a == RUNNING || e.b == RUNNING) return RUNNING;
+  return before_a == RUNNING ? e.a : e.b;
+}
+
+static std::string simExitName(exit_output exit) {
+  switch (exit) {
+    case SMALL_EXIT: return "SMALL";
+    case BIG_EXIT: return "BIG";
+    case VELOCITY_EXIT: return "VELOCITY";
+    case mA_EXIT: return "mA";
+    case ERROR_NO_CONSTANTS: return "NO_CONSTANTS";
+    default: return "RUNNING";
+  }
+}
+
+static std::string simModeName(e_mode mode) {
+  switch (mode) {
+    case DRIVE: return "drive";
+    case TURN: return "turn";
+    case SWING: return "swing";
+    case POINT_TO_POINT: return "point_to_point";
+    case PURE_PURSUIT: return "pure_pursuit";
+    default: return "none";
+  }
+}
+
+static void simLegEnd(Drive &d, const char *wait, const std::string &exit) {
+  const sim_robot &r = simWorld.robot;
+  simLegs.push_back({simMotion, wait, simModeName(d.mode), simMotionStart, pros::millis(), exit, r.x, r.y, r.theta});
+}
+
+// Waits a tick at a time until the motion exits or passed() says it went by what it's waiting for
+static std::string simWaitFor(Drive &d, const std::function<bool()> &passed) {
+  if (d.mode == DISABLE) return "NONE";
+  simExits exits;
+  while (true) {
+    pros::delay(util::DELAY_TIME);
+    exit_output exit = simExitTick(d, exits);
+    if (exit != RUNNING) return simExitName(exit);
+    if (passed()) return "PASSED";
+  }
+}
+
+void Drive::pid_wait() { simLegEnd(*this, "pid_wait", simWaitFor(*this, [] { return false; })); }
+
+static const char *simWaitName = "pid_wait_until";  // what the wait_until_* below get reported as
+
+// Drive motions: until both sides are past target inches from where they started
+void Drive::wait_until_drive(double target) {
+  double l_target = l_start + target, r_target = r_start + target;
+  int l_sgn = util::sgn(l_target - drive_sensor_left()), r_sgn = util::sgn(r_target - drive_sensor_right());
+  simLegEnd(*this, simWaitName, simWaitFor(*this, [&] {
+              return util::sgn(l_target - drive_sensor_left()) != l_sgn && util::sgn(r_target - drive_sensor_right()) != r_sgn;
+            }));
+}
+
+// Turns and swings: until the IMU is past target
+void Drive::wait_until_turn_swing(double target) {
+  int sgn = util::sgn(target - drive_imu_get());
+  simLegEnd(*this, simWaitName, simWaitFor(*this, [&] { return util::sgn(target - drive_imu_get()) != sgn; }));
+}
+
+// Odom motions: until it's past target on the last leg
+static void simWaitUntilPast(Drive &d, pose target, const std::function<double(pose)> &past, const std::function<bool()> &last_leg) {
+  simLegEnd(d, simWaitName, simWaitFor(d, [&] { return last_leg() && past(target) < 0; }));
+}
+
+void Drive::pid_wait_until(okapi::QLength target) {
+  simWaitName = "pid_wait_until";
+  if (mode == DRIVE) return wait_until_drive(target.convert(okapi::inch));
+  double distance = std::fabs(target.convert(okapi::inch));  // odom motions: until it's gone that far
+  simLegEnd(*this, simWaitName, simWaitFor(*this, [&] { return simTraveled >= distance; }));
+}
+
+void Drive::pid_wait_until_point(pose target) {
+  target.theta = util::absolute_angle_to_point(target, odom_current);  // past it the way it's heading there now
+  simLegEnd(*this, "pid_wait_until_point", simWaitFor(*this, [&] {
+              return util::distance_to_point(target, odom_current) < 0.5 || is_past_target(target, odom_current) < 0;
+            }));
+}
+
+// Pure pursuit: until the lookahead is past the point index (in the list given to pid_odom_set())
+void Drive::pid_wait_until_index(int index) {
+  if (mode != PURE_PURSUIT || index >= simPathLeg.back()) return pid_wait_quick();
+  simLegEnd(*this, "pid_wait_until_index", simWaitFor(*this, [&] { return simPathLeg[pp_index] > index; }));
+}
+
+void Drive::pid_wait_until_index_started(int index) {
+  if (mode != PURE_PURSUIT) return pid_wait_quick();
+  simLegEnd(*this, "pid_wait_until_index_started", simWaitFor(*this, [&] { return simPathLeg[pp_index] >= index; }));
+}
+
+void Drive::pid_wait_quick() {
+  simWaitName = "pid_wait_quick";
+  switch (mode) {
+    case DRIVE: return wait_until_drive(leftPID.target_get() - l_start);
+    case TURN: return wait_until_turn_swing(turnPID.target_get());
+    case SWING: return wait_until_turn_swing(swingPID.target_get());
+    case POINT_TO_POINT:
+    case PURE_PURSUIT:
+      return simWaitUntilPast(*this, odom_target, [this](pose target) { return is_past_target(target, odom_current); },
+                              [this] { return mode != PURE_PURSUIT || pp_index == (int)simPath.size() - 1; });
+    default: simLegEnd(*this, simWaitName, "NONE");
+  }
+}
+
+// Moves the target further by the chain constant, and waits until it's past the one it was given
+void Drive::pid_wait_quick_chain() {
+  simWaitName = "pid_wait_quick_chain";
+  switch (mode) {
+    case DRIVE: {
+      double target = leftPID.target_get() - l_start;
+      used_motion_chain_scale = target < 0 ? drive_backward_motion_chain_scale : drive_forward_motion_chain_scale;
+      leftPID.target_set(leftPID.target_get() + util::sgn(target) * used_motion_chain_scale);
+      rightPID.target_set(rightPID.target_get() + util::sgn(target) * used_motion_chain_scale);
+      return wait_until_drive(target);
+    }
+    case TURN:
+    case SWING: {
+      PID &pid = mode == TURN ? turnPID : swingPID;
+      double target = pid.target_get();
+      used_motion_chain_scale = mode == TURN ? turn_motion_chain_scale : swing_forward_motion_chain_scale;
+      pid.target_set(target + util::sgn(target - drive_imu_get()) * used_motion_chain_scale);
+      return wait_until_turn_swing(target);
+    }
+    case POINT_TO_POINT:
+    case PURE_PURSUIT: {
+      pose target = odom_target;
+      bool reversed = (mode == PURE_PURSUIT ? simPath.back().drive_direction : current_drive_direction) == rev;
+      used_motion_chain_scale = reversed ? drive_backward_motion_chain_scale : drive_forward_motion_chain_scale;
+      double along = target.theta != ANGLE_NOT_SET ? target.theta + (reversed ? 180.0 : 0.0) : util::absolute_angle_to_point(target, odom_second_to_last);
+      pose further = util::vector_off_point(used_motion_chain_scale, {target.x, target.y, along});
+      odom_target.x = further.x;
+      odom_target.y = further.y;
+      if (mode == PURE_PURSUIT) simPath.back().target = odom_target;
+      return simWaitUntilPast(*this, target, [this](pose t) { return is_past_target(t, odom_current); },
+                              [this] { return mode != PURE_PURSUIT || pp_index == (int)simPath.size() - 1; });
+    }
+    default: simLegEnd(*this, simWaitName, "NONE");
+  }
+}
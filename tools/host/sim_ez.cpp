@@ -0,0 +1,220 @@
+// The plain math half of the host EZ-Template port (see sim_drive.cpp for the chassis half and where all of it
+// comes from): ez::util, ez::PID, ez::slew, ez::Auton and the pure pursuit path prep. Nothing in here touches
+// a device, so tools/bench links it on its own to time the per-tick primitives.
+#include <cmath>
+
+#include "sim_ez.hpp"
+
+using namespace ez;
+
+// ---- ez::util ----
+namespace ez {
+namespace util {
+int sgn(double input) { return input > 0 ? 1 : input < 0 ? -1 : 0; }
+double clamp(double input, double max, double min) { return input > max ? max : input < min ? min : input; }
+double clamp(double input, double max) { return clamp(input, std::fabs(max), -std::fabs(max)); }
+double to_deg(double input) { return input * 180.0 / M_PI; }
+double to_rad(double input) { return input * M_PI / 180.0; }
+double absolute_angle_to_point(pose itarget, pose icurrent) { return to_deg(std::atan2(itarget.x - icurrent.x, itarget.y - icurrent.y)); }
+double distance_to_point(pose itarget, pose icurrent) { return std::hypot(itarget.x - icurrent.x, itarget.y - icurrent.y); }
+double wrap_angle(double theta) {
+  theta = std::fmod(theta + 180.0, 360.0);
+  if (theta < 0) theta += 360.0;
+  return theta - 180.0;
+}
+pose vector_off_point(double added, pose icurrent) {
+  return {icurrent.x + added * std::sin(to_rad(icurrent.theta)), icurrent.y + added * std::cos(to_rad(icurrent.theta)), icurrent.theta};
+}
+// the same angle as target, the one closest to current
+double turn_shortest(double target, double current, bool) { return current + wrap_angle(target - current); }
+// the same angle as target, the other way around
+double turn_longest(double target, double current, bool) {
+  double nearest = turn_shortest(target, current);
+  return nearest > current ? nearest - 360.0 : nearest + 360.0;
+}
+}  // namespace util
+
+std::string exit_to_string(exit_output input) {
+  switch (input) {
+    case RUNNING: return "Running";
+    case SMALL_EXIT: return "Small";
+    case BIG_EXIT: return "Big";
+    case VELOCITY_EXIT: return "Velocity";
+    case mA_EXIT: return "mA";
+    case ERROR_NO_CONSTANTS: return "Error: Exit condition constants not set!";
+  }
+  return "Error: Out of bounds!";
+}
+
+// ---- ez::PID ---- (the exit conditions that read motors are in sim_drive.cpp)
+PID::PID() {}
+PID::PID(double p, double i, double d, double start_i, std::string name) {
+  constants_set(p, i, d, start_i);
+  name_set(name);
+}
+void PID::constants_set(double p, double i, double d, double p_start_i) { constants = {p, i, d, p_start_i}; }
+PID::Constants PID::constants_get() { return constants; }
+bool PID::constants_set_check() { return constants.kp != 0 || constants.ki != 0 || constants.kd != 0; }
+void PID::exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout) {
+  exit = {p_small_exit_time, p_small_error, p_big_exit_time, p_big_error, p_velocity_exit_time, p_mA_timeout};
+}
+void PID::target_set(double input) { target = input; }
+double PID::target_get() { return target; }
+void PID::variables_reset() {
+  output = error = prev_error = integral = derivative = 0.0;
+  time = prev_time = 0;
+}
+void PID::timers_reset() {
+  i = j = k = l = m = 0;
+  is_mA = false;
+}
+void PID::name_set(std::string p_name) {
+  name = p_name;
+  name_active = !name.empty();
+}
+std::string PID::name_get() { return name; }
+void PID::i_reset_toggle(bool toggle) { reset_i_sgn = toggle; }
+bool PID::i_reset_get() { return reset_i_sgn; }
+void PID::velocity_sensor_secondary_set(double secondary_sensor) { second_sensor = secondary_sensor; }
+double PID::velocity_sensor_secondary_get() { return second_sensor; }
+void PID::velocity_sensor_secondary_toggle_set(bool toggle) { use_second_sensor = toggle; }
+bool PID::velocity_sensor_secondary_toggle_get() { return use_second_sensor; }
+void PID::velocity_sensor_main_exit_set(double zero) { velocity_zero_main = zero; }
+double PID::velocity_sensor_main_exit_get() { return velocity_zero_main; }
+void PID::velocity_sensor_secondary_exit_set(double zero) { velocity_zero_secondary = zero; }
+double PID::velocity_sensor_secondary_exit_get() { return velocity_zero_secondary; }
+void PID::exit_condition_print(exit_output) {}
+
+double PID::compute(double current) { return compute_error(target - current, current); }
+double PID::compute_error(double err, double current) {
+  error = err;
+  cur = current;
+  return raw_compute();
+}
+double PID::raw_compute() {
+  derivative = error - prev_error;  // per DELAY_TIME, every PID gets computed once a tick
+  if (constants.ki != 0) {
+    if (std::fabs(error) < constants.start_i) integral += error;
+    if (reset_i_sgn && util::sgn(error) != util::sgn(prev_error)) integral = 0;
+  }
+  output = error * constants.kp + integral * constants.ki + derivative * constants.kd;
+  prev_error = error;
+  prev_current = cur;
+  return output;
+}
+
+// Called once a tick while waiting, each timer counts how long its condition has held
+exit_output PID::exit_condition(bool) {
+  if (!constants_set_check()) return ERROR_NO_CONSTANTS;
+  if (exit.small_error != 0) {
+    if (std::fabs(error) < exit.small_error) {
+      j += util::DELAY_TIME;
+      i = 0;  // inside small error, so big error's timer starts over
+      if (j > exit.small_exit_time) {
+        timers_reset();
+        return SMALL_EXIT;
+      }
+    } else {
+      j = 0;
+    }
+  }
+  if (exit.big_error != 0 && exit.big_exit_time != 0) {
+    if (std::fabs(error) < exit.big_error) {
+      i += util::DELAY_TIME;
+      if (i > exit.big_exit_time) {
+        timers_reset();
+        return BIG_EXIT;
+      }
+    } else {
+      i = 0;
+    }
+  }
+  if (exit.velocity_exit_time != 0) {
+    if (std::fabs(derivative) <= velocity_zero_main) {
+      k += util::DELAY_TIME;
+      if (k > exit.velocity_exit_time) {
+        timers_reset();
+        return VELOCITY_EXIT;
+      }
+    } else {
+      k = 0;
+    }
+  }
+  return RUNNING;
+}
+
+
+// ---- ez::Auton ----
+Auton::Auton() {}
+Auton::Auton(std::string name, std::function<void()> callback) : Name(name), auton_call(callback) {}
+
+// ---- ez::slew ----
+slew::slew() {}
+slew::slew(double distance, int minimum_speed) { constants_set(distance, minimum_speed); }
+void slew::constants_set(double distance, int minimum_speed) {
+  constants.distance_to_travel = distance;
+  constants.min_speed = minimum_speed;
+}
+slew::Constants slew::constants_get() { return constants; }
+
+// A line from min speed at the start to max speed distance_to_travel later
+void slew::initialize(bool enabled, double maximum_speed, double target, double current) {
+  max_speed = maximum_speed;
+  sign = util::sgn(target - current);
+  is_enabled = enabled && sign != 0 && constants.distance_to_travel != 0;
+  x_intercept = current + constants.distance_to_travel * sign;
+  y_intercept = max_speed * sign;
+  if (is_enabled) slope = (sign * constants.min_speed - y_intercept) / (x_intercept - current);
+}
+double slew::iterate(double current) {
+  if (is_enabled) {
+    error = x_intercept - current;
+    if (util::sgn(error) != sign) is_enabled = false;  // made it past the ramp
+    else last_output = (slope * error + y_intercept) * sign;
+  }
+  if (!is_enabled) last_output = max_speed;
+  return last_output;
+}
+bool slew::enabled() { return is_enabled; }
+double slew::output() { return last_output; }
+void slew::speed_max_set(double speed) { max_speed = speed; }
+double slew::speed_max_get() { return max_speed; }
+
+}  // namespace ez
+
+// ---- pure pursuit path prep ----
+std::vector<odom> sim_inject_points(pose start, const std::vector<odom> &movements, double spacing, std::vector<int> &leg_end) {
+  std::vector<odom> path;
+  leg_end.clear();
+  pose from = start;
+  for (const odom &to : movements) {
+    int points = std::max(1, (int)std::ceil(util::distance_to_point(to.target, from) / spacing));
+    for (int p = 1; p <= points; p++) {
+      double f = (double)p / points;
+      pose point = {from.x + (to.target.x - from.x) * f, from.y + (to.target.y - from.y) * f, p == points ? to.target.theta : ANGLE_NOT_SET};
+      path.push_back({point, to.drive_direction, to.max_xy_speed, to.turn_behavior});
+    }
+    leg_end.push_back((int)path.size() - 1);
+    from = to.target;
+  }
+  return path;
+}
+
+// Gradient descent: every point but the ends gets pulled toward where it was (weight_data) and toward the middle
+// of its neighbours (weight_smooth) until a whole pass moves everything less than tolerance
+std::vector<odom> sim_smooth_path(const std::vector<odom> &path, double weight_smooth, double weight_data, double tolerance) {
+  std::vector<odom> smooth = path;
+  double change = tolerance;
+  while (change >= tolerance) {
+    change = 0.0;
+    for (size_t i = 1; i + 1 < path.size(); i++) {
+      for (double pose::*axis : {&pose::x, &pose::y}) {
+        double before = smooth[i].target.*axis;
+        smooth[i].target.*axis += weight_data * (path[i].target.*axis - before) +
+                                  weight_smooth * (smooth[i - 1].target.*axis + smooth[i + 1].target.*axis - 2.0 * before);
+        change += std::fabs(before - smooth[i].target.*axis);
+      }
+    }
+  }
+  return smooth;
+}
@@ -0,0 +1,16 @@
+// Host EZ-Template port, the plain math half (sim_ez.cpp). ez::util, ez::PID and ez::slew are declared in
+// EZ-Template's own headers, these are the pure pursuit helpers ez::Drive keeps private.
+#pragma once
+
+#include <vector>
+
+#include "EZ-Template/api.hpp"
+
+const double SIM_SMOOTH_WEIGHT = 0.75;     // pure pursuit smoothing, how hard points get pulled to their neighbours
+const double SIM_SMOOTH_DATA = 0.03;       // how hard they get pulled back to the straight lines
+const double SIM_SMOOTH_TOLERANCE = 0.0001;  // in, smoothing stops once a pass moves everything less than this
+
+// Points every spacing inches along the straight lines from start through movements, the last point of each
+// leg is the one given (angle and all). leg_end gets the index of each leg's last point
+std::vector<ez::odom> sim_inject_points(ez::pose start, const std::vector<ez::odom> &movements, double spacing, std::vector<int> &leg_end);
+std::vector<ez::odom> sim_smooth_path(const std::vector<ez::odom> &path, double weight_smooth, double weight_data, double tolerance);
@@ -0,0 +1,29 @@
+// The robot-only parts of our own code the autons call, for the host simulator (see tools/sim/sim_world.hpp).
+// Battery compensation, the gain schedule, the S-curve slew and the feedforward are the real src/ files with their
+// tasks running (sim_auton.cpp starts them), since they change how every motion drives. What's left here hooks
+// into tasks the simulator doesn't run (thermal, memory, telemetry, the trace), so the autons get those turned off.
+#include "memory_monitor.hpp"
+#include "param_table.hpp"
+#include "sim_world.hpp"
+#include "sysid.hpp"
+#include "telemetry.hpp"
+#include "thermal_model.hpp"
+#include "trace_log.hpp"
+
+bool traceOn = false;
+
+void trace_write(trace_event, char, int) {}
+void trace_task_name(const char *) {}
+
+int memory_monitor_register(const char *, int) { return -1; }
+void memory_monitor_sample(int) {}
+
+void telemetry_color_event(telemetry_color_kind, int, int) {}
+
+bool sysid_running() { return false; }
+bool param_table_editing() { return false; }
+bool param_table_tuning() { return false; }
+
+thermal_motor_state thermal_state_get(thermal_motor) { return thermal_motor_state(); }
+thermal_motor thermal_worst_get() { return THERMAL_LEFT_1; }
+const char *thermal_motor_name(thermal_motor) { return "--"; }
@@ -0,0 +1,104 @@
+// PROS's RTOS on a virtual clock, for the host simulator (see tools/sim/sim_world.hpp).
+// Every pros::Task is a thread, but only one ever runs at a time: a task runs until it calls pros::delay(),
+// then whichever task wakes up soonest goes next (ties go to the task that was made first, so the world
+// task made first steps before anything reads it). Time only moves when everyone's asleep, so a 15 s auton
+// takes as long as its code takes to run and comes out the same every time.
+// Mutexes don't need to do anything, nothing can get in between a take() and a give() unless it delays.
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "api.h"
+
+namespace {
+struct simTask {
+  pros::task_fn_t function;
+  void *parameters;
+  std::uint64_t wake = 0;  // us
+  int order = 0;           // made this many tasks in
+  bool done = false;
+  std::condition_variable turn;  // its own, so handing over wakes just the one thread
+};
+
+std::mutex simLock;
+std::vector<simTask *> simTasks;
+simTask *simRunning = nullptr;
+std::uint64_t simNow = 0;  // us
+int simMade = 0;
+
+// Hands the baton to whoever's next, then waits for it to come back to me (unless I'm done)
+void simSwitch(std::unique_lock<std::mutex> &held, simTask *me) {
+  simTask *next = nullptr;
+  for (simTask *t : simTasks)
+    if (!t->done && (next == nullptr || t->wake < next->wake || (t->wake == next->wake && t->order < next->order))) next = t;
+  if (next == nullptr) return;  // nothing left to run
+  if (next->wake > simNow) simNow = next->wake;
+  simRunning = next;
+  next->turn.notify_one();
+  if (me != nullptr && !me->done) me->turn.wait(held, [me] { return simRunning == me; });
+}
+
+void simStart(simTask *t) {
+  {
+    std::unique_lock<std::mutex> held(simLock);
+    t->turn.wait(held, [t] { return simRunning == t; });
+  }
+  t->function(t->parameters);
+  std::unique_lock<std::mutex> held(simLock);
+  t->done = true;
+  simSwitch(held, t);
+}
+
+simTask *simAdd(pros::task_fn_t function, void *parameters) {
+  simTask *t = new simTask{function, parameters, simNow, simMade++, false, {}};
+  std::lock_guard<std::mutex> held(simLock);
+  simTasks.push_back(t);
+  return t;
+}
+}  // namespace
+
+// The thread that calls this becomes a task too (the first one), so it can make the rest and delay like they do
+void sim_rtos_start() {
+  simTask *me = simAdd(nullptr, nullptr);
+  std::lock_guard<std::mutex> held(simLock);
+  simRunning = me;
+}
+
+namespace pros {
+inline namespace rtos {
+Task::Task(task_fn_t function, void *parameters, std::uint32_t, std::uint16_t, const char *) {
+  simTask *t = simAdd(function, parameters);
+  std::thread(simStart, t).detach();  // waits for its turn, which comes the next time the caller delays
+}
+
+Task::Task(task_fn_t function, void *parameters, const char *name) : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task) : task(task) {}  // ez::Drive's ez_auto, sim_drive.cpp runs the drive instead
+
+void Task::delay(const std::uint32_t milliseconds) { pros::c::delay(milliseconds); }
+
+Mutex::Mutex() {}
+bool Mutex::take() { return true; }
+bool Mutex::take(std::uint32_t) { return true; }
+bool Mutex::give() { return true; }
+}  // namespace rtos
+
+namespace c {
+extern "C" {
+void delay(const std::uint32_t milliseconds) {
+  std::unique_lock<std::mutex> held(simLock);
+  simTask *me = simRunning;
+  me->wake = simNow + 1000ull * milliseconds;
+  simSwitch(held, me);
+}
+
+void task_delay(const std::uint32_t milliseconds) { delay(milliseconds); }
+
+std::uint32_t millis() { return simNow / 1000; }
+
+std::uint64_t micros() { return simNow; }
+}
+}  // namespace c
+}  // namespace pros
@@ -0,0 +1,143 @@
+// Auton regression benchmark: every auton in the selector, run in the host simulator (sim_world.hpp), timed
+// leg by leg. Same code + same numbers = same output, so the JSON is meant to be diffed between commits:
+// a constant that costs 200 ms on the third leg of Red Positive Elim shows up as exactly that.
+// Build + run from the repo root (see tools/sim/Makefile):
+//   make -C tools/sim                 # run, print the report
+//   make -C tools/sim reference       # run and save tools/sim/auton_reference.json (committed)
+//   make -C tools/sim check           # run and fail if an auton got slower or ends somewhere else
+// Or by hand:
+//   ./auton_bench [--json out.json] [--save-reference ref.json] [--check ref.json] [--time-tolerance 100] [--pose-tolerance 2]
+//                 [--battery 12.8] [--mass 15] [--no-compensation]
+// --battery/--mass run the robot on a different resting battery (V) or weight (lb), check against a reference
+// saved at the defaults to see what a tired battery costs each auton. --no-compensation turns battery
+// compensation (battery_compensation.hpp) off, make -C tools/sim battery runs all four.
+// Times are virtual ms from the auton starting. The end pose is the simulator's ground truth, error is how far
+// that is from the reference. Exits count how each wait ended: SMALL/BIG/VELOCITY/mA exit conditions,
+// PASSED when a wait_until/quick/chain went by its target, NONE when nothing was running.
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "battery_compensation.hpp"
+#include "sim_auton.hpp"
+
+const char *EXITS[] = {"SMALL", "BIG", "VELOCITY", "mA", "PASSED", "NONE", "NO_CONSTANTS"};
+const int EXIT_KINDS = sizeof(EXITS) / sizeof(EXITS[0]);
+
+struct bench_reference {
+  std::string name;
+  std::uint32_t time_ms = 0;
+  double x = 0.0, y = 0.0, theta = 0.0;
+};
+
+static void benchWrite(FILE *file, const std::vector<sim_result> &results, const std::vector<bench_reference> &reference) {
+  fprintf(file, "{\n  \"autons\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const sim_result &r = results[i];
+    fprintf(file, "    {\"name\": \"%s\", \"time_ms\": %u, \"settled_ms\": %u, \"timed_out\": %s, \"x\": %.2f, \"y\": %.2f, \"theta\": %.2f, "
+                  "\"odom_x\": %.2f, \"odom_y\": %.2f, \"odom_theta\": %.2f",
+            r.name.c_str(), r.time_ms, r.settled_ms, r.timed_out ? "true" : "false", r.x, r.y, r.theta, r.odom_x, r.odom_y, r.odom_theta);
+    for (const bench_reference &ref : reference)
+      if (ref.name == r.name) fprintf(file, ", \"error_in\": %.2f, \"error_deg\": %.2f", std::hypot(r.x - ref.x, r.y - ref.y), r.theta - ref.theta);
+    fprintf(file, ",\n      \"exits\": {");
+    for (int e = 0; e < EXIT_KINDS; e++) {
+      int count = 0;
+      for (const sim_leg &leg : r.legs) count += leg.exit == EXITS[e];
+      fprintf(file, "\"%s\": %d%s", EXITS[e], count, e + 1 < EXIT_KINDS ? ", " : "");
+    }
+    fprintf(file, "},\n      \"legs\": [\n");
+    for (size_t l = 0; l < r.legs.size(); l++) {
+      const sim_leg &leg = r.legs[l];
+      fprintf(file, "        {\"motion\": %d, \"wait\": \"%s\", \"mode\": \"%s\", \"start_ms\": %u, \"end_ms\": %u, \"ms\": %u, \"exit\": \"%s\"}%s\n", leg.motion,
+              leg.wait.c_str(), leg.mode.c_str(), leg.start, leg.end, leg.end - leg.start, leg.exit.c_str(), l + 1 < r.legs.size() ? "," : "");
+    }
+    fprintf(file, "      ]}%s\n", i + 1 < results.size() ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+}
+
+// Reads back the auton lines benchWrite wrote (only that, it's not a real JSON parser)
+static std::vector<bench_reference> benchLoad(const char *path) {
+  std::vector<bench_reference> reference;
+  FILE *file = fopen(path, "r");
+  if (file == nullptr) return reference;
+  char line[1024];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    char name[128];
+    bench_reference r;
+    if (sscanf(line, " {\"name\": \"%127[^\"]\", \"time_ms\": %u, \"settled_ms\": %*u, \"timed_out\": %*[a-z], \"x\": %lf, \"y\": %lf, \"theta\": %lf",
+               name, &r.time_ms, &r.x, &r.y, &r.theta) == 5) {
+      r.name = name;
+      reference.push_back(r);
+    }
+  }
+  fclose(file);
+  return reference;
+}
+
+int main(int argc, char **argv) {
+  const char *json = nullptr, *save = nullptr, *check = nullptr;
+  double time_tolerance = 100.0;  // ms
+  double pose_tolerance = 2.0;    // in
+  sim_params params;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) json = argv[++i];
+    else if (std::strcmp(argv[i], "--save-reference") == 0 && i + 1 < argc) save = argv[++i];
+    else if (std::strcmp(argv[i], "--check") == 0 && i + 1 < argc) check = argv[++i];
+    else if (std::strcmp(argv[i], "--time-tolerance") == 0 && i + 1 < argc) time_tolerance = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--pose-tolerance") == 0 && i + 1 < argc) pose_tolerance = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--battery") == 0 && i + 1 < argc) params.battery = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--mass") == 0 && i + 1 < argc) params.mass = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--no-compensation") == 0) battery_compensation_enable(false);  // every run's forked from here
+  }
+
+  std::vector<bench_reference> reference;
+  if (check != nullptr) {
+    reference = benchLoad(check);
+    if (reference.empty()) {
+      printf("no reference in %s, save one with --save-reference first\n", check);
+      return 2;
+    }
+  }
+
+  std::vector<sim_result> results;
+  printf("%-36s %8s %8s %8s %8s %8s %5s\n", "auton", "ms", "settled", "x", "y", "theta", "legs");
+  for (size_t a = 0; a < autonList.size(); a++) {
+    sim_result r = sim_auton_run(a, params);
+    printf("%-36s %8u %8u %8.2f %8.2f %8.2f %5zu%s\n", r.name.c_str(), r.time_ms, r.settled_ms, r.x, r.y, r.theta, r.legs.size(), r.timed_out ? "  TIMED OUT" : "");
+    results.push_back(r);
+  }
+
+  int regressions = 0;
+  if (check != nullptr) {
+    printf("\n%-36s %8s %8s %8s %9s\n", "vs reference", "old ms", "new ms", "change", "error in");
+    for (const sim_result &r : results) {
+      const bench_reference *old = nullptr;
+      for (const bench_reference &ref : reference)
+        if (ref.name == r.name) old = &ref;
+      if (old == nullptr) {
+        printf("%-36s %8s %8u %8s\n", r.name.c_str(), "-", r.time_ms, "new");
+        continue;
+      }
+      int change = (int)r.time_ms - (int)old->time_ms;
+      double error = std::hypot(r.x - old->x, r.y - old->y);
+      bool worse = r.timed_out || change > time_tolerance || error > pose_tolerance;
+      regressions += worse;
+      printf("%-36s %8u %8u %+8d %9.2f%s\n", r.name.c_str(), old->time_ms, r.time_ms, change, error, worse ? "  WORSE" : "");
+    }
+    printf("%d slower by more than %.0f ms or ending more than %.1f in off\n", regressions, time_tolerance, pose_tolerance);
+  }
+
+  for (const char *path : {json, save}) {
+    if (path == nullptr) continue;
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+      printf("couldn't write %s\n", path);
+      return 2;
+    }
+    benchWrite(file, results, path == save ? std::vector<bench_reference>() : reference);
+    fclose(file);
+    printf("saved %s\n", path);
+  }
+  return regressions > 0 ? 1 : 0;
+}
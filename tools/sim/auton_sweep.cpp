@@ -0,0 +1,224 @@
+// Monte Carlo robustness sweep: every auton, run --runs times in the host simulator (sim_world.hpp) on a robot
+// that's a little different each time, spread over every core. One clean run (auton_bench) says how fast an
+// auton is, this says how much of that survives a worn wheel, a tired battery or a slippery field, and which
+// legs fall apart first.
+// Each run draws (seeded, so a sweep can be rerun exactly):
+//   wheel diameter   3.25" +- SWEEP_WHEEL_SIGMA (the code always thinks 3.25)
+//   IMU scale        1 +- SWEEP_IMU_SCALE_SIGMA
+//   track width      11.5" +- SWEEP_TRACK_SIGMA. Stands in for the tracking wheel offsets: our chassis doesn't
+//                    use its tracking wheels (see subsystems.cpp), so the offset that matters is where the drive
+//                    wheels actually scrub
+//   carpet grip      SWEEP_FRICTION_MIN -> MAX
+//   battery          SWEEP_BATTERY_MIN -> MAX volts
+//   sensor noise     IMU and drive encoder noise, 0 -> SWEEP_*_NOISE_MAX per reading
+// Errors are against the unperturbed run: where the robot really is at the end of each leg vs where the
+// nominal robot is, so it's how far the variation pushed it, not how far odom thinks it is.
+// Build + run from the repo root (see tools/sim/Makefile):
+//   make -C tools/sim sweep                        # 1000 runs per auton, report to auton_sweep.json
+//   ./auton_sweep [--runs 1000] [--jobs N] [--auton "Red Positive"] [--seed 1] [--json out.json]
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+
+#include "sim_auton.hpp"
+
+const double SWEEP_WHEEL_SIGMA = 0.02;      // in
+const double SWEEP_IMU_SCALE_SIGMA = 0.003;
+const double SWEEP_TRACK_SIGMA = 0.3;       // in
+const double SWEEP_FRICTION_MIN = 0.8;
+const double SWEEP_FRICTION_MAX = 1.15;
+const double SWEEP_BATTERY_MIN = 11.5;      // V, where we swap batteries
+const double SWEEP_BATTERY_MAX = 12.9;      // V, off the charger
+const double SWEEP_IMU_NOISE_MAX = 0.05;    // deg
+const double SWEEP_ENCODER_NOISE_MAX = 1.0;  // deg
+const int SWEEP_FRAGILE = 10;               // legs in the "most fragile" list
+
+const double PERCENTILES[] = {5, 50, 95, 99, 100};
+const int PERCENTILE_COUNT = sizeof(PERCENTILES) / sizeof(PERCENTILES[0]);
+
+struct sweep_stats {
+  double p[PERCENTILE_COUNT] = {};  // p5, p50, p95, p99, max
+};
+
+struct sweep_leg {
+  sim_leg nominal;
+  int runs = 0;  // runs that got to this leg on the same wait (a run that times out early doesn't)
+  sweep_stats ms, error;
+};
+
+struct sweep_auton {
+  sim_result nominal;
+  int runs = 0, timed_out = 0;
+  sweep_stats time, settled, error;
+  std::vector<sweep_leg> legs;
+};
+
+static sim_params sweepParams(std::mt19937 &rng) {
+  std::normal_distribution<double> normal(0.0, 1.0);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  sim_params params;
+  params.wheel_diameter += SWEEP_WHEEL_SIGMA * normal(rng);
+  params.imu_scale += SWEEP_IMU_SCALE_SIGMA * normal(rng);
+  params.track_width += SWEEP_TRACK_SIGMA * normal(rng);
+  params.friction = SWEEP_FRICTION_MIN + (SWEEP_FRICTION_MAX - SWEEP_FRICTION_MIN) * unit(rng);
+  params.battery = SWEEP_BATTERY_MIN + (SWEEP_BATTERY_MAX - SWEEP_BATTERY_MIN) * unit(rng);
+  params.imu_noise = SWEEP_IMU_NOISE_MAX * unit(rng);
+  params.encoder_noise = SWEEP_ENCODER_NOISE_MAX * unit(rng);
+  params.seed = rng();
+  return params;
+}
+
+// Nearest rank
+static sweep_stats sweepStats(std::vector<double> values) {
+  sweep_stats s;
+  if (values.empty()) return s;
+  std::sort(values.begin(), values.end());
+  for (int i = 0; i < PERCENTILE_COUNT; i++) {
+    size_t rank = (size_t)std::ceil(PERCENTILES[i] / 100.0 * values.size());
+    s.p[i] = values[std::clamp(rank, (size_t)1, values.size()) - 1];
+  }
+  return s;
+}
+
+// Runs every params, at most jobs at a time
+static std::vector<sim_result> sweepRun(int auton, const std::vector<sim_params> &params, int jobs) {
+  std::vector<sim_result> results;
+  std::deque<sim_child> running;
+  for (const sim_params &p : params) {
+    if ((int)running.size() >= jobs) {
+      results.push_back(sim_auton_finish(running.front()));
+      running.pop_front();
+    }
+    running.push_back(sim_auton_start(auton, p));
+  }
+  for (const sim_child &child : running) results.push_back(sim_auton_finish(child));
+  return results;
+}
+
+static sweep_auton sweepSummarize(const sim_result &nominal, const std::vector<sim_result> &results) {
+  sweep_auton s;
+  s.nominal = nominal;
+  s.runs = results.size();
+  std::vector<double> time, settled, error;
+  for (const sim_result &r : results) {
+    s.timed_out += r.timed_out;
+    time.push_back(r.time_ms);
+    settled.push_back(r.settled_ms);
+    error.push_back(std::hypot(r.x - nominal.x, r.y - nominal.y));
+  }
+  s.time = sweepStats(time);
+  s.settled = sweepStats(settled);
+  s.error = sweepStats(error);
+
+  for (size_t l = 0; l < nominal.legs.size(); l++) {
+    const sim_leg &n = nominal.legs[l];
+    sweep_leg leg;
+    leg.nominal = n;
+    std::vector<double> ms, err;
+    for (const sim_result &r : results) {
+      if (l >= r.legs.size() || r.legs[l].motion != n.motion || r.legs[l].wait != n.wait) continue;
+      ms.push_back(r.legs[l].end - r.legs[l].start);
+      err.push_back(std::hypot(r.legs[l].x - n.x, r.legs[l].y - n.y));
+    }
+    leg.runs = ms.size();
+    leg.ms = sweepStats(ms);
+    leg.error = sweepStats(err);
+    s.legs.push_back(leg);
+  }
+  return s;
+}
+
+static void sweepPrint(const sweep_auton &s) {
+  printf("\n%s  (%d runs, %d timed out)\n", s.nominal.name.c_str(), s.runs, s.timed_out);
+  printf("  %-26s %8s %8s %8s %8s %8s %9s\n", "", "p5", "p50", "p95", "p99", "max", "nominal");
+  printf("  %-26s %8.0f %8.0f %8.0f %8.0f %8.0f %9u\n", "time ms", s.time.p[0], s.time.p[1], s.time.p[2], s.time.p[3], s.time.p[4], s.nominal.time_ms);
+  printf("  %-26s %8.2f %8.2f %8.2f %8.2f %8.2f\n", "end error in", s.error.p[0], s.error.p[1], s.error.p[2], s.error.p[3], s.error.p[4]);
+  printf("  %6s %-20s %-15s %6s %6s %6s %6s | %6s %6s %6s\n", "motion", "wait", "mode", "ms", "p50", "p95", "p99", "in p50", "p95", "p99");
+  for (const sweep_leg &leg : s.legs)
+    printf("  %6d %-20s %-15s %6u %6.0f %6.0f %6.0f | %6.2f %6.2f %6.2f%s\n", leg.nominal.motion, leg.nominal.wait.c_str(), leg.nominal.mode.c_str(),
+           leg.nominal.end - leg.nominal.start, leg.ms.p[1], leg.ms.p[2], leg.ms.p[3], leg.error.p[1], leg.error.p[2], leg.error.p[3],
+           leg.runs < s.runs ? "  (some runs never got here)" : "");
+}
+
+static void sweepStatsWrite(FILE *file, const char *name, const sweep_stats &s, int decimals) {
+  fprintf(file, "\"%s\": {\"p5\": %.*f, \"p50\": %.*f, \"p95\": %.*f, \"p99\": %.*f, \"max\": %.*f}", name, decimals, s.p[0], decimals, s.p[1], decimals, s.p[2],
+          decimals, s.p[3], decimals, s.p[4]);
+}
+
+static void sweepWrite(FILE *file, const std::vector<sweep_auton> &autons, int runs, std::uint32_t seed) {
+  fprintf(file, "{\n  \"runs\": %d, \"seed\": %u,\n  \"autons\": [\n", runs, seed);
+  for (size_t a = 0; a < autons.size(); a++) {
+    const sweep_auton &s = autons[a];
+    fprintf(file, "    {\"name\": \"%s\", \"runs\": %d, \"timed_out\": %d, \"nominal_ms\": %u, ", s.nominal.name.c_str(), s.runs, s.timed_out, s.nominal.time_ms);
+    sweepStatsWrite(file, "time_ms", s.time, 0);
+    fprintf(file, ", ");
+    sweepStatsWrite(file, "settled_ms", s.settled, 0);
+    fprintf(file, ", ");
+    sweepStatsWrite(file, "error_in", s.error, 2);
+    fprintf(file, ",\n      \"legs\": [\n");
+    for (size_t l = 0; l < s.legs.size(); l++) {
+      const sweep_leg &leg = s.legs[l];
+      fprintf(file, "        {\"motion\": %d, \"wait\": \"%s\", \"mode\": \"%s\", \"nominal_ms\": %u, \"runs\": %d, ", leg.nominal.motion, leg.nominal.wait.c_str(),
+              leg.nominal.mode.c_str(), leg.nominal.end - leg.nominal.start, leg.runs);
+      sweepStatsWrite(file, "ms", leg.ms, 0);
+      fprintf(file, ", ");
+      sweepStatsWrite(file, "error_in", leg.error, 2);
+      fprintf(file, "}%s\n", l + 1 < s.legs.size() ? "," : "");
+    }
+    fprintf(file, "      ]}%s\n", a + 1 < autons.size() ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+}
+
+int main(int argc, char **argv) {
+  int runs = 1000;
+  int jobs = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+  std::uint32_t seed = 1;
+  const char *only = nullptr, *json = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) runs = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) jobs = std::max(1, std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = std::strtoul(argv[++i], nullptr, 10);
+    else if (std::strcmp(argv[i], "--auton") == 0 && i + 1 < argc) only = argv[++i];
+    else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) json = argv[++i];
+  }
+  printf("%d runs per auton on %d cores, seed %u\n", runs, jobs, seed);
+
+  std::vector<sweep_auton> autons;
+  for (size_t a = 0; a < autonList.size(); a++) {
+    if (only != nullptr && std::strstr(autonList[a].Name.c_str(), only) == nullptr) continue;
+    std::mt19937 rng(seed + a);  // each auton gets the same robots no matter which others are in the sweep
+    std::vector<sim_params> params;
+    for (int r = 0; r < runs; r++) params.push_back(sweepParams(rng));
+    sim_result nominal = sim_auton_run(a, sim_params());
+    autons.push_back(sweepSummarize(nominal, sweepRun(a, params, jobs)));
+    sweepPrint(autons.back());
+  }
+
+  // the legs that move the most, wherever they are
+  std::vector<std::pair<const sweep_auton *, const sweep_leg *>> legs;
+  for (const sweep_auton &s : autons)
+    for (const sweep_leg &leg : s.legs) legs.push_back({&s, &leg});
+  std::sort(legs.begin(), legs.end(), [](const auto &a, const auto &b) { return a.second->error.p[2] > b.second->error.p[2]; });
+  printf("\nmost fragile legs (p95 end of leg error)\n");
+  for (int i = 0; i < SWEEP_FRAGILE && i < (int)legs.size(); i++)
+    printf("  %6.2f in  %-36s motion %3d %s\n", legs[i].second->error.p[2], legs[i].first->nominal.name.c_str(), legs[i].second->nominal.motion,
+           legs[i].second->nominal.wait.c_str());
+
+  if (json != nullptr) {
+    FILE *file = fopen(json, "w");
+    if (file == nullptr) {
+      printf("couldn't write %s\n", json);
+      return 2;
+    }
+    sweepWrite(file, autons, runs, seed);
+    fclose(file);
+    printf("saved %s\n", json);
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+// Host check for the current budget split (include/power_manager.hpp)
+// Runs the automatic requests through the split at the default budget and makes sure a running intake and a
+// held lady brown always get what they need, whatever the drive is doing, and nobody goes over the budget.
+// Build + run: make -C tools/sim power (make -C tools/sim check runs it too)
+#include <cstdio>
+
+#include "power_manager.hpp"
+
+struct powerScenario {
+  const char *name;
+  int driveDrawn;  // mA per drive motor
+  bool pushing, intakeRunning, lbMoving, scoring;
+};
+
+int main() {
+  powerScenario scenarios[] = {
+      {"idle", 0, false, true, false, false},
+      {"cruising", 1200, false, true, false, false},
+      {"flat out", 2500, false, true, false, false},
+      {"pushing", 2500, true, true, false, false},
+      {"scoring", 2500, false, true, true, true},
+      {"push+score", 2500, true, true, true, true},
+      {"intake off", 2500, false, false, false, false},
+  };
+
+  bool ok = true;
+  for (const powerScenario &s : scenarios) {
+    int requested[POWER_CONSUMERS], priority[POWER_CONSUMERS], reserved[POWER_CONSUMERS], allocated[POWER_CONSUMERS];
+    power_auto_requests(s.driveDrawn, s.pushing, s.intakeRunning, s.lbMoving, s.scoring, requested, priority, reserved);
+    power_budget_split(requested, priority, reserved, POWER_MOTORS, POWER_CONSUMERS, POWER_BUDGET_MA, allocated);
+
+    int total = 0;
+    for (int i = 0; i < POWER_CONSUMERS; i++) total += allocated[i] * POWER_MOTORS[i];
+    int intakeNeeds = s.intakeRunning ? POWER_INTAKE_RUN_MA : POWER_MOTOR_MIN_MA;
+    bool good = total <= POWER_BUDGET_MA && allocated[POWER_INTAKE] >= intakeNeeds && allocated[POWER_LB] >= POWER_LB_HOLD_MA &&
+                allocated[POWER_DRIVE] >= POWER_MOTOR_MIN_MA;
+    // a scoring arm gets everything it asked for
+    if (s.scoring) good &= allocated[POWER_LB] == requested[POWER_LB];
+    // an idle drive shouldn't be sitting on current it isn't using
+    if (s.driveDrawn == 0) good &= allocated[POWER_DRIVE] <= POWER_DRIVE_HEADROOM_MA;
+    printf("%-10s drive %4d x6  intake %4d (needs %4d)  lb %4d (holds on %4d)  total %5d / %5d  %s\n", s.name, allocated[POWER_DRIVE],
+           allocated[POWER_INTAKE], intakeNeeds, allocated[POWER_LB], POWER_LB_HOLD_MA, total, POWER_BUDGET_MA, good ? "ok" : "WRONG");
+    ok &= good;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+// Host comparison of EZ-Template's linear slew and the S-curve slew (include/scurve_slew.hpp)
+// Drives a 1D model of the drivetrain 24" with the drive PID from default_constants(), the max speed
+// capped by each ramp, and reports wheel slip, peak jerk and time to target.
+// Build + run from the repo root:
+//   g++ -std=gnu++20 -O2 -Iinclude tools/sim/scurve_slew_sim.cpp tools/host/pros_stubs.cpp -o scurve_slew_sim && ./scurve_slew_sim
+#include <cstdio>
+#include <functional>
+
+#include "scurve_slew.hpp"
+
+// drivetrain, same numbers as the feedforward guesses in default_constants()
+const double kS = 600, kV = 157, kA = 20;  // mV, mV per in/s, mV per in/s^2
+const double TRACTION = 0.9 * 386.1;      // in/s^2 the wheels can push before they slip (mu * g)
+const double DT = 0.001;                   // seconds per physics step
+const int PID_EVERY = 10;                  // physics steps per PID tick (10 ms)
+const double MOTOR_LAG = 0.005;            // seconds, the motor doesn't jump to a new voltage instantly
+
+// EZ-Template's util isn't built for the computer
+double clampSym(double x, double limit) { return std::fmax(-limit, std::fmin(limit, x)); }
+
+struct simResult {
+  double slipMs = 0;     // time the wheels spent slipping
+  double peakJerk = 0;   // in/s^3, biggest kick the drivetrain feels
+  double rmsJerk = 0;    // in/s^3, how rough the whole motion is
+  double settleMs = -1;  // first time it's within 0.5" and going < 2 in/s, -1 if never
+};
+
+// ramp(traveled) -> max speed out of 127
+simResult run(double target, double speedMax, std::function<double(double)> ramp) {
+  simResult r;
+  double x = 0, v = 0, a = 0, lastA = 0, wheelV = 0;
+  double out = 0, lastError = target, volts = 0, jerkSum = 0;
+  for (int step = 0; step < 4000; step++) {
+    if (step % PID_EVERY == 0) {
+      // EZ-Template style PD, d per tick
+      double error = target - x;
+      out = 20.0 * error + 110.0 * (error - lastError);
+      lastError = error;
+      double cap = std::fmin(ramp(std::fabs(x)), speedMax);
+      out = clampSym(out, cap);
+    }
+    volts += (out * 12000.0 / 127.0 - volts) * DT / MOTOR_LAG;
+    // what the motors would do to the wheel surface
+    double wheelA = (volts - kV * wheelV - (std::fabs(wheelV) > 1e-3 ? std::copysign(kS, wheelV) : 0.0)) / kA;
+    if (std::fabs(wheelV) < 1e-3 && std::fabs(volts) < kS) wheelA = 0;
+    // the robot only gets what the carpet can give it
+    a = clampSym(wheelA, TRACTION);
+    bool slipping = std::fabs(wheelA) > TRACTION;
+    if (slipping) r.slipMs += DT * 1000;
+    wheelV += wheelA * DT;
+    v += a * DT;
+    if (!slipping) wheelV = v;  // wheels grip again -> they turn with the robot
+    x += v * DT;
+    double jerk = std::fabs(a - lastA) / DT;
+    r.peakJerk = std::fmax(r.peakJerk, jerk);
+    jerkSum += jerk * jerk;
+    lastA = a;
+    if (r.settleMs < 0 && std::fabs(target - x) < 0.5 && std::fabs(v) < 2.0) r.settleMs = step * DT * 1000;
+  }
+  r.rmsJerk = std::sqrt(jerkSum / 4000);
+  return r;
+}
+
+void compare(double distance, double minSpeed, double speedMax) {
+    printf("24 in at speed %.0f, slew %.0f in from %.0f:\n", speedMax, distance, minSpeed);
+    simResult none = run(24, speedMax, [](double) { return 127.0; });
+    simResult linear = run(24, speedMax, [&](double traveled) {
+      // ez::slew: straight line from min speed to max over the distance
+      if (traveled >= distance) return speedMax;
+      return minSpeed + (speedMax - minSpeed) * traveled / distance;
+    });
+    scurve_slew s(distance, minSpeed);
+    s.initialize(true, speedMax, 24, 0);
+    simResult scurve = run(24, speedMax, [&](double traveled) { return s.iterate(traveled); });
+    const char *names[3] = {"none", "linear", "s-curve"};
+    simResult results[3] = {none, linear, scurve};
+    for (int i = 0; i < 3; i++)
+      printf("  %-8s slip %4.0f ms  peak jerk %6.0f  rms jerk %6.0f in/s^3  settled %4.0f ms\n", names[i], results[i].slipMs, results[i].peakJerk, results[i].rmsJerk, results[i].settleMs);
+}
+
+int main() {
+  compare(3, 70, 110);  // what default_constants() uses
+  compare(3, 70, 127);
+  compare(8, 30, 127);  // a longer, softer ramp is where the shape matters most
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include "sim_auton.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "autons.hpp"
+#include "battery_compensation.hpp"
+#include "feedforward.hpp"
+#include "gain_schedule.hpp"
+#include "scurve_slew.hpp"
+
+static int simAutonIndex = 0;
+static bool simAutonDone = false;
+static std::uint32_t simAutonReturned = 0;
+
+// What main.cpp's autonomous() does before it calls the auton (initialize() already ran default_constants())
+static void simAutonTask(void *) {
+  default_constants();
+  chassis.pid_targets_reset();
+  chassis.drive_imu_reset();
+  chassis.drive_sensor_reset();
+  intake.set_brake_mode(pros::E_MOTOR_BRAKE_COAST);
+  lb.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
+  chassis.drive_brake_set(pros::E_MOTOR_BRAKE_HOLD);
+
+  autonList[simAutonIndex].auton_call();  // the selector's list (autons.cpp), same order
+  simAutonReturned = pros::millis();
+
+  // some autons end on a motion they don't wait for, let it finish so the end pose means something
+  size_t legs = simLegs.size();
+  chassis.pid_wait();
+  if (simLegs.size() > legs) simLegs.back().wait = "end";
+  simAutonDone = true;
+}
+
+static void simWorldTask(void *) { sim_world_task(); }
+static void simDriveTask(void *) { sim_drive_task(); }
+static void simBatteryTask(void *) { battery_compensation_task(); }
+static void simGainScheduleTask(void *) { gain_schedule_task(); }
+static void simSlewProfileTask(void *) { slew_profile_task(); }
+static void simFeedforwardTask(void *) { feedforward_task(); }
+
+// The child: run it, write the result down the pipe
+static void simAutonChild(int auton, const sim_params &params, int fd) {
+  simAutonIndex = auton;
+  sim_world_reset(params);
+  sim_rtos_start();
+  pros::Task world(simWorldTask, nullptr, "sim world");  // made first so it steps before anything reads it
+  pros::Task drive(simDriveTask, nullptr, "sim drive");
+  // the tasks initialize() starts that change how a motion drives, after the constants like on the robot
+  default_constants();
+  pros::Task feedforward(simFeedforwardTask, nullptr, "feedforward");
+  pros::Task battery(simBatteryTask, nullptr, "battery");
+  pros::Task slewProfile(simSlewProfileTask, nullptr, "slew profile");
+  pros::Task gainSchedule(simGainScheduleTask, nullptr, "gain schedule");
+  pros::Task run(simAutonTask, nullptr, "auton");
+  while (!simAutonDone && pros::millis() < SIM_AUTON_TIMEOUT_MS) pros::delay(10);
+
+  FILE *out = fdopen(fd, "w");
+  fprintf(out, "%u %u %d %.6f %.6f %.6f %.6f %.6f %.6f\n", simAutonDone ? simAutonReturned : pros::millis(), pros::millis(), !simAutonDone,
+          simWorld.robot.x, simWorld.robot.y, simWorld.robot.theta, chassis.odom_x_get(), chassis.odom_y_get(), chassis.odom_theta_get());
+  for (const sim_leg &leg : simLegs)
+    fprintf(out, "%d %u %u %s %s %s %.6f %.6f %.6f\n", leg.motion, leg.start, leg.end, leg.wait.c_str(), leg.mode.c_str(), leg.exit.c_str(), leg.x, leg.y, leg.theta);
+  fclose(out);
+}
+
+sim_child sim_auton_start(int auton, const sim_params &params) {
+  sim_child child;
+  child.auton = auton;
+  int fds[2];
+  if (pipe(fds) != 0) return child;
+  fflush(stdout);  // or the child prints whatever's buffered again
+  child.pid = fork();
+  if (child.pid == 0) {
+    close(fds[0]);
+    simAutonChild(auton, params, fds[1]);
+    _exit(0);  // the robot's tasks are still going, don't wait for them
+  }
+  close(fds[1]);
+  child.fd = fds[0];
+  return child;
+}
+
+sim_result sim_auton_finish(sim_child child) {
+  sim_result r;
+  r.name = autonList[child.auton].Name;
+  r.timed_out = true;
+  if (child.fd < 0) return r;
+  FILE *in = fdopen(child.fd, "r");
+  char line[256];
+  if (fgets(line, sizeof(line), in) != nullptr) {
+    int timed_out = 1;
+    sscanf(line, "%u %u %d %lf %lf %lf %lf %lf %lf", &r.time_ms, &r.settled_ms, &timed_out, &r.x, &r.y, &r.theta, &r.odom_x, &r.odom_y, &r.odom_theta);
+    r.timed_out = timed_out;
+  }
+  while (fgets(line, sizeof(line), in) != nullptr) {
+    sim_leg leg;
+    char wait[64], mode[64], exit[64];
+    if (sscanf(line, "%d %u %u %63s %63s %63s %lf %lf %lf", &leg.motion, &leg.start, &leg.end, wait, mode, exit, &leg.x, &leg.y, &leg.theta) != 9) continue;
+    leg.wait = wait;
+    leg.mode = mode;
+    leg.exit = exit;
+    r.legs.push_back(leg);
+  }
+  fclose(in);
+  waitpid(child.pid, nullptr, 0);
+  return r;
+}
+
+sim_result sim_auton_run(int auton, const sim_params &params) { return sim_auton_finish(sim_auton_start(auton, params)); }
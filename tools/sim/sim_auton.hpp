@@ -0,0 +1,35 @@
+// Runs one of our autons in the host simulator (see sim_world.hpp) and says how it went.
+// Every run is its own forked process: the robot code is all globals and tasks that never end, so a fresh
+// copy of the process is the only clean slate. That also means runs can go side by side, start a few with
+// sim_auton_start() and collect them with sim_auton_finish().
+#pragma once
+
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+#include "autons.hpp"  // autonList, the autons get picked by their index in it
+#include "sim_world.hpp"
+
+const std::uint32_t SIM_AUTON_TIMEOUT_MS = 60000;  // virtual ms, an auton that isn't done by then is stuck
+
+struct sim_result {
+  std::string name;
+  std::uint32_t time_ms = 0;     // the auton function returned
+  std::uint32_t settled_ms = 0;  // the last motion exited after that
+  bool timed_out = false;
+  double x = 0.0, y = 0.0, theta = 0.0;  // where the robot really ended up (in, deg)
+  double odom_x = 0.0, odom_y = 0.0, odom_theta = 0.0;  // where it thinks it ended up
+  std::vector<sim_leg> legs;
+};
+
+struct sim_child {
+  int auton = 0;
+  pid_t pid = -1;
+  int fd = -1;  // the result comes back through this pipe
+};
+
+sim_child sim_auton_start(int auton, const sim_params &params);
+sim_result sim_auton_finish(sim_child child);
+sim_result sim_auton_run(int auton, const sim_params &params);  // start + finish
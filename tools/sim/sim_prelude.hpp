@@ -0,0 +1,10 @@
+// Forced in front of every file the simulator builds (-include in the Makefile). autons.cpp gets LVGL through
+// main.h on the robot, this gives it to everything the same way. PROS's own headers have unused parameters in
+// them (pros/llemu.h) that aren't ours to fix, so -Wextra gets pointed at our code and not theirs.
+#pragma once
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include "api.h"
+#include "liblvgl/lvgl.h"
+#pragma GCC diagnostic pop
@@ -0,0 +1,320 @@
+// The robot the host simulator drives around, stepped at a fixed 1 ms with nothing random outside the seeded
+// noise, so the same run always comes out the same.
+//   - motors: a DC motor behind a cartridge. Torque falls off in a straight line from stall to free speed, the
+//     current limit flattens the bottom of that (the V5's 2.5 A), and the motor's own velocity and hold loops
+//     run inside it like they do on the real one. The voltage it gets is a % of a battery that sags with the
+//     total current
+//   - drive: 6 motors, 450 rpm, as two sides of rigidly geared wheels. Each side pushes the robot through the
+//     carpet, up to what the carpet will take (friction * weight on that side); past that the wheels spin or
+//     skid and the encoders stop matching the ground. The robot has mass and inertia, more of both with a mogo
+//     clamped, rolling resistance, and scrub that fights turning
+//   - intake: the roller/chain inertia with friction and the drag of pushing rings
+//   - lady brown: a pendulum on a 3:1 with a hard stop under stowed
+// The numbers are off V5 spec sheets and a scale, not measured on this robot. Good enough to catch a tuning
+// change that costs time, and to ask "what does 11.5 V do to this auton", not to tune on.
+#include "sim_world.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "api.h"
+
+sim_world simWorld;
+
+// V5 smart motor
+const double SIM_MOTOR_VOLTS = 12.0;       // V a cartridge hits its rated rpm at
+const double SIM_MOTOR_OHMS = 2.4;         // winding + driver resistance, puts the peak at ~11 W like the spec
+const double SIM_STALL_TORQUE = 2.1;       // Nm at 2.5 A on a 100 rpm cartridge, scales with the gearing
+const double SIM_ROTOR_INERTIA = 1.2e-6;   // kg m^2 of the motor before the cartridge (3600 rpm)
+const double SIM_VELOCITY_KP = 2.0;        // the motor's own velocity loop, in units of its feedforward
+const double SIM_VELOCITY_KI = 20.0;       // 1/s
+const double SIM_HOLD_KP = 0.15;           // V per degree off hold_position
+const double SIM_HOLD_KD = 1.0;            // in units of its feedforward
+const double SIM_IDLE_AMPS = 0.4;          // brain + radio + sensors, always drawn
+
+// Drive
+const double SIM_INCH = 0.0254;            // m
+const double SIM_POUND = 0.4536;           // kg
+const double SIM_G = 9.81;                 // m/s^2
+const double SIM_TRACTION = 1.1;           // tile grip of the traction wheels at friction 1 (~1.1 g)
+const double SIM_ROLLING = 0.03;           // rolling resistance, of the weight
+const double SIM_SCRUB = 0.1;              // turning scrub, of the weight at half the track width
+const double SIM_ROBOT_SIZE = 15.0;        // in, square, for the inertia and the walls
+const double SIM_FIELD_HALF = 72.0;        // in, field center to the perimeter wall
+const double SIM_MOGO_REACH = 8.0;         // in, clamped goal behind the middle of the robot
+const double SIM_WHEEL_INERTIA = 2e-4;     // kg m^2, one side's wheels, axles and gears
+const int SIM_TRACTION_PASSES = 4;         // solving both sides' traction together
+
+// Intake (at its motor's output shaft)
+const double SIM_INTAKE_INERTIA = 2e-4;    // kg m^2, chain + rollers
+const double SIM_INTAKE_FRICTION = 0.05;   // Nm
+const double SIM_INTAKE_DRAG = 1.3e-4;     // Nm per rpm, squeezing rings through (~500 rpm free running)
+
+// Lady brown (at the arm)
+const double SIM_LB_GEAR = 3.0;            // motor turns per arm turn
+const double SIM_LB_START = 12500;         // centidegrees, stowed (states[0])
+const double SIM_LB_STOP = 12000;          // centidegrees, the hard stop it rests against under stowed
+const double SIM_LB_DOWN = 9000;           // centidegrees where it would hang if the stop weren't there
+const double SIM_LB_MASS = 0.35;           // kg
+const double SIM_LB_LENGTH = 0.18;         // m, pivot to the center of mass
+const double SIM_LB_FRICTION = 0.15;       // Nm
+
+// What a shaft carries besides its motor, at the output shaft
+struct sim_load {
+  double inertia;   // kg m^2
+  double friction;  // Nm
+  double drag;      // Nm per rpm
+};
+
+void sim_world_reset(const sim_params &params) {
+  simWorld = sim_world();
+  simWorld.params = params;
+  simWorld.battery = params.battery;
+  simWorld.rng.seed(params.seed);
+  simWorld.motors[SIM_INTAKE_PORT].gear_rpm = 600.0;
+  simWorld.motors[SIM_LB_PORT].gear_rpm = 100.0;
+  simWorld.lb_angle = SIM_LB_START;
+}
+
+void sim_world_drive_set(const std::vector<int> &left, const std::vector<int> &right) {
+  simWorld.left_ports = left;
+  simWorld.right_ports = right;
+  for (int p : left) simWorld.motors[std::abs(p)].gear_rpm = 600.0;
+  for (int p : right) simWorld.motors[std::abs(p)].gear_rpm = 600.0;
+}
+
+void sim_world_place(double x, double y, double theta) {
+  simWorld.robot.x = x;
+  simWorld.robot.y = y;
+  simWorld.robot.theta = theta;
+  simWorld.robot.placed = true;
+}
+
+double sim_noise(double sigma) {
+  if (sigma <= 0.0) return 0.0;
+  return std::normal_distribution<double>(0.0, sigma)(simWorld.rng);
+}
+
+double sim_battery_voltage() { return simWorld.battery; }
+
+double sim_imu_rotation() { return simWorld.robot.theta * simWorld.params.imu_scale + sim_noise(simWorld.params.imu_noise); }
+
+// Nm on the output shaft at the motor's velocity right now, through its own loops and its current limit
+static double simMotorTorque(sim_motor &m) {
+  double battery = simWorld.battery;
+  double volts = 0.0;
+  bool open = false;  // coast, the driver lets go
+  if (m.velocity_mode) {
+    double error = m.velocity_target - m.velocity;
+    volts = SIM_MOTOR_VOLTS * (m.velocity_target + SIM_VELOCITY_KP * error + SIM_VELOCITY_KI * m.integral) / m.gear_rpm;
+    if (std::fabs(volts) < battery) m.integral += error * SIM_DT;  // no windup against the battery
+  } else if (m.command != 0.0) {
+    volts = m.command / 12000.0 * battery;
+  } else if (m.brake == SIM_HOLD) {
+    if (!m.holding) m.hold_position = m.position;
+    m.holding = true;
+    volts = SIM_HOLD_KP * (m.hold_position - m.position) - SIM_HOLD_KD * SIM_MOTOR_VOLTS * m.velocity / m.gear_rpm;
+  } else {
+    open = m.brake == SIM_COAST;  // SIM_BRAKE shorts the windings, 0 V
+  }
+  if (!m.velocity_mode) m.integral = 0.0;
+  if (m.velocity_mode || m.command != 0.0) m.holding = false;
+
+  volts = std::clamp(volts, -battery, battery);
+  double emf = SIM_MOTOR_VOLTS * m.velocity / m.gear_rpm;
+  double limit = m.current_limit / 1000.0;
+  double amps = open ? 0.0 : std::clamp((volts - emf) / SIM_MOTOR_OHMS, -limit, limit);
+  m.voltage = open ? 0.0 : volts * 1000.0;
+  m.current = std::fabs(amps) * 1000.0;
+  m.temperature += (0.02 * amps * amps - 0.002 * (m.temperature - 25.0)) * SIM_DT;
+  simWorld.battery_amps += std::fmax(volts * amps, 0.0) / battery;  // what it pulls, braking doesn't charge
+  return amps / 2.5 * SIM_STALL_TORQUE * 100.0 / m.gear_rpm;
+}
+
+// kg m^2 of a motor's rotor seen from its output shaft
+static double simRotorInertia(const sim_motor &m) {
+  double ratio = 3600.0 / m.gear_rpm;
+  return SIM_ROTOR_INERTIA * ratio * ratio;
+}
+
+// One motor turning a load (plus anything else pushing on the shaft), friction never pushes it backwards
+static void simShaftStep(sim_motor &m, double torque, const sim_load &load) {
+  double rpm_per_torque = SIM_DT / (load.inertia + simRotorInertia(m)) * 60.0 / (2.0 * M_PI);
+  torque -= load.drag * m.velocity;
+  double stopped = m.velocity + torque * rpm_per_torque;  // where it ends up with no friction
+  double friction = load.friction * rpm_per_torque;
+  if (std::fabs(stopped) <= friction) m.velocity = 0.0;
+  else m.velocity = stopped - std::copysign(friction, stopped);
+  m.position += m.velocity * 6.0 * SIM_DT;  // rpm -> deg/s
+}
+
+static void simIntakeStep() {
+  sim_motor &m = simWorld.motors[SIM_INTAKE_PORT];
+  simShaftStep(m, simMotorTorque(m), {SIM_INTAKE_INERTIA, SIM_INTAKE_FRICTION, SIM_INTAKE_DRAG});
+}
+
+// The lady brown motor is -8, so the arm goes up when the motor spins backwards
+static void simLadyBrownStep() {
+  sim_motor &m = simWorld.motors[SIM_LB_PORT];
+  double from_down = (simWorld.lb_angle - SIM_LB_DOWN) / 100.0 * M_PI / 180.0;
+  double gravity = SIM_LB_MASS * SIM_G * SIM_LB_LENGTH * std::sin(from_down) / SIM_LB_GEAR;  // pulls the motor forwards (down)
+  double arm = SIM_LB_MASS * SIM_LB_LENGTH * SIM_LB_LENGTH / (SIM_LB_GEAR * SIM_LB_GEAR);
+  simShaftStep(m, simMotorTorque(m) + gravity, {arm, SIM_LB_FRICTION / SIM_LB_GEAR, 0.0});
+
+  double stop = (SIM_LB_START - SIM_LB_STOP) * SIM_LB_GEAR / 100.0;  // motor degrees at the hard stop
+  if (m.position > stop) {
+    m.position = stop;
+    m.velocity = std::fmin(m.velocity, 0.0);
+  }
+  simWorld.lb_angle = SIM_LB_START - m.position * 100.0 / SIM_LB_GEAR;
+}
+
+// Anything else plugged in spins free
+static void simFreeStep(int port) {
+  sim_motor &m = simWorld.motors[port];
+  simShaftStep(m, simMotorTorque(m), {0.0, 0.01, 0.0});
+}
+
+// N at the wheel surface that one side's motors push with
+static double simSideForce(const std::vector<int> &ports, double wheel) {
+  const sim_params &p = simWorld.params;
+  double motor_rpm = wheel / (M_PI * p.wheel_diameter) * 60.0 / p.drive_ratio;
+  double torque = 0.0;
+  for (int port : ports) {
+    double dir = port < 0 ? -1.0 : 1.0;  // reversed ports are spun backwards to drive forwards
+    sim_motor &m = simWorld.motors[std::abs(port)];
+    m.velocity = dir * motor_rpm;
+    torque += dir * simMotorTorque(m);
+  }
+  return torque / p.drive_ratio / (p.wheel_diameter / 2.0 * SIM_INCH);
+}
+
+// The motors follow their side's wheels, they're geared together
+static void simSideMotors(const std::vector<int> &ports, double wheel) {
+  const sim_params &p = simWorld.params;
+  double motor_rpm = wheel / (M_PI * p.wheel_diameter) * 60.0 / p.drive_ratio;
+  for (int port : ports) {
+    double dir = port < 0 ? -1.0 : 1.0;
+    sim_motor &m = simWorld.motors[std::abs(port)];
+    m.velocity = dir * motor_rpm;
+    m.position += m.velocity * 6.0 * SIM_DT;
+  }
+}
+
+// Takes speed off towards 0 without going past it
+static double simSlowDown(double speed, double by) { return std::fabs(speed) <= by ? 0.0 : speed - std::copysign(by, speed); }
+
+// The perimeter. A corner past a wall gets pushed back out, and if the robot was still going into it the
+// ground speed stops there. The wheels don't, so driving into a wall spins them against the grip like it does
+// on a real field, and odom (off the motor encoders) keeps counting. Only once the auton has put the robot
+// somewhere, before that it's wherever odom's 0 is
+static void simWallStep() {
+  sim_robot &r = simWorld.robot;
+  if (!r.placed) return;
+  double reach = SIM_ROBOT_SIZE / 2.0;
+  double heading = r.theta * M_PI / 180.0;
+  double fx = std::sin(heading), fy = std::cos(heading);  // forward
+  double omega = (r.v_left - r.v_right) / simWorld.params.track_width;  // rad/s, clockwise
+  double v = (r.v_left + r.v_right) / 2.0;
+  bool into = false;
+  for (int axis = 0; axis < 2; axis++) {
+    double deepest = 0.0, speed = 0.0;  // in past the wall (+ past +72, - past -72), that corner's in/s along the axis
+    for (double a : {-reach, reach}) {
+      for (double b : {-reach, reach}) {
+        // a forward, b to the right of the center
+        double dx = a * fx + b * fy, dy = a * fy - b * fx;
+        double corner = axis == 0 ? r.x + dx : r.y + dy;
+        double past = corner > SIM_FIELD_HALF ? corner - SIM_FIELD_HALF : corner < -SIM_FIELD_HALF ? corner + SIM_FIELD_HALF : 0.0;
+        if (std::fabs(past) > std::fabs(deepest)) {
+          deepest = past;
+          speed = axis == 0 ? v * fx + omega * dy : v * fy - omega * dx;
+        }
+      }
+    }
+    if (deepest == 0.0) continue;
+    (axis == 0 ? r.x : r.y) -= deepest;
+    if (speed * deepest > 0.0) into = true;
+  }
+  if (into) r.v_left = r.v_right = 0.0;
+}
+
+static void simDriveStep() {
+  const sim_params &p = simWorld.params;
+  sim_robot &r = simWorld.robot;
+  bool mogo = simWorld.adi[SIM_MOGO_PORT];
+  double mass = (p.mass + (mogo ? p.mogo_mass : 0.0)) * SIM_POUND;
+  double size = SIM_ROBOT_SIZE * SIM_INCH;
+  double inertia = p.mass * SIM_POUND * size * size / 6.0 + (mogo ? p.mogo_mass * SIM_POUND * std::pow(SIM_MOGO_REACH * SIM_INCH, 2) : 0.0);
+  double half = p.track_width / 2.0 * SIM_INCH;
+  double radius = p.wheel_diameter / 2.0 * SIM_INCH;
+  double side_motors = std::max(simWorld.left_ports.size(), simWorld.right_ports.size());
+  double wheel_mass = (SIM_WHEEL_INERTIA + side_motors * simRotorInertia(simWorld.motors[std::abs(simWorld.left_ports[0])]) / (p.drive_ratio * p.drive_ratio)) / (radius * radius);
+  double grip = SIM_TRACTION * p.friction * mass * SIM_G / 2.0;  // N, per side
+
+  // m/s and rad/s, EZ-Template's frame (0 = +y, clockwise positive)
+  double v = (r.v_left + r.v_right) / 2.0 * SIM_INCH;
+  double omega = (r.v_left - r.v_right) / p.track_width;
+  double wheel_left = r.wheel_left * SIM_INCH, wheel_right = r.wheel_right * SIM_INCH;
+  double push_left = simSideForce(simWorld.left_ports, r.wheel_left);
+  double push_right = simSideForce(simWorld.right_ports, r.wheel_right);
+
+  // The carpet's force on each side is whatever makes the wheels and the ground under them end the step at the
+  // same speed, unless that's more than the grip. Both sides move the same body, so go back and forth a few times
+  double own = SIM_DT / wheel_mass + SIM_DT / mass + half * half * SIM_DT / inertia;  // a side's speed change per N it gets
+  double other = SIM_DT / mass - half * half * SIM_DT / inertia;                       // the other side's, per N this one gets
+  double slip_left = wheel_left + push_left * SIM_DT / wheel_mass - (v + omega * half);
+  double slip_right = wheel_right + push_right * SIM_DT / wheel_mass - (v - omega * half);
+  double left = 0.0, right = 0.0;  // N
+  for (int pass = 0; pass < SIM_TRACTION_PASSES; pass++) {
+    left = std::clamp((slip_left - other * right) / own, -grip, grip);
+    right = std::clamp((slip_right - other * left) / own, -grip, grip);
+  }
+  wheel_left += (push_left - left) * SIM_DT / wheel_mass;
+  wheel_right += (push_right - right) * SIM_DT / wheel_mass;
+  v += (left + right) * SIM_DT / mass;
+  omega += (left - right) * half * SIM_DT / inertia;
+  v = simSlowDown(v, SIM_ROLLING * SIM_G * SIM_DT);
+  omega = simSlowDown(omega, SIM_SCRUB * mass * SIM_G * half * SIM_DT / inertia);
+
+  r.wheel_left = wheel_left / SIM_INCH;
+  r.wheel_right = wheel_right / SIM_INCH;
+  r.v_left = (v + omega * half) / SIM_INCH;
+  r.v_right = (v - omega * half) / SIM_INCH;
+  simSideMotors(simWorld.left_ports, r.wheel_left);
+  simSideMotors(simWorld.right_ports, r.wheel_right);
+
+  double turn = omega * 180.0 / M_PI;  // deg/s
+  double mid = (r.theta + turn * SIM_DT / 2.0) * M_PI / 180.0;
+  r.x += v / SIM_INCH * std::sin(mid) * SIM_DT;
+  r.y += v / SIM_INCH * std::cos(mid) * SIM_DT;
+  r.theta += turn * SIM_DT;
+  simWallStep();
+}
+
+static bool simIsDrive(int port) {
+  for (int p : simWorld.left_ports)
+    if (std::abs(p) == port) return true;
+  for (int p : simWorld.right_ports)
+    if (std::abs(p) == port) return true;
+  return false;
+}
+
+void sim_world_step() {
+  simWorld.battery_amps = SIM_IDLE_AMPS;
+  if (!simWorld.left_ports.empty() && !simWorld.right_ports.empty()) simDriveStep();
+  simIntakeStep();
+  simLadyBrownStep();
+  for (int port = 1; port < SIM_PORTS; port++)
+    if (port != SIM_INTAKE_PORT && port != SIM_LB_PORT && !simIsDrive(port)) simFreeStep(port);
+
+  // the battery reads what it had left after last step's load, the motors see that this step
+  simWorld.battery = simWorld.params.battery - simWorld.params.battery_ohms * simWorld.battery_amps;
+}
+
+void sim_world_task() {
+  while (true) {
+    sim_world_step();
+    pros::delay(SIM_STEP_MS);
+  }
+}
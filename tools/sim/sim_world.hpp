@@ -0,0 +1,121 @@
+// The simulated robot and field behind the host simulator (tools/sim/auton_bench.cpp).
+// The code under test runs unchanged on top of a fake PROS + EZ-Template:
+//   tools/host/sim_rtos.cpp     pros::delay/millis/Task on a virtual clock, one task at a time, so every run of
+//                               the same auton with the same numbers comes out exactly the same
+//   tools/host/sim_devices.cpp  motors, IMU, rotation/optical/distance sensors, pistons, controller, LVGL
+//   tools/host/sim_ez.cpp       ez::util, ez::PID, ez::slew and the pure pursuit path prep (inject + smooth),
+//                               written off EZ-Template's docs (its source isn't in the tree, only the ARM archive)
+//   tools/host/sim_drive.cpp    ez::Drive, the motions and waits autons.cpp uses, on top of sim_ez.cpp
+//   tools/host/sim_robot.cpp    the robot-only bits of our own code the autons call (trace, thermal, ...)
+// and this file is the physics all of that reads and writes. sim_world_step() moves it forward one step.
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+const int SIM_PORTS = 22;      // smart ports 1 -> 21, 0 isn't one
+const int SIM_ADI_PORTS = 8;   // 'A' -> 'H'
+const int SIM_STEP_MS = 1;     // physics step
+const double SIM_DT = SIM_STEP_MS / 1000.0;
+
+// What's plugged in where, same as subsystems.cpp (the drive ports come from the ez::Drive constructor)
+const int SIM_INTAKE_PORT = 11;
+const int SIM_LB_PORT = 8;
+const int SIM_LB_SENSOR_PORT = 3;
+const int SIM_IMU_PORT = 6;
+const int SIM_MOGO_PORT = 'C' - 'A';
+
+// What a stopped motor does (pros::MotorBrake)
+enum sim_brake { SIM_COAST, SIM_BRAKE, SIM_HOLD };
+
+// One smart motor. Everything is in the motor's own direction, reversed ports get flipped in sim_devices.cpp
+struct sim_motor {
+  double command = 0.0;       // mV asked for (move/move_voltage), a % of the battery like the real one
+  bool velocity_mode = false;  // move_velocity: the motor runs its own velocity loop
+  double velocity_target = 0.0;  // rpm, for velocity_mode
+  sim_brake brake = SIM_COAST;  // what it does at command 0
+  double voltage = 0.0;       // mV it's really putting across the windings (its own loops included)
+  double integral = 0.0;      // velocity loop's integral, rpm s
+  bool holding = false;       // SIM_HOLD has grabbed hold_position
+  double hold_position = 0.0;  // degrees
+  double position = 0.0;      // degrees of the output shaft
+  double velocity = 0.0;      // rpm of the output shaft
+  double current = 0.0;       // mA
+  double temperature = 25.0;  // C
+  int current_limit = 2500;   // mA
+  double gear_rpm = 200.0;    // cartridge free speed
+  double tare = 0.0;          // where position reads 0
+};
+
+// Everything that's different robot to robot and match to match. The defaults are the robot the code thinks it is
+struct sim_params {
+  double wheel_diameter = 3.25;  // in, the real one. The code always thinks 3.25
+  double drive_ratio = 0.75;     // wheel rpm / motor rpm (450 out of a 600 cartridge)
+  double track_width = 11.5;     // in, left wheels to right wheels
+  double imu_scale = 1.0;        // IMU gain error, 1.01 reads 1% too much turn
+  double imu_noise = 0.0;        // deg, standard deviation of each reading
+  double encoder_noise = 0.0;    // deg, standard deviation of each motor encoder reading
+  double friction = 1.0;         // carpet grip, 1 = nominal, lower slips sooner
+  double battery = 12.8;         // V, resting
+  double battery_ohms = 0.09;    // battery + wiring resistance, what makes it sag under load
+  double mass = 15.0;            // lb, the robot
+  double mogo_mass = 2.5;        // lb, a goal with a couple of rings, carried while the clamp is down
+  std::uint32_t seed = 1;        // for the noise
+};
+
+// The ground truth, which odom only ever estimates
+struct sim_robot {
+  bool placed = false;             // set by the first odom_xyt_set(), which is where the auton starts
+  double x = 0.0, y = 0.0;         // in
+  double theta = 0.0;              // deg, EZ-Template's frame: 0 = +y, clockwise is positive
+  double v_left = 0.0, v_right = 0.0;  // in/s, each side over the ground
+  double wheel_left = 0.0, wheel_right = 0.0;  // in/s, each side's wheel surface, faster or slower when it slips
+};
+
+struct sim_world {
+  sim_params params;
+  sim_motor motors[SIM_PORTS];
+  std::vector<int> left_ports, right_ports;  // drive, signed like the ez::Drive constructor (sim_world_drive_set)
+  bool adi[SIM_ADI_PORTS] = {};
+  sim_robot robot;
+  double imu_tare = 0.0;       // deg, what the IMU reads as 0
+  double lb_angle = 0.0;       // centidegrees on the lady brown rotation sensor
+  double battery = 12.8;       // V, under load
+  double battery_amps = 0.0;   // A, everything together
+  std::mt19937 rng;
+};
+
+extern sim_world simWorld;
+
+void sim_world_reset(const sim_params &params);
+void sim_world_drive_set(const std::vector<int> &left, const std::vector<int> &right);  // which ports are the drive
+void sim_world_step();                          // one SIM_STEP_MS step
+void sim_world_place(double x, double y, double theta);  // put the robot somewhere (the first odom_xyt_set())
+double sim_noise(double sigma);                  // one normal sample, 0 if sigma is 0
+
+// Sensors, with the errors in params
+double sim_imu_rotation();                       // deg, unbounded like pros::Imu::get_rotation()
+double sim_battery_voltage();                    // V, sagging with the load
+
+// Makes the calling thread the first task on the virtual clock (sim_rtos.cpp), call it before making any others
+void sim_rtos_start();
+
+// Runs the world, start it as the first task so it steps before anything reads it
+void sim_world_task();
+
+// The drive's control loop (EZ-Template's drive_pid_task), from sim_drive.cpp
+void sim_drive_task();
+
+// One pid_wait*(), for the auton report
+struct sim_leg {
+  int motion = 0;          // which motion of the auton it waited on, 1 for the first
+  std::string wait;        // pid_wait, pid_wait_quick, ...
+  std::string mode;        // drive, turn, swing, point_to_point, pure_pursuit
+  std::uint32_t start = 0;  // ms the motion started
+  std::uint32_t end = 0;    // ms the wait returned
+  std::string exit;        // SMALL, BIG, VELOCITY, mA, PASSED (went by the target), NONE (nothing running)
+  double x = 0.0, y = 0.0, theta = 0.0;  // where the robot really was when it returned
+};
+extern std::vector<sim_leg> simLegs;
@@ -0,0 +1,276 @@
+// Host check for the motor thermal model (include/thermal_model.hpp) against real logs.
+// Replays /usd/thermal_log.csv (thermal_log_enable(true)) through the same model functions the robot runs:
+//   - open loop: only the logged current drives the model, no temperature corrections. How far does it wander
+//     outside the 5C step the motor reported? That's the model itself being right or wrong
+//   - heat/cool fit per motor (grid search on that same error), printed as thermal_constants_set() lines
+//   - time to throttle: every time a motor actually hit 55C, what the robot would have predicted before it.
+//     Fails if the predictions don't close in on the real time (mean error has to shrink from 60 s to 30 s to
+//     10 s before, and be under PREDICT_MAX_ERROR at 10 s), or if one says it's further off than
+//     PREDICT_MAX_LATE x the real time. Saying it's sooner only starts derating early, saying later is the bad one
+//   - derate gate check (pass/fail): derating turns on when time to throttle < THERMAL_HORIZON. It has to be on
+//     for most of the GATE_LEAD seconds before every real throttle (caught), and most of the time it's on a
+//     throttle really has to follow within THERMAL_HORIZON (right). Also printed for other current filter
+//     times, so THERMAL_CURRENT_FILTER_TIME can be re-tuned off a real log
+// With no log it makes a fake one from known constants and checks that the fit gets them back.
+// Rows where a motor logged THERMAL_LOG_ABSENT are skipped for that motor, the model starts over after the gap.
+// Build + run from the repo root:
+//   g++ -std=gnu++20 -O2 -Iinclude tools/sim/thermal_replay.cpp tools/host/pros_stubs.cpp -o thermal_replay && ./thermal_replay [thermal_log.csv]
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "thermal_model.hpp"
+
+struct logRow {
+  double time;  // s
+  double amps[THERMAL_MOTORS];
+  double reported[THERMAL_MOTORS];
+  bool present[THERMAL_MOTORS];
+};
+
+const double GATE_LEAD = 30.0;       // s before a throttle derating should already be on (3000 mA of easing at THERMAL_DERATE_RATE)
+const double GATE_MIN_CAUGHT = 0.9;  // share of those seconds the gate has to be on
+const double GATE_MIN_RIGHT = 0.85;  // share of gate-on time that really throttles within THERMAL_HORIZON
+const double PREDICT_LEADS[3] = {60.0, 30.0, 10.0};  // s before a throttle the predictions get checked
+const double PREDICT_MAX_ERROR = 5.0;  // s, mean error allowed 10 s before
+const double PREDICT_MAX_LATE = 5.0;   // x the real time to throttle, no prediction can say more than this
+
+const char *names[THERMAL_MOTORS] = {"L1", "L2", "L3", "R1", "R2", "R3", "IN", "LB"};
+const char *enumNames[THERMAL_MOTORS] = {"THERMAL_LEFT_1", "THERMAL_LEFT_2", "THERMAL_LEFT_3", "THERMAL_RIGHT_1",
+                                         "THERMAL_RIGHT_2", "THERMAL_RIGHT_3", "THERMAL_INTAKE", "THERMAL_LB"};
+
+std::vector<logRow> load(const char *path) {
+  std::vector<logRow> rows;
+  FILE *file = fopen(path, "r");
+  if (file == nullptr) return rows;
+  char line[512];
+  fgets(line, sizeof(line), file);  // header
+  while (fgets(line, sizeof(line), file)) {
+    logRow r = {};
+    char *p = line;
+    r.time = strtod(p, &p) / 1000.0;
+    for (int m = 0; m < THERMAL_MOTORS; m++) {
+      r.amps[m] = std::fabs(strtod(p + 1, &p)) / 1000.0;
+      r.reported[m] = strtod(p + 1, &p);
+      r.present[m] = r.reported[m] != THERMAL_LOG_ABSENT;
+    }
+    rows.push_back(r);
+  }
+  fclose(file);
+  return rows;
+}
+
+// fake match practice: driving in bursts, a long push, then sitting in the queue between matches
+std::vector<logRow> synthetic(const double heat[], const double cool[]) {
+  std::mt19937 rng(55);
+  std::uniform_real_distribution<double> burst(0.0, 1.0);
+  std::vector<logRow> rows;
+  double truth[THERMAL_MOTORS];
+  for (int m = 0; m < THERMAL_MOTORS; m++) truth[m] = 27.0;
+  double dt = THERMAL_SAMPLE_TIME / 1000.0;
+  for (int i = 0; i < 3 * 600 * 10; i++) {  // 3 x (2 min match + 8 min queue)
+    double t = i * dt;
+    bool inMatch = std::fmod(t, 600.0) < 120.0;
+    logRow r = {};
+    r.time = t;
+    for (int m = 0; m < THERMAL_MOTORS; m++) {
+      double amps = 0.0;
+      if (inMatch) {
+        if (m < 6) amps = std::fmod(t, 600.0) > 60.0 && std::fmod(t, 600.0) < 75.0 ? 2.4 : burst(rng) < 0.5 ? 1.8 : 0.4;
+        if (m == THERMAL_INTAKE) amps = 1.0;
+        if (m == THERMAL_LB) amps = burst(rng) < 0.1 ? 2.0 : 0.6;
+      }
+      truth[m] = thermal_step(truth[m], amps, THERMAL_AMBIENT, heat[m], cool[m], dt);
+      r.amps[m] = amps;
+      r.reported[m] = std::floor(truth[m] / THERMAL_SENSOR_STEP) * THERMAL_SENSOR_STEP;
+      r.present[m] = true;
+    }
+    rows.push_back(r);
+  }
+  return rows;
+}
+
+// open loop error: C^2 outside the reported step, averaged
+double openLoopError(const std::vector<logRow> &rows, int m, double heat, double cool) {
+  double temperature = 0.0, error = 0.0;
+  int count = 0;
+  for (size_t i = 0; i < rows.size(); i++) {
+    if (!rows[i].present[m]) continue;
+    // first row, or back after a gap: start over from the middle of the reported step
+    if (i == 0 || !rows[i - 1].present[m]) {
+      temperature = rows[i].reported[m] + THERMAL_SENSOR_STEP / 2.0;
+      continue;
+    }
+    temperature = thermal_step(temperature, rows[i - 1].amps[m], THERMAL_AMBIENT, heat, cool, rows[i].time - rows[i - 1].time);
+    double outside = temperature - thermal_correct(temperature, rows[i].reported[m]);
+    error += outside * outside;
+    count++;
+  }
+  return count > 0 ? error / count : 0.0;
+}
+
+void fit(const std::vector<logRow> &rows, int m, double &heat, double &cool) {
+  double best = INFINITY;
+  // coarse log-spaced grid, then a finer one around the best
+  for (int pass = 0; pass < 2; pass++) {
+    double h0 = heat, c0 = cool;
+    for (int i = -10; i <= 10; i++) {
+      for (int j = -10; j <= 10; j++) {
+        double span = pass == 0 ? 0.25 : 0.02;
+        double h = (pass == 0 ? THERMAL_HEAT : h0) * std::exp(i * span);
+        double c = (pass == 0 ? THERMAL_COOL : c0) * std::exp(j * span);
+        double e = openLoopError(rows, m, h, c);
+        if (e < best) {
+          best = e;
+          heat = h;
+          cool = c;
+        }
+      }
+    }
+  }
+}
+
+// what the robot-side model (with corrections) predicts for time to throttle at every row. INFINITY where the motor was absent
+std::vector<double> predict(const std::vector<logRow> &rows, int m, double heat, double cool, double filter) {
+  std::vector<double> predicted(rows.size(), INFINITY);
+  double temperature = 0.0, current = 0.0;
+  for (size_t i = 0; i < rows.size(); i++) {
+    if (!rows[i].present[m]) continue;
+    if (i == 0 || !rows[i - 1].present[m]) {
+      temperature = rows[i].reported[m] + THERMAL_SENSOR_STEP / 2.0;
+      current = rows[i].amps[m];
+    } else {
+      double dt = rows[i].time - rows[i - 1].time;
+      temperature = thermal_correct(thermal_step(temperature, rows[i].amps[m], THERMAL_AMBIENT, heat, cool, dt), rows[i].reported[m]);
+      current = std::sqrt(current * current + dt / (filter + dt) * (rows[i].amps[m] * rows[i].amps[m] - current * current));
+    }
+    predicted[i] = thermal_time_to(temperature, current, THERMAL_AMBIENT, heat, cool, THERMAL_THROTTLE_TEMP);
+  }
+  return predicted;
+}
+
+// Predictions PREDICT_LEADS[k] seconds before every throttle, added up over every motor
+struct predictStats {
+  int count[3] = {};
+  double error[3] = {};  // s, |predicted - real| summed
+  double late[3] = {};   // worst predicted / real
+};
+
+// every time a motor crosses 55C, what the robot would have said before it
+void throttleCheck(const std::vector<logRow> &rows, int m, const std::vector<double> &predicted, predictStats &stats) {
+  double lastHot = -INFINITY;  // the reading flickers right at a step, only count it after a while under 55C
+  for (size_t i = 1; i < rows.size(); i++) {
+    if (!rows[i].present[m] || rows[i].reported[m] < THERMAL_THROTTLE_TEMP) continue;
+    bool fresh = rows[i].time - lastHot > 30.0;
+    lastHot = rows[i].time;
+    if (!fresh) continue;
+    printf("  %s hit %.0fC at %.0fs. predicted:", names[m], THERMAL_THROTTLE_TEMP, rows[i].time);
+    for (int k = 0; k < 3; k++) {
+      double before = PREDICT_LEADS[k];
+      size_t j = i;
+      while (j > 0 && rows[i].time - rows[j].time < before) j--;
+      if (rows[i].time - rows[j].time < before) continue;
+      double real = rows[i].time - rows[j].time;
+      printf("  %.0fs before -> %s", before, std::isinf(predicted[j]) ? "never" : (std::to_string(int(predicted[j])) + "s").c_str());
+      stats.count[k]++;
+      stats.error[k] += std::fmin(std::fabs(predicted[j] - real), 1e6);  // "never" counts as way off, not infinitely
+      stats.late[k] = std::fmax(stats.late[k], predicted[j] / real);
+    }
+    printf("\n");
+  }
+}
+
+// Seconds of the derate gate (time to throttle < THERMAL_HORIZON) added up over every motor
+struct gateStats {
+  double lead = 0.0, caught = 0.0;  // seconds in the GATE_LEAD before a throttle, and how many of them the gate was on
+  double on = 0.0, right = 0.0;     // seconds the gate was on, and how many of them a throttle followed within THERMAL_HORIZON
+};
+
+void gateCheck(const std::vector<logRow> &rows, int m, const std::vector<double> &predicted, gateStats &stats) {
+  double nextHit = INFINITY;  // time of the next row reading 55C, walking backwards
+  for (size_t i = rows.size() - 1; i > 0; i--) {
+    if (!rows[i].present[m] || !rows[i - 1].present[m]) continue;
+    if (rows[i].reported[m] >= THERMAL_THROTTLE_TEMP) {
+      nextHit = rows[i].time;
+      continue;  // already throttled, nothing to predict
+    }
+    double dt = rows[i].time - rows[i - 1].time, until = nextHit - rows[i].time;
+    bool gate = predicted[i] < THERMAL_HORIZON;
+    if (until <= GATE_LEAD) {
+      stats.lead += dt;
+      if (gate) stats.caught += dt;
+    }
+    if (gate) {
+      stats.on += dt;
+      if (until <= THERMAL_HORIZON) stats.right += dt;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  double trueHeat[THERMAL_MOTORS] = {0.14, 0.14, 0.15, 0.13, 0.14, 0.16, 0.08, 0.12};
+  double trueCool[THERMAL_MOTORS] = {260, 260, 240, 280, 260, 230, 400, 350};
+  bool fake = argc < 2;
+  std::vector<logRow> rows = fake ? synthetic(trueHeat, trueCool) : load(argv[1]);
+  if (rows.size() < 100) {
+    printf("not enough rows in %s\n", argv[1]);
+    return 1;
+  }
+  printf("%s: %zu rows, %.0f s\n", fake ? "synthetic log" : argv[1], rows.size(), rows.back().time - rows[0].time);
+
+  bool ok = true;
+  double heats[THERMAL_MOTORS], cools[THERMAL_MOTORS];
+  predictStats predictions;
+  for (int m = 0; m < THERMAL_MOTORS; m++) {
+    double before = openLoopError(rows, m, THERMAL_HEAT, THERMAL_COOL);
+    double heat = THERMAL_HEAT, cool = THERMAL_COOL;
+    fit(rows, m, heat, cool);
+    double after = openLoopError(rows, m, heat, cool);
+    printf("%s: defaults rms %.2fC outside the reported step, fit rms %.2fC -> thermal_constants_set(%s, %.3f, %.0f);\n",
+           names[m], std::sqrt(before), std::sqrt(after), enumNames[m], heat, cool);
+    std::vector<double> predicted = predict(rows, m, heat, cool, THERMAL_CURRENT_FILTER_TIME);
+    throttleCheck(rows, m, predicted, predictions);
+    heats[m] = heat;
+    cools[m] = cool;
+    // the fake log has to give its constants back (heat*cool is the steady rise per A^2, that's what matters most)
+    if (fake && std::fabs(heat * cool / (trueHeat[m] * trueCool[m]) - 1.0) > 0.15) {
+      printf("  FAIL: true heat %.3f cool %.0f\n", trueHeat[m], trueCool[m]);
+      ok = false;
+    }
+  }
+
+  // do the predictions close in on the real throttle time
+  if (predictions.count[0] + predictions.count[1] + predictions.count[2] == 0) {
+    printf("time to throttle: nothing throttled in this log, can't be checked\n");
+  } else {
+    printf("time to throttle, mean error / latest:");
+    bool converges = true;
+    double lastError = INFINITY;
+    for (int k = 0; k < 3; k++) {
+      if (predictions.count[k] == 0) continue;
+      double error = predictions.error[k] / predictions.count[k];
+      printf("  %.0fs before %.1fs / %.1fx", PREDICT_LEADS[k], error, predictions.late[k]);
+      converges &= error < lastError && predictions.late[k] <= PREDICT_MAX_LATE;
+      if (PREDICT_LEADS[k] == 10.0) converges &= error <= PREDICT_MAX_ERROR;
+      lastError = error;
+    }
+    printf("  %s\n", converges ? "PASS" : "FAIL");
+    ok &= converges;
+  }
+
+  // the derate gate with the fitted constants, at the robot's current filter time and a few others to compare
+  printf("derate gate (time to throttle < %.0fs), %.0fs before a throttle caught / gate on and right:\n", THERMAL_HORIZON, GATE_LEAD);
+  for (double filter : {THERMAL_CURRENT_FILTER_TIME, 0.5, 2.0, 10.0, 30.0}) {
+    gateStats stats;
+    for (int m = 0; m < THERMAL_MOTORS; m++) gateCheck(rows, m, predict(rows, m, heats[m], cools[m], filter), stats);
+    double caught = stats.lead > 0.0 ? stats.caught / stats.lead : 1.0, right = stats.on > 0.0 ? stats.right / stats.on : 1.0;
+    bool pass = caught >= GATE_MIN_CAUGHT && right >= GATE_MIN_RIGHT;
+    printf("  filter %4.1fs: caught %5.1f%%  right %5.1f%%  %s\n", filter, 100.0 * caught, 100.0 * right,
+           filter == THERMAL_CURRENT_FILTER_TIME ? (pass ? "PASS (THERMAL_CURRENT_FILTER_TIME)" : "FAIL (THERMAL_CURRENT_FILTER_TIME)") : "");
+    if (filter == THERMAL_CURRENT_FILTER_TIME && !pass) ok = false;
+    if (stats.lead == 0.0 && filter == THERMAL_CURRENT_FILTER_TIME) printf("  (nothing throttled in this log, caught can't be checked)\n");
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+// Host check for the tracking wheel calibration math (include/tracker_calibration.hpp)
+// Fakes the push + spin routine on a robot with wrong hand-measured geometry and makes sure the solvers
+// get the real geometry back.
+// Build + run from the repo root:
+//   g++ -std=gnu++20 -O2 -Iinclude tools/sim/tracker_calibration_sim.cpp tools/host/pros_stubs.cpp -o tracker_calibration_sim && ./tracker_calibration_sim
+#include <cstdio>
+#include <random>
+
+#include "tracker_calibration.hpp"
+
+struct simWheel {
+  const char *name;
+  bool vertical;          // rolls forward/back (true) or left/right (false)
+  double trueX, trueY;    // where it really is, inches from the tracking center (x right, y forward)
+  double trueDiameter;    // what the wheel really is
+  double configDistance;  // what we typed into the constructor
+  double configDiameter;
+};
+
+int main() {
+  std::mt19937 rng(1380);
+  std::normal_distribution<double> imuNoise(0.0, 0.3);      // degrees per leg
+  std::normal_distribution<double> travelNoise(0.0, 0.02);  // inches per leg
+
+  // same layout as subsystems.cpp, but the measuring tape was off
+  simWheel wheels[2] = {
+      {"horiz", false, 0.0, -2.85, 2.04, -2.5, 2.0},
+      {"vert", true, 0.35, 0.0, 2.03, 0.0, 2.0},
+  };
+
+  bool ok = true;
+  for (auto &w : wheels) {
+    // push 48" straight: only the vertical wheel rolls. reported = true * assumed / real diameter
+    double diameter = w.configDiameter;
+    if (w.vertical) {
+      double reported = 48.0 * w.configDiameter / w.trueDiameter + travelNoise(rng);
+      diameter = tracker_diameter_solve(w.configDiameter, reported, 48.0);
+    }
+
+    // spin 5 turns each way. the robot also walks a little while it spins, differently each way
+    std::vector<tracker_spin_sample> samples;
+    for (int direction : {1, -1}) {
+      double turned = direction * 5 * 360.0;
+      double rad = turned * M_PI / 180.0;
+      double walk = direction * 0.05;  // how far the spin center drifts, inches
+      // clockwise turn: a vertical wheel rolls -x*theta, a horizontal one rolls y*theta
+      double trueTravel = w.vertical ? -(w.trueX - walk) * rad : (w.trueY - walk) * rad;
+      tracker_spin_sample s;
+      s.imu_degrees = turned + imuNoise(rng);
+      s.travel = trueTravel * diameter / w.trueDiameter + travelNoise(rng);
+      samples.push_back(s);
+    }
+    double offset = tracker_offset_solve(samples);
+    double distance = tracker_distance_signed(offset, false);
+
+    // a horizontal wheel can't get a diameter from a straight push, so its distance soaks up the diameter error.
+    // that's still exactly what odom needs: effective distance = real distance * diameter used / real diameter
+    // signed: a clockwise turn rolls a vertical wheel back by its x and a horizontal one right by its y
+    double trueDistance = w.vertical ? -w.trueX : w.trueY;
+    double wantDistance = trueDistance * diameter / w.trueDiameter;
+    bool good = std::fabs(distance - wantDistance) < 0.05 && (!w.vertical || std::fabs(diameter - w.trueDiameter) < 0.005);
+    printf("%-5s distance %.3f (want %.3f, typed %.3f)  diameter %.4f (real %.4f)  %s\n", w.name, distance, wantDistance, w.configDistance, diameter, w.trueDiameter, good ? "ok" : "WRONG");
+    ok &= good;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+# Fits feedforward constants from the sysid logs on the SD card (see include/sysid.hpp).
+#
+#   python3 tools/sysid/sysid_fit.py /media/sd/sysid_drive_*.csv
+#   python3 tools/sysid/sysid_fit.py --arm-offset 125 /media/sd/sysid_lb_*.csv
+#
+# Model (V in mV, v and a off the logged position, fit the same way WPILib's sysid does it):
+#   drive, intake: V = kS*sgn(v) + kV*v + kA*a
+#   lb:            V = kS*sgn(v) + kV*v + kA*a + kG*cos(angle - arm offset)
+# --arm-offset is the lb rotation sensor reading (degrees) when the arm is sticking straight out flat.
+#
+# Drive units are inches, so the numbers go straight into feedforward_drive_constants_set().
+# Drive launch logs (sysid_drive_launch_fwd.csv) aren't fit, the wheels slip on purpose in them. They get used
+# for traction control instead: the most ground acceleration the robot got (vert_tracker) and the slip ratio it
+# got it at, printed as a traction_launch_set() line.
+# Intake and lb units are motor degrees. Only the standard library is used so it runs anywhere.
+
+import argparse
+import csv
+import math
+import os
+import sys
+
+
+def load(path):
+    rows = []
+    with open(path) as f:
+        for row in csv.DictReader(f):
+            rows.append({k: float(v) for k, v in row.items()})
+    return rows
+
+
+def smooth(values, window):
+    # centered moving average, the motor encoders are pretty chunky at 10 ms
+    half = window // 2
+    out = []
+    for i in range(len(values)):
+        lo, hi = max(0, i - half), min(len(values), i + half + 1)
+        out.append(sum(values[lo:hi]) / (hi - lo))
+    return out
+
+
+def derivative(values, times):
+    out = [0.0] * len(values)
+    for i in range(1, len(values) - 1):
+        dt = times[i + 1] - times[i - 1]
+        out[i] = (values[i + 1] - values[i - 1]) / dt if dt > 0 else 0.0
+    return out
+
+
+def samples(rows, window, min_velocity, arm_offset):
+    # regress the next velocity on this one instead of fitting V against a differentiated acceleration,
+    # a second derivative of encoder ticks is mostly noise and drags kA toward 0
+    #   v[k+1] = alpha*v[k] + beta*V[k] + gamma*sgn(v[k]) (+ delta*cos(angle - offset))
+    t = [r["time_ms"] / 1000.0 for r in rows]
+    pos = smooth([r["position"] for r in rows], window)
+    vel = derivative(pos, t)
+    out = []
+    # skip the ends, the derivatives there are one-sided garbage
+    for i in range(window, len(rows) - window - 1):
+        if abs(vel[i]) < min_velocity:
+            continue  # not moving yet, static friction isn't a kS*sgn(v) thing until it breaks loose
+        x = [vel[i], rows[i]["applied_mv"], math.copysign(1.0, vel[i])]
+        if arm_offset is not None:
+            x.append(math.cos(math.radians(rows[i]["angle_deg"] - arm_offset)))
+        out.append((x, vel[i + 1]))
+    return out
+
+
+def launch(rows, window):
+    # wheel speed off the drive motors vs ground speed off the tracker. Peak ground accel is the most the tiles
+    # give before the wheels break loose, the slip ratio there is where traction peaks
+    if not any(r.get("ground_in", 0.0) for r in rows):
+        return None
+    t = [r["time_ms"] / 1000.0 for r in rows]
+    wheel = derivative(smooth([r["position"] for r in rows], window), t)
+    ground = smooth(derivative(smooth([r["ground_in"] for r in rows], window), t), window)
+    accel = smooth(derivative(ground, t), window)
+    best = None
+    max_slip = 0.0
+    for i in range(window, len(rows) - window - 1):
+        slip = (wheel[i] - ground[i]) / wheel[i] if abs(wheel[i]) > 4.0 else 0.0
+        max_slip = max(max_slip, slip)
+        if best is None or abs(accel[i]) > abs(accel[best[0]]):
+            best = (i, slip)
+    if best is None:
+        return None
+    return abs(accel[best[0]]), best[1], max_slip
+
+
+def sample_period(rows):
+    dts = sorted(b["time_ms"] - a["time_ms"] for a, b in zip(rows, rows[1:]))
+    return dts[len(dts) // 2] / 1000.0
+
+
+def solve(A, b):
+    # gaussian elimination with partial pivoting, A is tiny (3x3 or 4x4)
+    n = len(A)
+    M = [A[i][:] + [b[i]] for i in range(n)]
+    for c in range(n):
+        p = max(range(c, n), key=lambda r: abs(M[r][c]))
+        if abs(M[p][c]) < 1e-12:
+            raise ValueError("not enough excitation to fit term %d, run both quasistatic and dynamic tests" % c)
+        M[c], M[p] = M[p], M[c]
+        for r in range(c + 1, n):
+            f = M[r][c] / M[c][c]
+            for k in range(c, n + 1):
+                M[r][k] -= f * M[c][k]
+    x = [0.0] * n
+    for r in range(n - 1, -1, -1):
+        x[r] = (M[r][n] - sum(M[r][k] * x[k] for k in range(r + 1, n))) / M[r][r]
+    return x
+
+
+def fit(data):
+    # ordinary least squares through the normal equations, r^2/rmse are for whatever y is
+    n = len(data[0][0])
+    A = [[0.0] * n for _ in range(n)]
+    b = [0.0] * n
+    for x, y in data:
+        for i in range(n):
+            b[i] += x[i] * y
+            for j in range(n):
+                A[i][j] += x[i] * x[j]
+    k = solve(A, b)
+    mean = sum(y for _, y in data) / len(data)
+    ss_res = sum((y - sum(ki * xi for ki, xi in zip(k, x))) ** 2 for x, y in data)
+    ss_tot = sum((y - mean) ** 2 for _, y in data)
+    r2 = 1.0 - ss_res / ss_tot if ss_tot > 0 else 0.0
+    rmse = math.sqrt(ss_res / len(data))
+    return k, r2, rmse
+
+
+def main():
+    parser = argparse.ArgumentParser(description="fit kS/kV/kA (and kG) from sysid logs")
+    parser.add_argument("logs", nargs="+", help="sysid_<mechanism>_<test>_<dir>.csv files, all from one mechanism")
+    parser.add_argument("--arm-offset", type=float, default=None,
+                        help="lb sensor degrees where the arm is horizontal, turns on the kG term")
+    parser.add_argument("--window", type=int, default=5, help="smoothing window in samples")
+    parser.add_argument("--min-velocity", type=float, default=None,
+                        help="ignore samples slower than this (default: 1 in/s drive, 30 deg/s otherwise)")
+    args = parser.parse_args()
+
+    mechanisms = {os.path.basename(p).split("_")[1] for p in args.logs}
+    if len(mechanisms) != 1:
+        sys.exit("logs are from more than one mechanism: %s" % ", ".join(sorted(mechanisms)))
+    mechanism = mechanisms.pop()
+    if mechanism == "lb" and args.arm_offset is None:
+        print("note: no --arm-offset, fitting lb without gravity (kG)")
+    min_velocity = args.min_velocity
+    if min_velocity is None:
+        min_velocity = 1.0 if mechanism == "drive" else 30.0
+
+    data = []
+    dt = None
+    launches = []
+    for path in args.logs:
+        rows = load(path)
+        if os.path.basename(path).split("_")[2] == "launch":
+            result = launch(rows, args.window)
+            if result is None:
+                print("note: %s has no tracker data, skipping it" % path)
+            else:
+                launches.append(result)
+            continue
+        dt = dt or sample_period(rows)
+        data += samples(rows, args.window, min_velocity, args.arm_offset)
+
+    if launches:
+        accel = min(a for a, _, _ in launches)
+        slip = min(s for _, s, _ in launches)
+        print("launch: peak ground accel %.1f in/s^2 at slip ratio %.2f (max slip %.2f)" % (accel, slip, max(m for _, _, m in launches)))
+        if max(m for _, _, m in launches) < 0.05:
+            print("note: the wheels never really slipped, so that's the motors' limit and traction is higher than this")
+        # a little under the peak so a worn tile/dusty wheel still hooks up
+        print("traction_launch_set(%.0f, %.2f);" % (0.9 * accel, min(max(slip, 0.05), 0.5)))
+        if not data:
+            return
+
+    if len(data) < 20:
+        sys.exit("only %d usable samples, did the mechanism actually move?" % len(data))
+
+    (alpha, beta, gamma, *rest), r2, rmse = fit(data)
+    if not (0.0 < alpha < 1.0) or beta <= 0.0:
+        sys.exit("fit doesn't look like a motor (alpha %.4f beta %.6f), check the logs" % (alpha, beta))
+    # back to the continuous model, the discrete one is the exact solution of it over one sample
+    kV = (1.0 - alpha) / beta
+    kA = -kV * dt / math.log(alpha)
+    k = [-gamma / beta, kV, kA] + [-d / beta for d in rest]
+    units = "in" if mechanism == "drive" else "deg"
+    print("%s: %d samples, r^2 %.4f, velocity rmse %.2f %s/s" % (mechanism, len(data), r2, rmse, units))
+    print("  kS = %.1f mV" % k[0])
+    print("  kV = %.3f mV per %s/s" % (k[1], units))
+    print("  kA = %.4f mV per %s/s^2" % (k[2], units))
+    if len(k) > 3:
+        print("  kG = %.1f mV" % k[3])
+    if mechanism == "drive":
+        print("feedforward_drive_constants_set(%.0f, %.2f, %.2f, kP, kD, max_velocity, max_accel);" % (k[0], k[1], k[2]))
+        print("feedforward_characterized_set(ez::DRIVE, true);")
+    if r2 < 0.9:
+        print("warning: r^2 is low, check for wheel slip / the arm hitting something / a dead motor")
+
+
+if __name__ == "__main__":
+    main()
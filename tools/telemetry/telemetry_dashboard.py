@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+# Live plots of the robot's telemetry stream (see include/telemetry.hpp).
+#
+#   python3 tools/telemetry/telemetry_dashboard.py /dev/ttyACM1            # the brain's USB port (Windows: COM5)
+#   python3 tools/telemetry/telemetry_dashboard.py tools/telemetry/telemetry.pty   # telemetry_robot, no brain
+#   python3 tools/telemetry/telemetry_dashboard.py /dev/ttyACM1 --check 5  # no plots, 5 s of frame stats
+#   python3 tools/telemetry/telemetry_dashboard.py /dev/ttyACM1 --save run.csv
+#
+# Turn the stream on with B + Y on the controller first. The brain shows up as two ports, the user port is the
+# second one on Linux (ttyACM1) and the higher COM number on Windows.
+# Plots need matplotlib, --check only uses the standard library (plus pyserial on Windows).
+# --save writes every decoded frame as one csv row: time ms, channel, then its fields in order.
+
+import argparse
+import collections
+import os
+import struct
+import sys
+import time
+
+HEADER = struct.Struct("<BBI")  # channel, sequence, time ms. Same as telemetry_frame_encode
+FRAME_MAX = 42                  # TELEMETRY_FRAME_MAX, anything longer between two 0s isn't a frame
+WINDOW = 10.0                   # seconds shown
+
+# channel id -> name, payload layout, field names. Same as the telemetry_* structs
+CHANNELS = {
+    0: ("pose", struct.Struct("<fff"), ["x", "y", "theta"]),
+    1: ("pid", struct.Struct("<ffff"), ["drive", "turn", "swing", "lb"]),
+    2: ("current", struct.Struct("<8h"), ["L1", "L2", "L3", "R1", "R2", "R3", "intake", "lb"]),
+    3: ("arm", struct.Struct("<ii"), ["position", "target"]),
+    4: ("color", struct.Struct("<BBHH"), ["kind", "spare", "hue", "ejected"]),
+}
+COLOR_KINDS = ["detect", "eject"]
+
+
+def crc16(data, crc=0xFFFF):
+    # CRC-16/CCITT-FALSE, same as telemetry_crc
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+        crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        length = data[i]
+        i += 1
+        if length == 0 or i + length - 1 > len(data):
+            return None
+        block = data[i:i + length - 1]
+        if 0 in block:
+            return None
+        out += block
+        i += length - 1
+        if length != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    # Bytes in, frames out. Anything that isn't a good frame gets counted and skipped
+    def __init__(self):
+        self.pending = bytearray()
+        self.frames = collections.Counter()
+        self.bad = 0      # failed COBS or CRC, or not a channel we know
+        self.lost = 0     # sequence gaps, frames the robot sent that never showed up
+        self.last_sequence = {}
+
+    def feed(self, data):
+        self.pending += data
+        out = []
+        while True:
+            end = self.pending.find(0)
+            if end < 0:
+                if len(self.pending) > 4 * FRAME_MAX:  # no 0 in ages, the start of this is junk
+                    self.bad += 1
+                    del self.pending[:-FRAME_MAX]
+                return out
+            chunk = bytes(self.pending[:end])
+            del self.pending[:end + 1]
+            if chunk:
+                frame = self.parse(chunk)
+                if frame is not None:
+                    out.append(frame)
+
+    def parse(self, chunk):
+        raw = cobs_decode(chunk) if len(chunk) <= FRAME_MAX else None
+        if raw is None or len(raw) < HEADER.size + 2 or crc16(raw[:-2]) != struct.unpack_from("<H", raw, len(raw) - 2)[0]:
+            self.bad += 1
+            return None
+        channel, sequence, ms = HEADER.unpack_from(raw)
+        payload = raw[HEADER.size:-2]
+        if channel not in CHANNELS or len(payload) != CHANNELS[channel][1].size:
+            self.bad += 1
+            return None
+        if channel in self.last_sequence:
+            self.lost += (sequence - self.last_sequence[channel] - 1) & 0xFF
+        self.last_sequence[channel] = sequence
+        self.frames[channel] += 1
+        return channel, ms, CHANNELS[channel][1].unpack(payload)
+
+
+def open_port(path):
+    # Raw, non-blocking reads. USB serial on the brain ignores the baud rate
+    if os.name == "nt":
+        import serial  # pyserial
+        port = serial.Serial(path, 115200, timeout=0)
+        return lambda: port.read(4096)
+    import termios
+    import tty
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY | os.O_NONBLOCK)
+    if os.isatty(fd):
+        tty.setraw(fd, termios.TCSANOW)
+
+    def read():
+        try:
+            return os.read(fd, 4096)
+        except BlockingIOError:
+            return b""
+        except OSError:  # the robot (or the stand-in) went away
+            raise EOFError
+    return read
+
+
+def check(read, seconds):
+    decoder = Decoder()
+    start = time.monotonic()
+    first, last = {}, {}
+    try:
+        while time.monotonic() - start < seconds:
+            for channel, ms, _ in decoder.feed(read()):
+                first.setdefault(channel, ms)
+                last[channel] = ms
+            time.sleep(0.005)
+    except EOFError:
+        pass
+    print(f"{'channel':<10}{'frames':>8}{'Hz':>8}")
+    for channel, (name, _, _) in CHANNELS.items():
+        count = decoder.frames[channel]
+        span = (last.get(channel, 0) - first.get(channel, 0)) / 1000
+        hz = (count - 1) / span if count > 1 and span > 0 else 0
+        print(f"{name:<10}{count:>8}{hz:>8.1f}")
+    print(f"{decoder.bad} bad frames skipped, {decoder.lost} lost (sequence gaps)")
+    return 0 if sum(decoder.frames.values()) > 0 else 1
+
+
+def plot(read, save):
+    try:
+        import matplotlib.pyplot as plt
+        from matplotlib.animation import FuncAnimation
+    except ImportError:
+        sys.exit("plots need matplotlib (pip install matplotlib), or use --check")
+
+    decoder = Decoder()
+    series = {}  # (channel, field) -> (times, values)
+    events = collections.deque(maxlen=40)  # (time s, text)
+    latest = [0.0]
+
+    def add(key, t, value):
+        times, values = series.setdefault(key, (collections.deque(), collections.deque()))
+        times.append(t)
+        values.append(value)
+        while times and times[0] < t - WINDOW:
+            times.popleft()
+            values.popleft()
+
+    fig, axes = plt.subplots(2, 2, figsize=(12, 8))
+    (ax_pose, ax_pid), (ax_current, ax_arm) = axes
+    fig.canvas.manager.set_window_title("robot telemetry")
+    path_line, = ax_pose.plot([], [], lw=1)
+    robot_dot, = ax_pose.plot([], [], "o")
+    ax_pose.set_title("pose (in)")
+    ax_pose.set_xlim(-72, 72)
+    ax_pose.set_ylim(-72, 72)
+    ax_pose.set_aspect("equal")
+    lines = {}
+    for ax, channel, fields, title in [(ax_pid, 1, ["drive", "turn", "swing"], "PID error (in, deg)"),
+                                       (ax_current, 2, CHANNELS[2][2], "motor current (mA)"),
+                                       (ax_arm, 3, ["position", "target"], "lady brown (centideg)")]:
+        for field in fields:
+            lines[(channel, CHANNELS[channel][2].index(field))], = ax.plot([], [], lw=1, label=field)
+        ax.set_title(title)
+        ax.legend(loc="upper left", fontsize="small", ncol=4)
+    status = fig.text(0.01, 0.01, "", family="monospace")
+
+    def update(_):
+        try:
+            data = read()
+        except EOFError:
+            data = b""
+            status.set_text("port closed")
+        for channel, ms, values in decoder.feed(data):
+            t = ms / 1000
+            latest[0] = max(latest[0], t)
+            if save is not None:
+                save.write(f"{ms},{CHANNELS[channel][0]}," + ",".join(str(v) for v in values) + "\n")
+            if channel == 4:
+                events.append((t, f"{COLOR_KINDS[values[0]] if values[0] < 2 else values[0]} hue {values[2]} #{values[3]}"))
+                ax_current.axvline(t, color="gray", lw=0.5)  # color sort events as lines on the current plot
+                continue
+            for i, value in enumerate(values):
+                add((channel, i), t, value)
+        if (0, 0) in series:
+            xs, ys = series[(0, 0)][1], series[(0, 1)][1]
+            path_line.set_data(xs, ys)
+            robot_dot.set_data([xs[-1]], [ys[-1]])
+        for key, line in lines.items():
+            if key in series:
+                line.set_data(*series[key])
+        for ax in (ax_pid, ax_current, ax_arm):
+            ax.set_xlim(latest[0] - WINDOW, latest[0] + 0.1)
+            ax.relim()
+            ax.autoscale_view(scalex=False)
+        shown = "  ".join(text for _, text in list(events)[-3:])
+        status.set_text(f"{sum(decoder.frames.values())} frames, {decoder.bad} bad, {decoder.lost} lost   {shown}")
+        return []
+
+    _animation = FuncAnimation(fig, update, interval=50, cache_frame_data=False)
+    plt.tight_layout(rect=(0, 0.03, 1, 1))
+    plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Live plots of the robot's binary telemetry stream")
+    parser.add_argument("port", help="serial port, or the pty telemetry_robot made")
+    parser.add_argument("--check", type=float, metavar="SECONDS", help="no plots, print frame stats after this long")
+    parser.add_argument("--save", metavar="CSV", help="also write every frame to a csv")
+    args = parser.parse_args()
+
+    read = open_port(args.port)
+    if args.check is not None:
+        sys.exit(check(read, args.check))
+    save = open(args.save, "w") if args.save else None
+    try:
+        plot(read, save)
+    finally:
+        if save is not None:
+            save.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,160 @@
+// A stand-in for the robot's telemetry stream (include/telemetry.hpp), so the dashboard can be worked on without
+// a brain. It opens a pseudo-terminal, which looks like the robot's USB serial port to anything that opens it,
+// and streams made up data through the same telemetry_frame_encode() the robot uses, at the same rates.
+// Build + run from the repo root:
+//   make -C tools/telemetry                 # streams until Ctrl+C, prints the port to point the dashboard at
+//   make -C tools/telemetry check           # 4 s into the dashboard's --check, fails if nothing decodes
+// Or by hand:
+//   g++ -std=gnu++20 -O2 -Iinclude -U_GNU_SOURCE -D_GNU_SOURCE= tools/telemetry/telemetry_robot.cpp tools/host/pros_stubs.cpp -o telemetry_robot
+//   ./telemetry_robot [--seconds 10] [--rate pose=100] [--noise] [--link telemetry.pty]
+//   python3 tools/telemetry/telemetry_dashboard.py telemetry.pty
+// --noise mixes printf text and flipped bits into the stream like a real cable sometimes does, the dashboard
+// should skip those frames and pick back up on the next one.
+// When it stops it prints what encoding cost per 10 ms tick, the robot's share of that is the 2% budget.
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "telemetry.hpp"
+
+const char *CHANNEL_NAMES[TELEMETRY_CHANNELS] = {"pose", "pid", "current", "arm", "color"};
+
+volatile std::sig_atomic_t stopping = 0;
+
+int main(int argc, char **argv) {
+  double seconds = 0;  // 0 = until Ctrl+C
+  bool noise = false;
+  const char *link = nullptr;
+  int rate[TELEMETRY_CHANNELS];
+  for (int i = 0; i < TELEMETRY_CHANNELS; i++) rate[i] = TELEMETRY_RATE_DEFAULT[i];
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--seconds" && i + 1 < argc) {
+      seconds = std::atof(argv[++i]);
+    } else if (arg == "--noise") {
+      noise = true;
+    } else if (arg == "--link" && i + 1 < argc) {
+      link = argv[++i];
+    } else if (arg == "--rate" && i + 1 < argc) {
+      std::string value = argv[++i];
+      size_t eq = value.find('=');
+      int channel = -1;
+      for (int c = 0; c < TELEMETRY_CHANNELS && eq != std::string::npos; c++)
+        if (value.substr(0, eq) == CHANNEL_NAMES[c]) channel = c;
+      if (channel < 0) {
+        printf("--rate wants <channel>=<Hz>, channels are pose, pid, current, arm\n");
+        return 2;
+      }
+      rate[channel] = std::atoi(value.c_str() + eq + 1);
+    } else {
+      printf("usage: %s [--seconds N] [--rate channel=Hz]... [--noise] [--link path]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // The pty. Raw so the line discipline doesn't turn 0x0A into 0x0D 0x0A like it would for a terminal
+  int port = posix_openpt(O_RDWR | O_NOCTTY);
+  if (port < 0 || grantpt(port) != 0 || unlockpt(port) != 0) {
+    perror("posix_openpt");
+    return 1;
+  }
+  const char *path = ptsname(port);
+  int held = open(path, O_RDWR | O_NOCTTY);  // kept open so the settings stick and writes work before anyone connects
+  termios raw;
+  tcgetattr(held, &raw);
+  cfmakeraw(&raw);
+  tcsetattr(held, TCSANOW, &raw);
+  fcntl(port, F_SETFL, fcntl(port, F_GETFL) | O_NONBLOCK);  // a full buffer drops frames like the robot does
+  if (link != nullptr) {
+    unlink(link);
+    if (symlink(path, link) != 0) perror("symlink");
+  }
+  printf("robot on %s%s%s\n", path, link != nullptr ? " -> " : "", link != nullptr ? link : "");
+  fflush(stdout);
+  std::signal(SIGINT, [](int) { stopping = 1; });
+  std::signal(SIGTERM, [](int) { stopping = 1; });
+
+  std::uint8_t out[TELEMETRY_FRAME_MAX * TELEMETRY_CHANNELS];
+  std::uint8_t sequence[TELEMETRY_CHANNELS] = {};
+  int countdown[TELEMETRY_CHANNELS] = {};
+  long ticks = 0, frames = 0, dropped = 0, bytes = 0;
+  std::uint16_t ejected = 0;
+  double encodeNs = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto next = start;
+  auto add = [&](int &size, telemetry_channel channel, std::uint32_t now, const void *payload, int length) {
+    size += telemetry_frame_encode(channel, sequence[channel]++, now, payload, length, &out[size]);
+    frames++;
+  };
+
+  while (!stopping && (seconds <= 0 || ticks * TELEMETRY_TICK < seconds * 1000)) {
+    std::uint32_t now = ticks * TELEMETRY_TICK;
+    double t = now / 1000.0;
+
+    // Same scheduling as telemetry_task
+    auto encodeStart = std::chrono::steady_clock::now();
+    int size = 0;
+    for (int i = 0; i < TELEMETRY_CHANNELS; i++) {
+      if (rate[i] <= 0 || --countdown[i] > 0) continue;
+      countdown[i] = 1000 / TELEMETRY_TICK / rate[i];
+      telemetry_channel channel = (telemetry_channel)i;
+      if (channel == TELEMETRY_POSE) {
+        telemetry_pose pose = {(float)(36 * std::sin(t / 2)), (float)(24 * std::sin(t)), (float)std::fmod(t * 30, 360)};
+        add(size, channel, now, &pose, sizeof(pose));
+      } else if (channel == TELEMETRY_PID) {
+        double settle = std::exp(-std::fmod(t, 2.0) * 3);  // a new motion every 2 s
+        telemetry_pid pid = {(float)(24 * settle), (float)(90 * settle * std::cos(t * 9)), 0.0f, (float)(3000 * settle)};
+        add(size, channel, now, &pid, sizeof(pid));
+      } else if (channel == TELEMETRY_CURRENT) {
+        telemetry_current current;
+        for (int m = 0; m < 8; m++) current.mA[m] = (std::int16_t)(1200 + 900 * std::sin(t * 2 + m));
+        add(size, channel, now, &current, sizeof(current));
+      } else if (channel == TELEMETRY_ARM) {
+        std::int32_t target = (int)t % 4 < 2 ? 12500 : 3000;
+        telemetry_arm arm = {(std::int32_t)(target + 4000 * std::exp(-std::fmod(t, 2.0) * 4)), target};
+        add(size, channel, now, &arm, sizeof(arm));
+      }
+    }
+    if (ticks % 150 == 75) {  // a wrong ring every 1.5 s, thrown 200 ms later
+      telemetry_color color = {TELEMETRY_COLOR_DETECT, 0, 215, ejected};
+      add(size, TELEMETRY_COLOR, now, &color, sizeof(color));
+    } else if (ticks % 150 == 95) {
+      telemetry_color color = {TELEMETRY_COLOR_EJECT, 0, 215, ++ejected};
+      add(size, TELEMETRY_COLOR, now, &color, sizeof(color));
+    }
+    encodeNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - encodeStart).count();
+
+    if (noise && ticks % 100 == 50 && size > 4) out[size / 2] ^= 0x10;  // one bit flipped, that frame's gone
+    if (size > 0) {
+      ssize_t written = write(port, out, size);
+      if (written < size) dropped++;
+      if (written > 0) bytes += written;
+    }
+    if (noise && ticks % 100 == 0) {
+      const char *text = "Rings Sorted 3\n";  // somebody's printf
+      if (write(port, text, std::strlen(text)) > 0) bytes += std::strlen(text);
+    }
+
+    ticks++;
+    next += std::chrono::milliseconds(TELEMETRY_TICK);
+    std::this_thread::sleep_until(next);
+  }
+
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("%ld ticks, %ld frames, %.1f kB/s, %ld writes didn't fit\n", ticks, frames, bytes / elapsed / 1000, dropped);
+  printf("encoding: %.2f us per tick here = %.4f%% of a %d ms tick\n", encodeNs / ticks / 1000, encodeNs / ticks / (TELEMETRY_TICK * 1e4),
+         TELEMETRY_TICK);
+  close(held);
+  close(port);
+  if (link != nullptr) unlink(link);
+  return 0;
+}
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+# Turns the execution trace off the SD card (/usd/trace.bin, see include/trace_log.hpp) into Chrome trace JSON.
+#
+#   python3 tools/trace/trace_convert.py /media/sd/trace.bin              # writes trace.json next to it
+#   python3 tools/trace/trace_convert.py /media/sd/trace.bin -o auton.json --summary
+#
+# Open the JSON in ui.perfetto.dev (or chrome://tracing). One row per task, plus a "drive" row with the motions.
+# --summary prints where the auton's time went: waiting on motions (until EZ-Template's exit conditions are
+# met), each kind of motion, and the rest (pros::delay and everything else the auton task did between waits).
+# Only the standard library is used so it runs anywhere.
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+MAGIC = b"EZTRACE1"
+RECORD = struct.Struct("<IiBBBB")  # time, arg, event, phase, task, spare. Same as trace_record
+NAME_LENGTH = 16
+
+# ez::e_mode, the arg on motion events
+MODES = ["disable", "swing", "turn", "turn_to_point", "drive", "point_to_point", "pure_pursuit"]
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:len(MAGIC)] != MAGIC:
+        sys.exit(f"{path}: not a trace file")
+    events, tasks, records = {}, {}, []
+    pos, last, wraps = len(MAGIC), None, 0
+    while pos + RECORD.size <= len(data):
+        time, arg, event, phase, task, _ = RECORD.unpack_from(data, pos)
+        pos += RECORD.size
+        phase = chr(phase)
+        if phase in "NM":
+            name = data[pos:pos + NAME_LENGTH].split(b"\0")[0].decode(errors="replace")
+            pos += NAME_LENGTH
+            (tasks if phase == "N" else events)[event] = name
+            continue
+        # micros() wraps every 71 minutes
+        if last is not None and time < last and last - time > 1 << 31:
+            wraps += 1
+        last = time
+        records.append((time + (wraps << 32), arg, event, phase, task))
+    return events, tasks, records
+
+
+def label(events, event, arg):
+    name = events.get(event, f"event {event}")
+    if name == "motion":
+        return MODES[arg] if 0 <= arg < len(MODES) else f"motion {arg}"
+    if name == "pid_wait":
+        return f"pid_wait #{arg}"
+    return name
+
+
+def convert(events, tasks, records):
+    out = [{"ph": "M", "name": "process_name", "pid": 0, "args": {"name": "robot"}}]
+    for task, name in sorted(tasks.items()):
+        out.append({"ph": "M", "name": "thread_name", "pid": 0, "tid": task, "args": {"name": name or f"task {task}"}})
+        out.append({"ph": "M", "name": "thread_sort_index", "pid": 0, "tid": task, "args": {"sort_index": task}})
+    if not records:
+        return out
+    start = records[0][0]
+    open_slices = {}
+    for time, arg, event, phase, task in records:
+        e = {"ph": phase, "name": label(events, event, arg), "pid": 0, "tid": task, "ts": time - start, "args": {"arg": arg}}
+        if phase == "i":
+            e["s"] = "t"
+        elif phase == "B":
+            open_slices.setdefault(task, []).append(e)
+        elif phase == "E":
+            if not open_slices.get(task):
+                continue  # the begin happened before the trace started
+            e["name"] = open_slices[task].pop()["name"]
+        out.append(e)
+    # close whatever was still going when the trace stopped
+    end = records[-1][0] - start
+    for task, stack in open_slices.items():
+        for b in reversed(stack):
+            out.append({"ph": "E", "name": b["name"], "pid": 0, "tid": task, "ts": end})
+    return out
+
+
+def summary(events, tasks, records):
+    # slices as (task, name, start, end), matched up per task
+    slices, stacks = [], {}
+    for time, arg, event, phase, task in records:
+        if phase == "B":
+            stacks.setdefault(task, []).append((label(events, event, arg), time))
+        elif phase == "E" and stacks.get(task):
+            name, begin = stacks[task].pop()
+            slices.append((task, name, begin, time))
+    end = records[-1][0] if records else 0
+    for task, stack in stacks.items():
+        for name, begin in stack:
+            slices.append((task, name, begin, end))
+
+    autons = [s for s in slices if s[1] == "auton"]
+    if not autons:
+        print("no auton in this trace")
+        return
+    _, _, begin, finish = autons[0]
+    total = finish - begin
+    # the waits are on the drive row with the motions, clipped to the auton like them
+    waits = [(min(e, finish) - max(b, begin), n) for t, n, b, e in slices
+             if tasks.get(t) == "drive" and n.startswith("pid_wait") and b < finish and e > begin]
+    waited = sum(d for d, n in waits)
+    print(f"auton {total / 1e6:.3f} s")
+    print(f"  waiting on motions  {waited / 1e6:7.3f} s  {100 * waited / total:5.1f}%")
+    print(f"  everything else     {(total - waited) / 1e6:7.3f} s  {100 * (total - waited) / total:5.1f}%  (pros::delay + code)")
+    motions = {}
+    for t, n, b, e in slices:
+        if tasks.get(t) == "drive" and not n.startswith("pid_wait") and b < finish and e > begin:
+            motions[n] = motions.get(n, 0) + min(e, finish) - max(b, begin)
+    for name, time in sorted(motions.items(), key=lambda m: -m[1]):
+        print(f"  {name:<19} {time / 1e6:7.3f} s  {100 * time / total:5.1f}%")
+    longest = sorted(waits)[::-1][:5]
+    if longest:
+        print("  longest waits: " + ", ".join(f"{n[9:]} {d / 1e3:.0f} ms" for d, n in longest))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="convert /usd/trace.bin to Chrome trace JSON")
+    parser.add_argument("trace")
+    parser.add_argument("-o", "--output", help="default: trace.json next to the input")
+    parser.add_argument("--summary", action="store_true", help="print where the auton's time went")
+    args = parser.parse_args()
+
+    events, tasks, records = load(args.trace)
+    output = args.output or os.path.join(os.path.dirname(args.trace), "trace.json")
+    with open(output, "w") as f:
+        json.dump({"traceEvents": convert(events, tasks, records), "displayTimeUnit": "ms"}, f)
+    print(f"{len(records)} events from {len(tasks)} tasks -> {output}")
+    if args.summary:
+        summary(events, tasks, records)
+
+
+if __name__ == "__main__":
+    main()